@@ -22,6 +22,7 @@
 #define BLUR_SIGMA_SMALL    1.0f
 #define BLUR_SIGMA_LARGE    10.0f
 #define BLUR_SIGMA_HUGE     80.0f
+#define BLUR_SIGMA_GIANT    300.0f
 
 
 // When 'cropped' is set we apply a cropRect to the blurImageFilter. The crop rect is an inset of
@@ -135,6 +136,8 @@ DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, tr
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, false, false, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, true, false, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_GIANT, BLUR_SIGMA_GIANT, true, false, false);)
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_GIANT, BLUR_SIGMA_GIANT, false, false, false);)
 
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, 0, false, true, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_SMALL, 0, false, true, false);)
@@ -148,6 +151,8 @@ DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, tr
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, false, true, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, true, true, false);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, true, false);)
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_GIANT, BLUR_SIGMA_GIANT, true, true, false);)
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_GIANT, BLUR_SIGMA_GIANT, false, true, false);)
 
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, 0, false, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_SMALL, 0, false, true, true);)
@@ -161,3 +166,5 @@ DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, tr
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, false, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, true, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, true, true);)
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_GIANT, BLUR_SIGMA_GIANT, true, true, true);)
+DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_GIANT, BLUR_SIGMA_GIANT, false, true, true);)
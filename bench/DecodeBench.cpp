@@ -78,6 +78,33 @@ private:
     using INHERITED = DecodeBench;
 };
 
+// Same as SkottieDecodeBench, from the binary JSON form of the animation.
+class SkottieBinaryDecodeBench final : public DecodeBench {
+public:
+    SkottieBinaryDecodeBench(const char* name, const char* source)
+        : INHERITED(name, source)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        fData = skottie::Animation::Builder::EncodeBinaryJSON(
+                reinterpret_cast<const char*>(fData->data()), fData->size());
+        SkASSERT(fData);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            const auto anim = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .makeFromBinaryJSON(reinterpret_cast<const char*>(fData->data()),
+                                    fData->size());
+        }
+    }
+
+private:
+    using INHERITED = DecodeBench;
+};
+
 class SkottiePictureDecodeBench final : public DecodeBench {
 public:
     SkottiePictureDecodeBench(const char* name, const char* source)
@@ -108,6 +135,12 @@ DEF_BENCH(return new SkottieDecodeBench("skottie_medium", //  10947
                                         "skottie/skottie-sphere-effect.json"));
 DEF_BENCH(return new SkottieDecodeBench("skottie_small",  //   1112
                                         "skottie/skottie_sample_multiframe.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottie_binary_large",
+                                              "skottie/skottie-text-scale-to-fit-minmax.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottie_binary_medium",
+                                              "skottie/skottie-sphere-effect.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottie_binary_small",
+                                              "skottie/skottie_sample_multiframe.json"));
 // Created from PhoneHub assets SVG source, with https://lottiefiles.com/svg-to-lottie
 DEF_BENCH(return new SkottieDecodeBench("skottie_phonehub_connecting.json",    // 216x216
                                         "skottie/skottie-phonehub-connecting.json"));
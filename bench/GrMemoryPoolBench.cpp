@@ -8,6 +8,7 @@
 #include "bench/Benchmark.h"
 #include "src/base/SkRandom.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
+#include "src/gpu/ganesh/GrSizeClassAllocator.h"
 
 #include <type_traits>
 
@@ -217,3 +218,83 @@ DEF_BENCH( return new GrMemoryPoolBench("random_aligned_ref",    run_random<Alig
 DEF_BENCH( return new GrMemoryPoolBench("random_unaligned_lg",   run_random<Unaligned>,  kLargePool); )
 DEF_BENCH( return new GrMemoryPoolBench("random_unaligned_sm",   run_random<Unaligned>,  kSmallPool); )
 DEF_BENCH( return new GrMemoryPoolBench("random_unaligned_ref",  run_random<Unaligned>,  0); )
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Simulates steady-state op recording: every "frame" allocates a batch of objects with a mix of
+// op-like sizes, then releases them all when the frame is flushed. A GrMemoryPool is created per
+// frame (as an OpsTask would have), while GrSizeClassAllocator recycles memory across frames.
+class GrOpAllocationFrameBench : public Benchmark {
+public:
+    enum class Allocator { kHeap, kMemoryPool, kSizeClass };
+
+    GrOpAllocationFrameBench(const char* name, Allocator allocator) : fAllocator(allocator) {
+        fName.printf("grmemorypool_frame_%s", name);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom r;
+        static constexpr size_t kSizes[] = {48, 96, 136, 208, 264, 400};
+        for (size_t& size : fSizes) {
+            size = kSizes[r.nextULessThan(std::size(kSizes))];
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            std::unique_ptr<GrMemoryPool> pool;
+            if (fAllocator == Allocator::kMemoryPool) {
+                pool = GrMemoryPool::Make(16384, 16384);
+            }
+            for (int j = 0; j < kObjectsPerFrame; ++j) {
+                fObjs[j] = this->allocate(pool.get(), fSizes[j]);
+            }
+            for (int j = 0; j < kObjectsPerFrame; ++j) {
+                this->release(pool.get(), fObjs[j]);
+            }
+        }
+    }
+
+private:
+    static constexpr int kObjectsPerFrame = 512;
+
+    void* allocate(GrMemoryPool* pool, size_t size) const {
+        switch (fAllocator) {
+            case Allocator::kHeap:       return ::operator new(size);
+            case Allocator::kMemoryPool: return pool->allocate(size);
+            case Allocator::kSizeClass:  return GrSizeClassAllocator::Allocate(size);
+        }
+        SkUNREACHABLE;
+    }
+
+    void release(GrMemoryPool* pool, void* p) const {
+        switch (fAllocator) {
+            case Allocator::kHeap:       ::operator delete(p);              break;
+            case Allocator::kMemoryPool: pool->release(p);                  break;
+            case Allocator::kSizeClass:  GrSizeClassAllocator::Release(p);  break;
+        }
+    }
+
+    SkString  fName;
+    Allocator fAllocator;
+    size_t    fSizes[kObjectsPerFrame];
+    void*     fObjs[kObjectsPerFrame];
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new GrOpAllocationFrameBench("heap",
+                                               GrOpAllocationFrameBench::Allocator::kHeap); )
+DEF_BENCH( return new GrOpAllocationFrameBench("pool",
+                                               GrOpAllocationFrameBench::Allocator::kMemoryPool); )
+DEF_BENCH( return new GrOpAllocationFrameBench("sizeclass",
+                                               GrOpAllocationFrameBench::Allocator::kSizeClass); )
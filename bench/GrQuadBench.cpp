@@ -10,6 +10,13 @@
 #include "src/gpu/ganesh/geometry/GrQuad.h"
 #include "src/gpu/ganesh/geometry/GrQuadUtils.h"
 
+#if defined(SK_GANESH)
+#include "include/core/SkMatrix.h"
+#include "src/gpu/ganesh/ops/QuadPerEdgeAA.h"
+
+#include <memory>
+#endif
+
 class GrQuadBoundsBench : public Benchmark {
 public:
     GrQuadBoundsBench(bool perspective)
@@ -72,3 +79,74 @@ protected:
 
 DEF_BENCH( return new GrQuadBoundsBench(/* persp */ false); )
 DEF_BENCH( return new GrQuadBoundsBench(/* persp */ true); )
+
+#if defined(SK_GANESH)
+
+// Measures CPU vertex generation for anti-aliased, textured quads without going through an op.
+// Axis-aligned quads are tessellated in SIMD batches while rotated (rectilinear) quads use the
+// general per-quad TessellationHelper, so comparing the two shows the effect of batching.
+class GrQuadTessellateBench : public Benchmark {
+public:
+    GrQuadTessellateBench(bool rotated) : fRotated(rotated) {
+        fName.printf("grquad_tessellate_aa_%s", rotated ? "rectilinear" : "axisaligned");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    inline static constexpr int kQuadCount = 1000;
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        using namespace skgpu::ganesh::QuadPerEdgeAA;
+
+        SkRandom r;
+        SkMatrix viewMatrix = fRotated ? SkMatrix::RotateDeg(30.f) : SkMatrix::I();
+        for (int i = 0; i < kQuadCount; ++i) {
+            SkRect rect = SkRect::MakeXYWH(r.nextRangeF(0.f, 1000.f), r.nextRangeF(0.f, 1000.f),
+                                           r.nextRangeF(4.f, 64.f), r.nextRangeF(4.f, 64.f));
+            fDeviceQuads[i] = GrQuad::MakeFromRect(rect, viewMatrix);
+            fLocalQuads[i] = GrQuad(SkRect::MakeWH(256.f, 256.f));
+        }
+
+        fSpec = VertexSpec(fDeviceQuads[0].quadType(), ColorType::kNone,
+                           GrQuad::Type::kAxisAligned, /* hasLocalCoords= */ true, Subset::kNo,
+                           GrAAType::kCoverage, /* coverageAsAlpha= */ false,
+                           IndexBufferOption::kPictureFramed);
+        fVertices = std::make_unique<char[]>(kQuadCount * fSpec.verticesPerQuad() *
+                                             fSpec.vertexSize());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            skgpu::ganesh::QuadPerEdgeAA::Tessellator tessellator(fSpec, fVertices.get());
+            for (int j = 0; j < kQuadCount; ++j) {
+                // The tessellator modifies the quads in place, as it does with GrQuadBuffer
+                GrQuad device = fDeviceQuads[j];
+                GrQuad local = fLocalQuads[j];
+                tessellator.append(&device, &local, SK_PMColor4fWHITE, SkRect::MakeEmpty(),
+                                   GrQuadAAFlags::kAll);
+            }
+            tessellator.flush();
+        }
+    }
+
+    SkString                                      fName;
+    bool                                          fRotated;
+    GrQuad                                        fDeviceQuads[kQuadCount];
+    GrQuad                                        fLocalQuads[kQuadCount];
+    skgpu::ganesh::QuadPerEdgeAA::VertexSpec      fSpec;
+    std::unique_ptr<char[]>                       fVertices;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new GrQuadTessellateBench(/* rotated */ false); )
+DEF_BENCH( return new GrQuadTessellateBench(/* rotated */ true); )
+
+#endif // SK_GANESH
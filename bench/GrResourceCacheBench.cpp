@@ -157,6 +157,52 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Simulates a cleanup of a full cache of stale resources (e.g. after a tab is backgrounded). With a
+// time budget the work is spread across several calls ("frames") instead of one long hitch; the
+// total cost of both variants should be about the same.
+class GrResourceCacheBenchDeferredCleanup : public Benchmark {
+public:
+    GrResourceCacheBenchDeferredCleanup(bool timeSliced) : fTimeSliced(timeSliced) {}
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+protected:
+    const char* onGetName() override {
+        return fTimeSliced ? "grresourcecache_deferredcleanup_timesliced"
+                           : "grresourcecache_deferredcleanup";
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        sk_sp<GrDirectContext> context(GrDirectContext::MakeMock(nullptr));
+        if (nullptr == context) {
+            return;
+        }
+        context->setResourceCacheLimits(CACHE_SIZE_COUNT, 1 << 30);
+
+        GrResourceCache* cache = context->priv().getResourceCache();
+        GrGpu* gpu = context->priv().getGpu();
+
+        for (int i = 0; i < loops; ++i) {
+            populate_cache(gpu, CACHE_SIZE_COUNT, /*keyData32Count=*/1);
+            SkASSERT(CACHE_SIZE_COUNT == cache->getResourceCount());
+
+            if (fTimeSliced) {
+                while (!context->performDeferredCleanup(std::chrono::milliseconds(0),
+                                                        std::chrono::microseconds(100))) {
+                }
+            } else {
+                context->performDeferredCleanup(std::chrono::milliseconds(0));
+            }
+            SkASSERT(0 == cache->getResourceCount());
+        }
+    }
+
+private:
+    bool fTimeSliced;
+    using INHERITED = Benchmark;
+};
+
 DEF_BENCH( return new GrResourceCacheBenchAdd(1); )
 #ifdef SK_RELEASE
 // Only on release because on debug the SkTDynamicHash validation is too slow.
@@ -183,3 +229,6 @@ DEF_BENCH( return new GrResourceCacheBenchFind(54); )
 DEF_BENCH( return new GrResourceCacheBenchFind(55); )
 DEF_BENCH( return new GrResourceCacheBenchFind(56); )
 #endif
+
+DEF_BENCH( return new GrResourceCacheBenchDeferredCleanup(false); )
+DEF_BENCH( return new GrResourceCacheBenchDeferredCleanup(true); )
@@ -8,6 +8,8 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "src/base/SkRandom.h"
 #include "src/utils/SkJSON.h"
 
 #if defined(SK_BUILD_FOR_ANDROID)
@@ -55,6 +57,95 @@ private:
 
 DEF_BENCH( return new JsonBench; )
 
+// Parses generated multi-MB documents, to track throughput for the different token classes
+// (bench names are json_skjson_4mb_<content>: 4MB / time = throughput).
+class JsonThroughputBench : public Benchmark {
+public:
+    enum class Content {
+        kNumbers,    // decimal numbers, minified
+        kPretty,     // decimal numbers, indented
+        kExponents,  // numbers in exponent notation
+        kStrings,    // medium length strings
+        kBase64,     // embedded base64 data, as in skottie image assets
+    };
+
+    explicit JsonThroughputBench(Content content) : fContent(content) {
+        static constexpr const char* kNames[] = {
+            "numbers", "pretty", "exponents", "strings", "base64",
+        };
+        fName.printf("json_skjson_4mb_%s", kNames[static_cast<int>(content)]);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        static constexpr size_t kDocumentSize = 4 << 20;
+        const bool pretty = fContent == Content::kPretty;
+
+        SkRandom rand;
+        SkDynamicMemoryWStream doc;
+        doc.writeText("[");
+        while (doc.bytesWritten() < kDocumentSize) {
+            doc.writeText(pretty ? "\n    {\n        \"nm\": " : "{\"nm\":");
+            switch (fContent) {
+                case Content::kStrings:
+                    doc.writeText("\"Lorem ipsum dolor sit amet, consectetur adipiscing elit\"");
+                    break;
+                case Content::kBase64: {
+                    static constexpr char kBase64Chars[] =
+                        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+                    doc.writeText("\"data:image/png;base64,");
+                    for (int i = 0; i < 64 * 1024; ++i) {
+                        doc.write(kBase64Chars + rand.nextULessThan(64), 1);
+                    }
+                    doc.writeText("\"");
+                } break;
+                default:
+                    doc.writeText("\"Layer\"");
+                    break;
+            }
+            doc.writeText(pretty ? ",\n        \"k\": [" : ",\"k\":[");
+            for (int i = 0; i < 8; ++i) {
+                const auto num = SkStringPrintf(fContent == Content::kExponents ? "%e" : "%.3f",
+                                                rand.nextRangeF(-1000, 1000));
+                doc.writeText(i ? "," : "");
+                doc.writeText(num.c_str());
+            }
+            doc.writeText(pretty ? "]\n    }" : "]}");
+            doc.writeText(",");
+        }
+        // Replace the trailing ',' with the array terminator.
+        fData = doc.detachAsData();
+        static_cast<char*>(fData->writable_data())[fData->size() - 1] = ']';
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            skjson::DOM dom(static_cast<const char*>(fData->data()), fData->size());
+            if (dom.root().is<skjson::NullValue>()) {
+                SkDebugf("!! Parsing failed.\n");
+                return;
+            }
+        }
+    }
+
+private:
+    const Content fContent;
+    SkString      fName;
+    sk_sp<SkData> fData;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new JsonThroughputBench(JsonThroughputBench::Content::kNumbers  ); )
+DEF_BENCH( return new JsonThroughputBench(JsonThroughputBench::Content::kPretty   ); )
+DEF_BENCH( return new JsonThroughputBench(JsonThroughputBench::Content::kExponents); )
+DEF_BENCH( return new JsonThroughputBench(JsonThroughputBench::Content::kStrings  ); )
+DEF_BENCH( return new JsonThroughputBench(JsonThroughputBench::Content::kBase64   ); )
+
 #if (0)
 
 #include "rapidjson/document.h"
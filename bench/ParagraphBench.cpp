@@ -8,6 +8,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkString.h"
@@ -20,6 +21,28 @@
 #include "modules/skparagraph/include/ParagraphBuilder.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
 
+#include <cstring>
+#include <vector>
+
+static const char* kLoremText =
+    "This is a very long sentence to test if the text will properly wrap "
+    "around and go to the next line. Sometimes, short sentence. Longer "
+    "sentences are okay too because they are necessary. Very short. "
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
+    "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
+    "commodo consequat. Duis aute irure dolor in reprehenderit in voluptate "
+    "velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint "
+    "occaecat cupidatat non proident, sunt in culpa qui officia deserunt "
+    "mollit anim id est laborum. "
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
+    "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
+    "commodo consequat. Duis aute irure dolor in reprehenderit in voluptate "
+    "velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint "
+    "occaecat cupidatat non proident, sunt in culpa qui officia deserunt "
+    "mollit anim id est laborum.";
+
 class ParagraphBench final : public Benchmark {
     SkString fName;
     sk_sp<skia::textlayout::FontCollection> fFontCollection;
@@ -48,24 +71,6 @@ protected:
         fTStyle.setFontFamilies({SkString("Roboto")});
         fTStyle.setColor(SK_ColorBLACK);
 
-        const char* text =
-            "This is a very long sentence to test if the text will properly wrap "
-            "around and go to the next line. Sometimes, short sentence. Longer "
-            "sentences are okay too because they are necessary. Very short. "
-            "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
-            "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
-            "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
-            "commodo consequat. Duis aute irure dolor in reprehenderit in voluptate "
-            "velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint "
-            "occaecat cupidatat non proident, sunt in culpa qui officia deserunt "
-            "mollit anim id est laborum. "
-            "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
-            "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
-            "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
-            "commodo consequat. Duis aute irure dolor in reprehenderit in voluptate "
-            "velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint "
-            "occaecat cupidatat non proident, sunt in culpa qui officia deserunt "
-            "mollit anim id est laborum.";
         skia::textlayout::ParagraphStyle paragraph_style;
         auto builder =
             skia::textlayout::ParagraphBuilder::make(paragraph_style, fFontCollection);
@@ -74,7 +79,7 @@ protected:
         }
 
         builder->pushStyle(fTStyle);
-        builder->addText(text);
+        builder->addText(kLoremText);
         builder->pop();
         fParagraph = builder->Build();
 
@@ -97,4 +102,251 @@ private:
 
 DEF_BENCH( return new ParagraphBench; )
 
+// Lays out many different paragraphs that share a font collection, either one after another
+// (threads == 0) or with Paragraph::LayoutAll() on a thread pool.
+class ParagraphLayoutAllBench final : public Benchmark {
+    static constexpr int kParagraphCount = 64;
+
+    SkString fName;
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<skia::textlayout::FontCollection> fFontCollection;
+    std::vector<std::unique_ptr<skia::textlayout::Paragraph>> fParagraphs;
+    std::vector<skia::textlayout::Paragraph*> fParagraphPtrs;
+    std::vector<SkScalar> fWidths;
+
+public:
+    explicit ParagraphLayoutAllBench(int threads) : fThreads(threads) {
+        fName.printf("skparagraph_layout_all_%dthreads", threads);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering && !fParagraphs.empty();
+    }
+
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        fFontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        // Measure shaping as well as line breaking
+        fFontCollection->getParagraphCache()->turnOn(false);
+
+        skia::textlayout::TextStyle textStyle;
+        textStyle.setFontFamilies({SkString("Roboto")});
+        textStyle.setColor(SK_ColorBLACK);
+
+        // Rotate the text so that every paragraph is different
+        SkString text(kLoremText);
+        for (int i = 0; i < kParagraphCount; ++i) {
+            skia::textlayout::ParagraphStyle paragraphStyle;
+            auto builder =
+                skia::textlayout::ParagraphBuilder::make(paragraphStyle, fFontCollection);
+            if (!builder) {
+                fParagraphs.clear();
+                return;
+            }
+            size_t offset = (i * 7) % text.size();
+            builder->pushStyle(textStyle);
+            builder->addText(text.c_str() + offset, text.size() - offset);
+            builder->addText(text.c_str(), offset);
+            builder->pop();
+            fParagraphs.push_back(builder->Build());
+            fParagraphPtrs.push_back(fParagraphs.back().get());
+            fWidths.push_back(200 + 4 * i);
+        }
+
+        // Warm up the glyph cache
+        SkCanvas canvas;
+        this->onDraw(1, &canvas);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            for (auto& paragraph : fParagraphs) {
+                paragraph->markDirty();
+            }
+            skia::textlayout::Paragraph::LayoutAll(fParagraphPtrs, fWidths, fExecutor.get());
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new ParagraphLayoutAllBench(0); )
+DEF_BENCH( return new ParagraphLayoutAllBench(2); )
+DEF_BENCH( return new ParagraphLayoutAllBench(4); )
+DEF_BENCH( return new ParagraphLayoutAllBench(8); )
+
+// Builds a screenful of short paragraphs again and lays them out at a different width every
+// frame, like a window that is being resized. The shaped text comes from the paragraph cache,
+// so each frame only breaks the text into lines.
+class ParagraphResizeBench final : public Benchmark {
+    static constexpr int kParagraphCount = 256;
+    static constexpr size_t kTextLength = 80;
+
+    sk_sp<skia::textlayout::FontCollection> fFontCollection;
+    skia::textlayout::TextStyle fTStyle;
+    std::vector<SkString> fTexts;
+    int fFrame = 0;
+
+public:
+    ParagraphResizeBench() = default;
+
+protected:
+    const char* onGetName() override {
+        return "skparagraph_resize_sweep";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering && !fTexts.empty();
+    }
+
+    void onDelayedSetup() override {
+        fFontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+
+        fTStyle.setFontFamilies({SkString("Roboto")});
+        fTStyle.setColor(SK_ColorBLACK);
+
+        // Number both ends so that no paragraph looks like an edit of another one to the cache
+        const size_t length = strlen(kLoremText);
+        for (int i = 0; i < kParagraphCount; ++i) {
+            size_t offset = (i * 13) % (length - kTextLength);
+            SkString text;
+            text.printf("%d ", i);
+            text.append(kLoremText + offset, kTextLength);
+            text.appendf(" %d", i);
+            fTexts.push_back(text);
+        }
+
+        // Shape everything once
+        SkCanvas canvas;
+        this->onDraw(1, &canvas);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            SkScalar width = 100 + 10 * (fFrame++ % 32);
+            for (auto& text : fTexts) {
+                skia::textlayout::ParagraphStyle paragraph_style;
+                auto builder =
+                    skia::textlayout::ParagraphBuilder::make(paragraph_style, fFontCollection);
+                if (!builder) {
+                    return;
+                }
+                builder->pushStyle(fTStyle);
+                builder->addText(text.c_str(), text.size());
+                builder->pop();
+                builder->Build()->layout(width);
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new ParagraphResizeBench; )
+
+// Types into the middle of a paragraph, one keystroke per loop: a character is inserted and
+// erased again by the next keystroke. The paragraph is either edited with updateText()
+// (incremental) or built again from the whole text, which is all a client could do before.
+class ParagraphTypingBench final : public Benchmark {
+    static constexpr SkScalar kWidth = 300;
+
+    SkString fName;
+    bool fIncremental;
+    sk_sp<skia::textlayout::FontCollection> fFontCollection;
+    skia::textlayout::TextStyle fTStyle;
+    std::unique_ptr<skia::textlayout::Paragraph> fParagraph;
+    SkString fText;
+    size_t fCursor = 0;
+    bool fInserted = false;
+
+public:
+    explicit ParagraphTypingBench(bool incremental) : fIncremental(incremental) {
+        fName.printf("skparagraph_typing_%s", incremental ? "incremental" : "rebuild");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering && !!fParagraph;
+    }
+
+    void onDelayedSetup() override {
+        fFontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        // Every keystroke has to shape something
+        fFontCollection->getParagraphCache()->turnOn(false);
+
+        fTStyle.setFontFamilies({SkString("Roboto")});
+        fTStyle.setColor(SK_ColorBLACK);
+
+        fText = SkString(kLoremText);
+        // Type at the end of a word in the middle of the text
+        fCursor = fText.size() / 2;
+        while (fCursor < fText.size() && fText[fCursor] != ' ') {
+            ++fCursor;
+        }
+        fParagraph = this->build();
+        if (!fParagraph) {
+            return;
+        }
+        fParagraph->layout(kWidth);
+
+        // Warm up the glyph cache
+        SkCanvas canvas;
+        this->onDraw(1, &canvas);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fInserted) {
+                fText.remove(fCursor, 1);
+            } else {
+                fText.insert(fCursor, "x");
+            }
+            if (fIncremental) {
+                fParagraph->updateText(fCursor, fCursor + (fInserted ? 1 : 0),
+                                       SkString(fInserted ? "" : "x"));
+            } else {
+                fParagraph = this->build();
+            }
+            fInserted = !fInserted;
+            fParagraph->layout(kWidth);
+        }
+    }
+
+private:
+    std::unique_ptr<skia::textlayout::Paragraph> build() {
+        skia::textlayout::ParagraphStyle paragraph_style;
+        auto builder =
+            skia::textlayout::ParagraphBuilder::make(paragraph_style, fFontCollection);
+        if (!builder) {
+            return nullptr;
+        }
+        builder->pushStyle(fTStyle);
+        builder->addText(fText.c_str(), fText.size());
+        builder->pop();
+        return builder->Build();
+    }
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new ParagraphTypingBench(true); )
+DEF_BENCH( return new ParagraphTypingBench(false); )
+
 #endif // SK_ENABLE_PARAGRAPH
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+
+#if defined(SK_ENABLE_SVG)
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "src/base/SkRandom.h"
+
+// Measures SkSVGDOM construction (XML parsing, node construction and attribute parsing) for
+// generated map-like documents: many styled paths, grouped under transformed layers.
+class SVGLoadBench final : public Benchmark {
+public:
+    explicit SVGLoadBench(size_t documentSize) : fDocumentSize(documentSize) {
+        fName.printf("svg_load_%zumb", documentSize >> 20);
+    }
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkDynamicMemoryWStream doc;
+        doc.writeText("<svg xmlns=\"http://www.w3.org/2000/svg\" "
+                      "width=\"1000\" height=\"1000\" viewBox=\"0 0 1000 1000\">\n");
+
+        int id = 0;
+        while (doc.bytesWritten() < fDocumentSize) {
+            doc.writeText(SkStringPrintf("<g id=\"layer%d\" transform=\"translate(%.2f %.2f) "
+                                         "rotate(%.1f)\" fill-rule=\"evenodd\">\n",
+                                         id++, rand.nextRangeF(0, 1000), rand.nextRangeF(0, 1000),
+                                         rand.nextRangeF(0, 360)).c_str());
+
+            for (int i = 0; i < 64; ++i) {
+                doc.writeText(SkStringPrintf("  <path id=\"p%d\" style=\"fill: #%06x; "
+                                             "stroke: black; stroke-width: %.2f\" d=\"M%.2f %.2f",
+                                             id++, rand.nextU() & 0xffffff,
+                                             rand.nextRangeF(0.5f, 2),
+                                             rand.nextRangeF(0, 1000),
+                                             rand.nextRangeF(0, 1000)).c_str());
+                for (int j = 0; j < 16; ++j) {
+                    doc.writeText(SkStringPrintf(" l%.2f,%.2f",
+                                                 rand.nextRangeF(-10, 10),
+                                                 rand.nextRangeF(-10, 10)).c_str());
+                }
+                doc.writeText("Z\"/>\n");
+            }
+
+            doc.writeText(SkStringPrintf("  <text x=\"%.2f\" y=\"%.2f\" font-size=\"12\">"
+                                         "Label %d</text>\n",
+                                         rand.nextRangeF(0, 1000), rand.nextRangeF(0, 1000),
+                                         id).c_str());
+            doc.writeText("</g>\n");
+        }
+        doc.writeText("</svg>\n");
+
+        fData = doc.detachAsData();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            SkMemoryStream stream(fData);
+            if (!SkSVGDOM::Builder().make(stream)) {
+                SkDebugf("!! Parsing failed.\n");
+                return;
+            }
+        }
+    }
+
+    const size_t  fDocumentSize;
+    SkString      fName;
+    sk_sp<SkData> fData;
+};
+
+DEF_BENCH(return new SVGLoadBench( 1 << 20);)
+DEF_BENCH(return new SVGLoadBench(16 << 20);)
+
+#endif  // defined(SK_ENABLE_SVG)
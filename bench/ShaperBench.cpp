@@ -5,11 +5,15 @@
 
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
 #include "modules/skshaper/include/SkShaper.h"
+#include "src/core/SkTaskGroup.h"
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cfloat>
+#include <vector>
 
 namespace {
 struct ShaperBench : public Benchmark {
@@ -36,6 +40,45 @@ struct ShaperBench : public Benchmark {
         }
     }
 };
+
+// Shapes the same text on several threads at once, each with its own shaper (they share the
+// process-wide font caches).
+struct ShaperThreadsBench : public Benchmark {
+    ShaperThreadsBench(const char* r, const char* n, int threads)
+            : fResource(r), fThreads(threads) {
+        fName.printf("shaper_%s_%dthreads", n, threads);
+    }
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<std::unique_ptr<SkShaper>> fShapers;
+    sk_sp<SkData> fData;
+    const char* fResource;
+    SkString fName;
+    int fThreads;
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        for (int i = 0; i < fThreads; ++i) {
+            fShapers.push_back(SkShaper::Make());
+        }
+        fData = GetResourceAsData(fResource);
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData || fShapers.empty() || !fShapers.front()) { return; }
+        SkFont font = ToolUtils::DefaultFont();
+        const char* text = (const char*)fData->data();
+        size_t len = fData->size();
+        while (loops-- > 0) {
+            SkTaskGroup tasks(*fExecutor);
+            tasks.batch(fThreads, [&](int i) {
+                SkTextBlobBuilderRunHandler rh(text, {0, 0});
+                fShapers[i]->shape(text, len, font, true, FLT_MAX, &rh);
+                (void)rh.makeBlob();
+            });
+            tasks.wait();
+        }
+    }
+};
 }  // namespace
 
 #define SHAPER_BENCH(X) DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_" #X);)
@@ -75,4 +118,12 @@ SHAPER_BENCH(tifnagh)
 SHAPER_BENCH(vai)
 #undef SHAPER_BENCH
 
+#define SHAPER_THREADS_BENCH(X, N) \
+    DEF_BENCH(return new ShaperThreadsBench("text/" #X ".txt", #X, N);)
+SHAPER_THREADS_BENCH(arabic, 4)
+SHAPER_THREADS_BENCH(english, 4)
+SHAPER_THREADS_BENCH(english, 8)
+SHAPER_THREADS_BENCH(han_simplified, 4)
+#undef SHAPER_THREADS_BENCH
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
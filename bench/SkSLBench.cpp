@@ -8,6 +8,12 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/effects/SkRuntimeEffect.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -64,6 +70,7 @@ enum class Output {
     kMetal,
     kSPIRV,
     kSkRP,
+    kGrNone,
     kGrMtl,
     kGrWGSL,
 };
@@ -73,6 +80,7 @@ public:
     static const char* output_string(Output output) {
         switch (output) {
             case Output::kNone:    return "";
+            case Output::kGrNone:  return "";
             case Output::kGLSL:    return "glsl_";
             case Output::kMetal:   return "metal_";
             case Output::kSPIRV:   return "spirv_";
@@ -116,7 +124,9 @@ protected:
     }
 
     bool usesGraphite() const {
-        return fOutput == Output::kGrMtl || fOutput == Output::kGrWGSL;
+        return fOutput == Output::kGrNone ||
+               fOutput == Output::kGrMtl  ||
+               fOutput == Output::kGrWGSL;
     }
 
     void fixUpSource() {
@@ -156,6 +166,7 @@ protected:
             std::string result;
             switch (fOutput) {
                 case Output::kNone:
+                case Output::kGrNone:
                     break;
 
                 case Output::kGLSL:
@@ -513,9 +524,11 @@ void main()
 
 COMPILER_BENCH(tiny, "void main() { sk_FragColor = half4(1); }");
 
-#define GRAPHITE_BENCH(name, text)                                                                \
-    static constexpr char name##_SRC[] = text;                                                    \
-    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrMtl);) \
+#define GRAPHITE_BENCH(name, text)                                                                 \
+    static constexpr char name##_SRC[] = text;                                                     \
+    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/false, Output::kGrNone);)\
+    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrNone);) \
+    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrMtl);)  \
     DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrWGSL);)
 
 // This fragment shader is from the third tile on the top row of GM_gradients_2pt_conical_outside.
@@ -729,8 +742,10 @@ void RunSkSLModuleBenchmarks(NanoJSONResultsWriter* log) {
 
 class SkSLModuleLoaderBench : public Benchmark {
 public:
-    SkSLModuleLoaderBench(const char* name, std::vector<SkSL::ProgramKind> moduleList)
-            : fName(name), fModuleList(std::move(moduleList)) {}
+    SkSLModuleLoaderBench(const char* name,
+                          std::vector<SkSL::ProgramKind> moduleList,
+                          bool parallel = false)
+            : fName(name), fModuleList(std::move(moduleList)), fParallel(parallel) {}
 
     const char* onGetName() override {
         return fName;
@@ -744,12 +759,22 @@ public:
         return false;
     }
 
+    void onDelayedSetup() override {
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
     void onPreDraw(SkCanvas*) override {
         SkSL::ModuleLoader::Get().unloadModules();
     }
 
     void onDraw(int loops, SkCanvas*) override {
         SkASSERT(loops == 1);
+        if (fParallel) {
+            SkSL::ModuleLoader::LoadModulesInParallel(fModuleList, *fExecutor);
+            return;
+        }
         SkSL::Compiler compiler;
         for (SkSL::ProgramKind kind : fModuleList) {
             compiler.moduleForProgramKind(kind);
@@ -758,32 +783,177 @@ public:
 
     const char* fName;
     std::vector<SkSL::ProgramKind> fModuleList;
+    bool fParallel;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+static const std::vector<SkSL::ProgramKind> kGaneshModules = {
+        SkSL::ProgramKind::kVertex,
+        SkSL::ProgramKind::kFragment,
+        SkSL::ProgramKind::kRuntimeColorFilter,
+        SkSL::ProgramKind::kRuntimeShader,
+        SkSL::ProgramKind::kRuntimeBlender,
+        SkSL::ProgramKind::kPrivateRuntimeColorFilter,
+        SkSL::ProgramKind::kPrivateRuntimeShader,
+        SkSL::ProgramKind::kPrivateRuntimeBlender,
+        SkSL::ProgramKind::kCompute,
+};
+
+static const std::vector<SkSL::ProgramKind> kGraphiteModules = {
+        SkSL::ProgramKind::kVertex,
+        SkSL::ProgramKind::kFragment,
+        SkSL::ProgramKind::kRuntimeColorFilter,
+        SkSL::ProgramKind::kRuntimeShader,
+        SkSL::ProgramKind::kRuntimeBlender,
+        SkSL::ProgramKind::kPrivateRuntimeColorFilter,
+        SkSL::ProgramKind::kPrivateRuntimeShader,
+        SkSL::ProgramKind::kPrivateRuntimeBlender,
+        SkSL::ProgramKind::kCompute,
+        SkSL::ProgramKind::kGraphiteVertex,
+        SkSL::ProgramKind::kGraphiteFragment,
+};
+
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh", kGaneshModules);)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite", kGraphiteModules);)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_parallel",
+                                           kGaneshModules, /*parallel=*/true);)
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite_parallel",
+                                           kGraphiteModules, /*parallel=*/true);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Creates a scene's worth of runtime effects, as when loading an effect-heavy animation. Most of
+// the sources repeat, so with the runtime effect cache only the distinct ones are compiled.
+class SkRuntimeEffectMakeBench : public Benchmark {
+public:
+    explicit SkRuntimeEffectMakeBench(bool cached)
+            : fName(cached ? "runtime_effect_make_cached" : "runtime_effect_make_uncached")
+            , fCached(cached) {}
+
+protected:
+    const char* onGetName() override { return fName; }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kNumDistinctEffects; ++i) {
+            fSources.push_back(SkStringPrintf(
+                    "uniform shader child;"
+                    "uniform half4 color;"
+                    "half4 main(float2 p) {"
+                    "    half4 c = child.eval(p * %d.0);"
+                    "    return mix(c, color, half(fract(p.x * 0.%d)));"
+                    "}",
+                    i + 1, i + 1));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        size_t oldLimit = SkGraphics::GetRuntimeEffectCacheLimit();
+        if (!fCached) {
+            SkGraphics::SetRuntimeEffectCacheLimit(0);
+        }
+        for (int i = 0; i < loops; ++i) {
+            // Each iteration is a fresh load; only the effects within it can be shared.
+            SkGraphics::PurgeRuntimeEffectCache();
+            for (int j = 0; j < kNumEffects; ++j) {
+                auto [effect, error] =
+                        SkRuntimeEffect::MakeForShader(fSources[j % kNumDistinctEffects]);
+                if (!effect) {
+                    SK_ABORT("runtime effect compilation failed: %s\n", error.c_str());
+                }
+            }
+        }
+        SkGraphics::SetRuntimeEffectCacheLimit(oldLimit);
+    }
+
+private:
+    inline static constexpr int kNumEffects = 100;
+    inline static constexpr int kNumDistinctEffects = 10;
+
+    const char* fName;
+    bool fCached;
+    std::vector<SkString> fSources;
+};
+
+DEF_BENCH(return new SkRuntimeEffectMakeBench(/*cached=*/true);)
+DEF_BENCH(return new SkRuntimeEffectMakeBench(/*cached=*/false);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Draws a runtime shader on the CPU, which runs its SkSL through the Raster Pipeline backend. The
+// helper functions are inlined into a series of slot-to-slot copies, which the RP optimizer can
+// mostly eliminate; this measures the per-pixel cost of the stages which remain.
+class SkRuntimeShaderRasterBench : public Benchmark {
+public:
+    SkRuntimeShaderRasterBench(const char* name, const char* src)
+            : fName(SkStringPrintf("sksl_rp_draw_%s", name))
+            , fSrc(src) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kRaster; }
+
+    void onDelayedSetup() override {
+        auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(fSrc));
+        if (!effect) {
+            SK_ABORT("runtime effect compilation failed: %s\n", error.c_str());
+        }
+        SkRuntimeShaderBuilder builder(std::move(effect));
+        builder.uniform("scale") = 0.05f;
+        builder.uniform("tint") = SkV4{0.2f, 0.4f, 0.6f, 1.0f};
+        fPaint.setShader(builder.makeShader());
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawRect(SkRect::MakeWH(256, 256), fPaint);
+        }
+    }
+
+private:
+    SkString fName;
+    const char* fSrc;
+    SkPaint fPaint;
 };
 
-DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh",
-                                           {
-                                                   SkSL::ProgramKind::kVertex,
-                                                   SkSL::ProgramKind::kFragment,
-                                                   SkSL::ProgramKind::kRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kRuntimeShader,
-                                                   SkSL::ProgramKind::kRuntimeBlender,
-                                                   SkSL::ProgramKind::kPrivateRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kPrivateRuntimeShader,
-                                                   SkSL::ProgramKind::kPrivateRuntimeBlender,
-                                                   SkSL::ProgramKind::kCompute,
-                                           });)
-
-DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
-                                           {
-                                                   SkSL::ProgramKind::kVertex,
-                                                   SkSL::ProgramKind::kFragment,
-                                                   SkSL::ProgramKind::kRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kRuntimeShader,
-                                                   SkSL::ProgramKind::kRuntimeBlender,
-                                                   SkSL::ProgramKind::kPrivateRuntimeColorFilter,
-                                                   SkSL::ProgramKind::kPrivateRuntimeShader,
-                                                   SkSL::ProgramKind::kPrivateRuntimeBlender,
-                                                   SkSL::ProgramKind::kCompute,
-                                                   SkSL::ProgramKind::kGraphiteVertex,
-                                                   SkSL::ProgramKind::kGraphiteFragment,
-                                           });)
+DEF_BENCH(return new SkRuntimeShaderRasterBench("inlined_helpers", R"(
+    uniform float scale;
+    uniform half4 tint;
+
+    void rotate(inout float2 p, float a) {
+        float2 cs = float2(cos(a), sin(a));
+        p = float2(p.x * cs.x - p.y * cs.y, p.x * cs.y + p.y * cs.x);
+    }
+    half4 shade(float2 p, half4 base, out half alpha) {
+        half4 c = base;
+        c.rgb *= half3(fract(p.xyx));
+        alpha = c.a;
+        return c;
+    }
+    half4 main(float2 xy) {
+        float2 p = xy * scale;
+        rotate(p, 0.5);
+        rotate(p, p.x);
+        half alpha;
+        half4 c = shade(p, tint, alpha);
+        return half4(c.rgb * alpha, alpha);
+    }
+)");)
+
+DEF_BENCH(return new SkRuntimeShaderRasterBench("loop", R"(
+    uniform float scale;
+    uniform half4 tint;
+
+    half4 main(float2 xy) {
+        float2 p = xy * scale;
+        half4 c = half4(0);
+        for (int i = 0; i < 8; ++i) {
+            float2 q = p;
+            q += float2(i);
+            c += tint * half(fract(q.x * q.y));
+        }
+        return c / 8;
+    }
+)");)
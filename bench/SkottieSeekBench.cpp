@@ -0,0 +1,92 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "include/core/SkString.h"
+#include "modules/skottie/include/Skottie.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Measures animation state updates (seek) only, with no rendering: the cost of evaluating all
+// keyframed properties and syncing the scene graph.
+class SkottieSeekBench final : public Benchmark {
+public:
+    enum class Mode {
+        kPlayback, // monotonic, frame-by-frame
+        kScrub,    // jumps around the timeline
+    };
+
+    SkottieSeekBench(const char* name, const char* source, Mode mode)
+        : fName(SkStringPrintf("skottie_seek_%s_%s",
+                               mode == Mode::kPlayback ? "playback" : "scrub", name))
+        , fSource(source)
+        , fMode(mode) {}
+
+private:
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        const auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+
+        fAnimation = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(reinterpret_cast<const char*>(data->data()), data->size());
+        SkASSERT(fAnimation);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const double frames = std::max(std::floor(fAnimation->outPoint() - fAnimation->inPoint()),
+                                       1.0);
+
+        while (loops-- > 0) {
+            if (fMode == Mode::kPlayback) {
+                // Sub-frame steps, as when playing at a higher refresh rate than the animation.
+                for (double f = 0; f < frames; f += 0.5) {
+                    fAnimation->seekFrame(f);
+                }
+            } else {
+                for (double f = 0; f < frames; f += 0.5) {
+                    // Stride through the timeline by a large step coprime with the frame count.
+                    fAnimation->seekFrame(std::fmod(f * 37, frames));
+                }
+            }
+        }
+    }
+
+    const SkString            fName;
+    const char*               fSource;
+    const Mode                fMode;
+    sk_sp<skottie::Animation> fAnimation;
+};
+
+using Mode = SkottieSeekBench::Mode;
+
+DEF_BENCH(return new SkottieSeekBench("large",  "skottie/skottie-text-scale-to-fit-minmax.json",
+                                      Mode::kPlayback));
+DEF_BENCH(return new SkottieSeekBench("large",  "skottie/skottie-text-scale-to-fit-minmax.json",
+                                      Mode::kScrub));
+DEF_BENCH(return new SkottieSeekBench("medium", "skottie/skottie-sphere-effect.json",
+                                      Mode::kPlayback));
+DEF_BENCH(return new SkottieSeekBench("medium", "skottie/skottie-sphere-effect.json",
+                                      Mode::kScrub));
+DEF_BENCH(return new SkottieSeekBench("small",  "skottie/skottie_sample_multiframe.json",
+                                      Mode::kPlayback));
+DEF_BENCH(return new SkottieSeekBench("small",  "skottie/skottie_sample_multiframe.json",
+                                      Mode::kScrub));
+DEF_BENCH(return new SkottieSeekBench("phonehub_onboard", "skottie/skottie-phonehub-onboard.json",
+                                      Mode::kPlayback));
+DEF_BENCH(return new SkottieSeekBench("phonehub_onboard", "skottie/skottie-phonehub-onboard.json",
+                                      Mode::kScrub));
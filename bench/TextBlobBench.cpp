@@ -19,6 +19,12 @@
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#if defined(SK_GANESH)
+#include "include/gpu/GrDirectContext.h"
+#endif
+
+#include <algorithm>
+
 /*
  * A trivial test which benchmarks the performance of a textblob with a single run.
  */
@@ -109,3 +115,69 @@ class TextBlobMakeBench : public SkTextBlobBench {
     }
 };
 DEF_BENCH( return new TextBlobMakeBench(); )
+
+/*
+ * Simulates scrolling through CJK text: each frame draws a window of blobs made of distinct glyphs,
+ * and the window moves on between frames, so the glyph atlas keeps filling and compacting.
+ */
+class TextBlobCJKChurnBench : public Benchmark {
+    const char* onGetName() override {
+        return "TextBlobCJKChurnBench";
+    }
+
+    void onDelayedSetup() override {
+        sk_sp<SkTypeface> typeface = ToolUtils::CreateTestTypeface("Noto Sans CJK SC",
+                                                                   SkFontStyle());
+        if (!typeface || typeface->countGlyphs() < 1000) {
+            typeface = ToolUtils::CreateTypefaceFromResource("fonts/NotoSansCJK-VF-subset.otf.ttc");
+        }
+        if (!typeface) {
+            typeface = ToolUtils::DefaultPortableTypeface();
+        }
+        int glyphCount = std::max(typeface->countGlyphs(), 1);
+
+        SkRandom rand;
+        for (int i = 0; i < kNumBlobs; ++i) {
+            // Fonts with few glyphs still churn the atlas since each size has its own glyphs.
+            SkFont font(typeface, 24 + 2 * (i % 16));
+            SkTextBlobBuilder builder;
+            const SkTextBlobBuilder::RunBuffer& run =
+                    builder.allocRunPosH(font, kGlyphsPerBlob, 0, nullptr);
+            for (int j = 0; j < kGlyphsPerBlob; ++j) {
+                run.glyphs[j] = SkToU16(rand.nextULessThan(glyphCount));
+                run.pos[j] = j * font.getSize();
+            }
+            fBlobs[i] = builder.make();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+#if defined(SK_GANESH)
+        auto dContext = GrAsDirectContext(canvas->recordingContext());
+#endif
+        SkPaint paint;
+        for (int i = 0; i < loops; ++i) {
+            for (int line = 0; line < kLinesPerFrame; ++line) {
+                canvas->drawTextBlob(fBlobs[(fFirstBlob + line) % kNumBlobs],
+                                     0, 64.f * (line + 1), paint);
+            }
+            fFirstBlob = (fFirstBlob + kLinesScrolledPerFrame) % kNumBlobs;
+#if defined(SK_GANESH)
+            // Each flush is a frame boundary, at which point the atlas is compacted.
+            if (dContext) {
+                dContext->flush();
+            }
+#endif
+        }
+    }
+
+private:
+    inline static constexpr int kNumBlobs = 256;
+    inline static constexpr int kGlyphsPerBlob = 24;
+    inline static constexpr int kLinesPerFrame = 16;
+    inline static constexpr int kLinesScrolledPerFrame = 5;
+
+    sk_sp<SkTextBlob> fBlobs[kNumBlobs];
+    int               fFirstBlob = 0;
+};
+DEF_BENCH( return new TextBlobCJKChurnBench(); )
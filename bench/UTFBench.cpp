@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkUTF.h"
+
+#include <cstring>
+
+// Converts a few MB of UTF-8 text, made of repeats of one sample, the way skparagraph does for
+// long documents.
+class UTFBench : public Benchmark {
+public:
+    enum class Op { kCount, kToUTF16, kToUTF8, kIndices };
+
+    UTFBench(Op op, const char* sample, const char* sampleName) : fOp(op), fSample(sample) {
+        static const char* kOpNames[] = {"count", "to_utf16", "to_utf8", "indices"};
+        fName.printf("utf8_%s_%s", kOpNames[(int)op], sampleName);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        constexpr size_t kTextBytes = 4 << 20;
+        const size_t sampleBytes = strlen(fSample);
+        while (fUTF8.size() < kTextBytes) {
+            fUTF8.append(fSample, sampleBytes);
+        }
+        fUTF16Units = SkUTF::UTF8ToUTF16(nullptr, 0, fUTF8.c_str(), fUTF8.size());
+        SkASSERT(fUTF16Units > 0);
+        fUTF16.reset(fUTF16Units);
+        SkUTF::UTF8ToUTF16(fUTF16.get(), fUTF16Units, fUTF8.c_str(), fUTF8.size());
+        fConvertedUTF8.reset(fUTF8.size());
+        fUTF8IndexForUTF16Index.reset(fUTF8.size() + 1);
+        fUTF16IndexForUTF8Index.reset(fUTF8.size() + 1);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        volatile int result = 0;
+        for (int i = 0; i < loops; ++i) {
+            switch (fOp) {
+                case Op::kCount:
+                    result = SkUTF::CountUTF8(fUTF8.c_str(), fUTF8.size());
+                    break;
+                case Op::kToUTF16:
+                    result = SkUTF::UTF8ToUTF16(fUTF16.get(), fUTF16Units,
+                                                fUTF8.c_str(), fUTF8.size());
+                    break;
+                case Op::kToUTF8:
+                    result = SkUTF::UTF16ToUTF8(fConvertedUTF8.get(), SkToInt(fUTF8.size()),
+                                                fUTF16.get(), fUTF16Units);
+                    break;
+                case Op::kIndices:
+                    result = SkUTF::UTF8ToUTF16Indices(fUTF8.c_str(), fUTF8.size(),
+                                                       fUTF8IndexForUTF16Index.get(),
+                                                       fUTF16IndexForUTF8Index.get());
+                    break;
+            }
+        }
+        (void)result;
+    }
+
+private:
+    const Op fOp;
+    const char* fSample;
+    SkString fName;
+    SkString fUTF8;
+    int fUTF16Units = 0;
+    skia_private::AutoTMalloc<uint16_t> fUTF16;
+    skia_private::AutoTMalloc<char> fConvertedUTF8;
+    skia_private::AutoTMalloc<size_t> fUTF8IndexForUTF16Index;
+    skia_private::AutoTMalloc<size_t> fUTF16IndexForUTF8Index;
+};
+
+static constexpr char kASCII[] = "The quick brown fox jumps over the lazy dog. ";
+static constexpr char kLatin[] = "Le cœur a ses raisons que la raison ne connaît point. ";
+static constexpr char kHan[] = "我能吞下玻璃而不伤身体。";
+
+#define UTF_BENCHES(op)                                                  \
+    DEF_BENCH(return new UTFBench(UTFBench::Op::op, kASCII, "ascii");)   \
+    DEF_BENCH(return new UTFBench(UTFBench::Op::op, kLatin, "latin");)   \
+    DEF_BENCH(return new UTFBench(UTFBench::Op::op, kHan, "han");)
+
+UTF_BENCHES(kCount)
+UTF_BENCHES(kToUTF16)
+UTF_BENCHES(kToUTF8)
+UTF_BENCHES(kIndices)
+
+#undef UTF_BENCHES
@@ -126,6 +126,26 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  SkRuntimeEffects compiled from identical SkSL with identical options are shared through a
+     *  process-wide cache. These functions get/set its approximate memory limit; the least
+     *  recently used effects are purged when it is exceeded. A limit of zero disables the cache.
+     *  Set returns the previous limit.
+     */
+    static size_t GetRuntimeEffectCacheLimit();
+    static size_t SetRuntimeEffectCacheLimit(size_t newLimit);
+
+    /**
+     *  Return the approximate number of bytes currently used by the runtime effect cache.
+     */
+    static size_t GetRuntimeEffectCacheUsed();
+
+    /**
+     *  Purge all effects from the runtime effect cache. Effects that are still referenced
+     *  elsewhere remain valid. This does not change the limit.
+     */
+    static void PurgeRuntimeEffectCache();
+
     /**
      *  Dumps memory usage of caches using the SkTraceMemoryDump interface. See SkTraceMemoryDump
      *  for usage of this method.
@@ -239,6 +239,27 @@ public:
             std::chrono::milliseconds msNotUsed,
             GrPurgeResourceOptions opts = GrPurgeResourceOptions::kAllResources);
 
+    /**
+     * Time-sliced version of performDeferredCleanup(). Resources are purged in the same order but
+     * the work stops once roughly 'timeBudget' has elapsed, so that a large cleanup (e.g. after
+     * the cache limit was lowered) can be spread across several frames instead of causing a hitch.
+     * At least one resource is purged per call when there is work to do.
+     *
+     * @return true if all the cleanup work was done, or false if the call should be repeated
+     *         (e.g. on the next frame) to finish it.
+     */
+    bool performDeferredCleanup(
+            std::chrono::milliseconds msNotUsed,
+            std::chrono::microseconds timeBudget,
+            GrPurgeResourceOptions opts = GrPurgeResourceOptions::kAllResources);
+
+    /**
+     * Gets the running totals of the number of resources and bytes of video memory that were
+     * purged from the cache (by budget enforcement and the purge/cleanup calls). Sampling these
+     * once per frame gives the amount of memory freed per frame.
+     */
+    void getResourceCachePurgeStats(int* purgedResourceCount, size_t* purgedBytes) const;
+
     // Temporary compatibility API for Android.
     void purgeResourcesNotUsedInMs(std::chrono::milliseconds msNotUsed) {
         this->performDeferredCleanup(msNotUsed);
@@ -11,6 +11,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
 #include "modules/skresources/include/SkResources.h"
@@ -26,6 +27,7 @@
 #include <vector>
 
 class SkCanvas;
+class SkData;
 class SkStream;
 struct SkRect;
 
@@ -100,6 +102,8 @@ public:
                                          // frames are only resolved when needed, at seek() time.
             kPreferEmbeddedFonts = 0x02, // Attempt to use the embedded fonts (glyph paths,
                                          // normally used as fallback) over native Skia typefaces.
+            kCacheStaticLayers   = 0x04, // Cache the rendered content of layers with no
+                                         // animated properties (see sksg::CacheEffect).
         };
 
         explicit Builder(uint32_t flags = 0);
@@ -176,12 +180,34 @@ public:
         sk_sp<Animation> make(const char* data, size_t length);
         sk_sp<Animation> makeFromFile(const char path[]);
 
+        /**
+         * Factories for the binary JSON produced by EncodeBinaryJSON(), which load the JSON
+         * document without parsing it (makeFromBinaryJSONFile() maps it from disk).  They only
+         * accept binary JSON, and the factories above only accept Lottie JSON.
+         */
+        sk_sp<Animation> makeFromBinaryJSON(const char* data, size_t length);
+        sk_sp<Animation> makeFromBinaryJSONFile(const char path[]);
+
+        /**
+         * Parses Lottie JSON, and returns the parsed document in a binary form that
+         * makeFromBinaryJSON() loads without parsing.  It is only loadable by builds with the
+         * same pointer size as the one that made it.
+         *
+         * This is the JSON document only: building an animation from it still builds the scene
+         * graph and animators, so it saves the JSON parse, not the whole of make().
+         *
+         * @return The binary JSON, or nullptr if the JSON could not be parsed.
+         */
+        static sk_sp<SkData> EncodeBinaryJSON(const char* data, size_t length);
+
         /**
          * Get handle for SlotManager after animation is built.
          */
         const sk_sp<SlotManager>& getSlotManager() const {return fSlotManager;}
 
     private:
+        sk_sp<Animation> load(const char* data, size_t length, bool binaryJSON);
+
         const uint32_t          fFlags;
 
         sk_sp<ResourceProvider>   fResourceProvider;
@@ -232,6 +258,26 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Partial redraw: only repaints the damaged regions of the previously rendered frame.
+     *
+     * The canvas must hold the previous frame, as rendered with the same dst rect and flags
+     * (e.g. a retained raster surface).  Damaged regions are cleared to transparent, then
+     * repainted with only the scene nodes intersecting them.
+     *
+     * The damage rects are in animation coordinates, as collected by an InvalidationController
+     * passed to seek*() since the previous frame was rendered (typically merged via
+     * InvalidationController::mergedRects() to trade overdraw for fewer rects).  The first seek
+     * does not generate damage: the first frame must be rendered in full.
+     *
+     * @param canvas   destination canvas, holding the previous frame
+     * @param dst      optional destination rect
+     * @param flags    RenderFlags
+     * @param damage   regions to repaint
+     */
+    void render(SkCanvas* canvas, const SkRect* dst, RenderFlags flags,
+                SkSpan<const SkRect> damage) const;
+
     /**
      * [Deprecated: use one of the other versions.]
      *
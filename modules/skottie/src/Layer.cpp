@@ -25,6 +25,7 @@
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/effects/Effects.h"
 #include "modules/skottie/src/effects/MotionBlurEffect.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGClipEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGeometryNode.h"
@@ -501,6 +502,12 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
     // Optional layer mask.
     layer = AttachMask(fJlayer["masksProperties"], &abuilder, std::move(layer));
 
+    // Optionally cache static layer content (no animators beyond the transform-related ones).
+    if (layer && (abuilder.fFlags & Animation::Builder::kCacheStaticLayers) &&
+        abuilder.fCurrentAnimatorScope->size() == fTransformAnimatorCount) {
+        layer = sksg::CacheEffect::Make(std::move(layer));
+    }
+
     // Does the transform apply to effects also?
     // (AE quirk: it doesn't - except for solid layers)
     const auto transform_effects = (build_info.fFlags & kTransformEffects);
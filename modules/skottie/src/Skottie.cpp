@@ -12,6 +12,7 @@
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
@@ -367,6 +368,14 @@ sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
 }
 
 sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
+    return this->load(data, data_len, /*binaryJSON=*/false);
+}
+
+sk_sp<Animation> Animation::Builder::makeFromBinaryJSON(const char* data, size_t data_len) {
+    return this->load(data, data_len, /*binaryJSON=*/true);
+}
+
+sk_sp<Animation> Animation::Builder::load(const char* data, size_t data_len, bool binaryJSON) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     // Sanitize factory args.
@@ -381,11 +390,13 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     fStats.fJsonSize = data_len;
     const auto t0 = std::chrono::steady_clock::now();
 
-    const skjson::DOM dom(data, data_len);
+    const skjson::DOM dom(data, data_len, binaryJSON ? skjson::DOM::Format::kBinary
+                                                     : skjson::DOM::Format::kJSON);
     if (!dom.root().is<skjson::ObjectValue>()) {
         // TODO: more error info.
         if (fLogger) {
-            fLogger->log(Logger::Level::kError, "Failed to parse JSON input.\n");
+            fLogger->log(Logger::Level::kError, binaryJSON ? "Failed to load binary JSON input.\n"
+                                                           : "Failed to parse JSON input.\n");
         }
         return nullptr;
     }
@@ -463,6 +474,27 @@ sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
                 : nullptr;
 }
 
+sk_sp<Animation> Animation::Builder::makeFromBinaryJSONFile(const char path[]) {
+    const auto data = SkData::MakeFromFileName(path);
+
+    return data ? this->makeFromBinaryJSON(static_cast<const char*>(data->data()), data->size())
+                : nullptr;
+}
+
+sk_sp<SkData> Animation::Builder::EncodeBinaryJSON(const char* data, size_t data_len) {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    const skjson::DOM dom(data, data_len);
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        return nullptr;
+    }
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+
+    return stream.detachAsData();
+}
+
 Animation::Animation(sk_sp<sksg::RenderNode> scene_root,
                      std::vector<sk_sp<internal::Animator>>&& animators,
                      SkString version, const SkSize& size,
@@ -510,6 +542,35 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
     fSceneRoot->render(canvas);
 }
 
+void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags,
+                       SkSpan<const SkRect> damage) const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    if (!fSceneRoot)
+        return;
+
+    auto ctm = canvas->getTotalMatrix();
+    if (dstR) {
+        ctm.preConcat(SkMatrix::RectToRect(SkRect::MakeSize(this->size()), *dstR,
+                                           SkMatrix::kCenter_ScaleToFit));
+    }
+
+    // Repaint whole device pixels, to avoid partial coverage seams at the damage edges.
+    SkRegion damage_rgn;
+    for (const auto& r : damage) {
+        damage_rgn.op(ctm.mapRect(r).roundOut(), SkRegion::kUnion_Op);
+    }
+    if (damage_rgn.isEmpty()) {
+        return;
+    }
+
+    SkAutoCanvasRestore restore(canvas, true);
+    canvas->clipRegion(damage_rgn);
+    canvas->clear(SK_ColorTRANSPARENT);
+
+    this->render(canvas, dstR, renderFlags);
+}
+
 void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
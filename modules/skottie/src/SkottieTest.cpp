@@ -5,9 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "tests/Test.h"
 
 #include <cmath>
@@ -269,3 +273,124 @@ DEF_TEST(Skottie_Layer_NoType, r) {
     // passes if we don't crash
     REPORTER_ASSERT(r, anim);
 }
+
+DEF_TEST(Skottie_BinaryJSON, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1,
+                 "sw": 100,
+                 "sh": 100,
+                 "sc": "#00ff00",
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "o": { "a": 1, "k": [ {"t": 0, "s": [0]}, {"t": 100, "s": [100]} ] }
+                 }
+               }
+             ]
+           })";
+
+    const auto binary = Animation::Builder::EncodeBinaryJSON(json, strlen(json));
+    REPORTER_ASSERT(r, binary);
+    REPORTER_ASSERT(r, !Animation::Builder::EncodeBinaryJSON("{ not json", 10));
+    const auto* binary_data = static_cast<const char*>(binary->data());
+
+    auto from_json = Animation::Builder().make(json, strlen(json));
+    auto from_binary = Animation::Builder().makeFromBinaryJSON(binary_data, binary->size());
+    REPORTER_ASSERT(r, from_json && from_binary);
+
+    // Each factory only takes its own format.
+    REPORTER_ASSERT(r, !Animation::Builder().make(binary_data, binary->size()));
+    REPORTER_ASSERT(r, !Animation::Builder().makeFromBinaryJSON(json, strlen(json)));
+    REPORTER_ASSERT(r, from_binary->version() == from_json->version());
+    REPORTER_ASSERT(r, from_binary->size() == from_json->size());
+    REPORTER_ASSERT(r, from_binary->duration() == from_json->duration());
+
+    auto render_center = [](Animation* anim) {
+        auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(100, 100));
+        anim->seekFrame(50);
+        anim->render(surface->getCanvas());
+        SkBitmap bm;
+        bm.allocPixels(surface->imageInfo());
+        surface->readPixels(bm, 0, 0);
+        return bm.getColor(50, 50);
+    };
+    REPORTER_ASSERT(r, render_center(from_binary.get()) == render_center(from_json.get()));
+    REPORTER_ASSERT(r, render_center(from_binary.get()) != SK_ColorTRANSPARENT);
+}
+
+DEF_TEST(Skottie_DamageRender, r) {
+    // A static background, and a small solid moving across it.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1,
+                 "sw": 10,
+                 "sh": 10,
+                 "sc": "#ff0000",
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ {"t": 0, "s": [10, 10]}, {"t": 100, "s": [90, 90]} ] }
+                 }
+               },
+               {
+                 "ty": 1,
+                 "sw": 80,
+                 "sh": 80,
+                 "sc": "#0000ff",
+                 "ip": 0,
+                 "op": 100,
+                 "ks": { "p": { "a": 0, "k": [50, 50] } }
+               }
+             ]
+           })";
+
+    auto anim = Animation::Builder().make(json, strlen(json));
+    REPORTER_ASSERT(r, anim);
+
+    const auto info = SkImageInfo::MakeN32Premul(200, 200);
+    const auto dst  = SkRect::MakeWH(200, 200);
+    auto partial = SkSurfaces::Raster(info),
+         full    = SkSurfaces::Raster(info);
+
+    anim->seekFrame(0);
+    anim->render(partial->getCanvas(), &dst);
+
+    for (double frame : { 1.0, 2.5, 50.0, 51.0 }) {
+        sksg::InvalidationController ic;
+        anim->seekFrame(frame, &ic);
+
+        // Only the moving solid is damaged.
+        REPORTER_ASSERT(r, !ic.bounds().isEmpty());
+        REPORTER_ASSERT(r, ic.bounds().width() < 50 && ic.bounds().height() < 50);
+
+        const auto damage = ic.mergedRects(4, 0.25f);
+        anim->render(partial->getCanvas(), &dst, 0, damage);
+
+        full->getCanvas()->clear(SK_ColorTRANSPARENT);
+        anim->render(full->getCanvas(), &dst);
+
+        SkBitmap bm1, bm2;
+        bm1.allocPixels(info);
+        bm2.allocPixels(info);
+        partial->readPixels(bm1, 0, 0);
+        full->readPixels(bm2, 0, 0);
+        REPORTER_ASSERT(r, !memcmp(bm1.getPixels(), bm2.getPixels(), bm1.computeByteSize()));
+    }
+}
@@ -49,6 +49,9 @@ void AnimatablePropertyContainer::attachDiscardableAdapter(
 
 void AnimatablePropertyContainer::shrink_to_fit() {
     fAnimators.shrink_to_fit();
+    if (fKeyframeBatch) {
+        fKeyframeBatch->shrink_to_fit();
+    }
 }
 
 bool AnimatablePropertyContainer::bindImpl(const AnimationBuilder& abuilder,
@@ -124,6 +127,14 @@ bool AnimatablePropertyContainer::bindImpl(const AnimationBuilder& abuilder,
         // If all keyframes are constant, there is no reason to treat this
         // as an animated property - apply immediately and discard the animator.
         animator->seek(0);
+    } else if (animator->scalarTarget() || animator->batchComponents()) {
+        // All scalar and vector properties in this container are evaluated in a single batch.
+        if (!fKeyframeBatch) {
+            auto batch = sk_make_sp<KeyframeBatch>();
+            fKeyframeBatch = batch.get();
+            fAnimators.push_back(std::move(batch));
+        }
+        fKeyframeBatch->add(std::move(animator));
     } else {
         fAnimators.push_back(std::move(animator));
     }
@@ -28,6 +28,7 @@ namespace internal {
 
 class AnimationBuilder;
 class AnimatorBuilder;
+class KeyframeBatch;
 
 class Animator : public SkRefCnt {
 public:
@@ -79,6 +80,7 @@ private:
     bool bindImpl(const AnimationBuilder&, const skjson::ObjectValue*, AnimatorBuilder&);
 
     std::vector<sk_sp<Animator>> fAnimators;
+    KeyframeBatch*               fKeyframeBatch = nullptr; // owned by fAnimators
     bool                         fHasSynced = false;
     bool                         fHasSlotID = false;
 };
@@ -9,8 +9,10 @@
 
 #include "include/private/base/SkTo.h"
 #include "modules/skottie/src/SkottieJson.h"
+#include "src/base/SkVx.h"
 #include "src/utils/SkJSON.h"
 
+#include <algorithm>
 #include <cstddef>
 
 #define DUMP_KF_RECORDS 0
@@ -33,7 +35,7 @@ KeyframeAnimator::LERPInfo KeyframeAnimator::getLERPInfo(float t) const {
 
     // Cache the current segment (most queries have good locality).
     if (!fCurrentSegment.contains(t)) {
-        fCurrentSegment = this->find_segment(t);
+        fCurrentSegment = this->find_adjacent_segment(t);
     }
     SkASSERT(fCurrentSegment.contains(t));
 
@@ -49,6 +51,27 @@ KeyframeAnimator::LERPInfo KeyframeAnimator::getLERPInfo(float t) const {
     };
 }
 
+KeyframeAnimator::KFSegment KeyframeAnimator::find_adjacent_segment(float t) const {
+    // During playback, time moves monotonically and a segment miss usually means we've just
+    // crossed into the next (or, for reversed playback, the previous) segment.
+    if (fCurrentSegment.kf0) {
+        if (fCurrentSegment.kf1 != &fKFs.back()) {
+            const KFSegment next = { fCurrentSegment.kf1, fCurrentSegment.kf1 + 1 };
+            if (next.contains(t)) {
+                return next;
+            }
+        }
+        if (fCurrentSegment.kf0 != &fKFs.front()) {
+            const KFSegment prev = { fCurrentSegment.kf0 - 1, fCurrentSegment.kf0 };
+            if (prev.contains(t)) {
+                return prev;
+            }
+        }
+    }
+
+    return this->find_segment(t);
+}
+
 KeyframeAnimator::KFSegment KeyframeAnimator::find_segment(float t) const {
     SkASSERT(fKFs.size() > 1);
     SkASSERT(t > fKFs.front().t);
@@ -89,6 +112,81 @@ float KeyframeAnimator::compute_weight(const KFSegment &seg, float t) const {
     return w;
 }
 
+void KeyframeBatch::add(sk_sp<KeyframeAnimator> animator) {
+    float* scalar_target = animator->scalarTarget();
+    const size_t components = scalar_target ? 1 : animator->batchComponents();
+    SkASSERT(components > 0);
+
+    fEntries.push_back({std::move(animator), scalar_target, components});
+}
+
+void KeyframeBatch::shrink_to_fit() {
+    fEntries.shrink_to_fit();
+}
+
+Animator::StateChanged KeyframeBatch::onSeek(float t) {
+    static constexpr size_t kLanes = 4;
+
+    float  v0[kLanes],
+           v1[kLanes],
+           w [kLanes],
+           old[kLanes];
+    float* dst[kLanes];
+    size_t n = 0;
+
+    skvx::int4 changed = 0;
+    auto flush = [&]() {
+        // Unused lanes are zero-filled, and never register as changed.
+        for (size_t l = n; l < kLanes; ++l) {
+            v0[l] = v1[l] = w[l] = old[l] = 0;
+        }
+
+        const auto a = skvx::float4::Load(v0),
+                   b = skvx::float4::Load(v1),
+                   v = a + (b - a) * skvx::float4::Load(w);
+        changed |= v != skvx::float4::Load(old);
+
+        float values[kLanes];
+        v.store(values);
+        for (size_t l = 0; l < n; ++l) {
+            *dst[l] = values[l];
+        }
+        n = 0;
+    };
+
+    for (const auto& entry : fEntries) {
+        const auto lerp_info = entry.fAnimator->getLERPInfo(t);
+
+        const float *c0, *c1;
+        float* target;
+        if (entry.fScalarTarget) {
+            c0     = &lerp_info.vrec0.flt;
+            c1     = &lerp_info.vrec1.flt;
+            target = entry.fScalarTarget;
+        } else {
+            c0     = entry.fAnimator->batchValues(lerp_info.vrec0);
+            c1     = entry.fAnimator->batchValues(lerp_info.vrec1);
+            target = entry.fAnimator->batchTarget();
+        }
+
+        for (size_t c = 0; c < entry.fComponents; ++c) {
+            v0[n]  = c0[c];
+            v1[n]  = c1[c];
+            w[n]   = lerp_info.weight;
+            old[n] = target[c];
+            dst[n] = target + c;
+            if (++n == kLanes) {
+                flush();
+            }
+        }
+    }
+    if (n) {
+        flush();
+    }
+
+    return any(changed);
+}
+
 AnimatorBuilder::~AnimatorBuilder() = default;
 
 bool AnimatorBuilder::parseKeyframes(const AnimationBuilder& abuilder,
@@ -15,6 +15,7 @@
 #include "include/private/base/SkNoncopyable.h"
 #include "modules/skottie/src/animator/Animator.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 #include <vector>
@@ -77,6 +78,18 @@ public:
         return fKFs.size() == 1;
     }
 
+    // Animators which interpolate their value per float component expose it, so containers can
+    // evaluate them in batches (see KeyframeBatch).  Scalar values are stored inline in the
+    // keyframes, and their target is fixed.
+    virtual float* scalarTarget() const { return nullptr; }
+
+    // Vector values are stored externally: these resolve the target and the keyframe values for
+    // a given value record, |batchComponents()| floats each.  Animators with extra per-value
+    // state (spatial interpolation, auto-orientation) are not batchable, and report 0.
+    virtual size_t       batchComponents()                      const { return 0; }
+    virtual float*       batchTarget()                          const { return nullptr; }
+    virtual const float* batchValues(const Keyframe::Value&)    const { return nullptr; }
+
 protected:
     KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms)
         : fKFs(std::move(kfs))
@@ -91,6 +104,8 @@ protected:
     LERPInfo getLERPInfo(float t) const;
 
 private:
+    friend class KeyframeBatch;
+
     // Two sequential KFRecs determine how the value varies within [kf0 .. kf1)
     struct KFSegment {
         const Keyframe* kf0;
@@ -104,6 +119,9 @@ private:
         }
     };
 
+    // Find the KFSegment containing |t|, probing the neighbors of the cached segment first.
+    KFSegment find_adjacent_segment(float t) const;
+
     // Find the KFSegment containing |t|.
     KFSegment find_segment(float t) const;
 
@@ -115,6 +133,28 @@ private:
     mutable KFSegment             fCurrentSegment = { nullptr, nullptr }; // Cached segment.
 };
 
+// Evaluates the scalar and vector keyframe animators bound to a given container.  These are
+// always seeked with the same local time, so the per-animator segment lookup and easing results
+// are gathered into SoA lanes (one per value component), then interpolated and checked for
+// changes four at a time.
+class KeyframeBatch final : public Animator {
+public:
+    void add(sk_sp<KeyframeAnimator>);
+
+    void shrink_to_fit();
+
+private:
+    StateChanged onSeek(float t) override;
+
+    struct Entry {
+        sk_sp<KeyframeAnimator> fAnimator;
+        float*                  fScalarTarget; // null for vector values
+        size_t                  fComponents;
+    };
+
+    std::vector<Entry> fEntries;
+};
+
 class AnimatorBuilder : public SkNoncopyable {
 public:
     virtual ~AnimatorBuilder();
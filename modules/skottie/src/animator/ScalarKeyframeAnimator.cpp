@@ -34,6 +34,8 @@ public:
         : INHERITED(std::move(kfs), std::move(cms))
         , fTarget(target_value) {}
 
+    float* scalarTarget() const override { return fTarget; }
+
 private:
 
     StateChanged onSeek(float t) override {
@@ -46,7 +46,21 @@ public:
         : INHERITED(std::move(kfs), std::move(cms))
         , fValues(std::move(vs))
         , fVecTarget(vec_target)
-        , fRotTarget(rot_target) {}
+        , fRotTarget(rot_target)
+        , fBatchable(!rot_target && std::none_of(fValues.cbegin(), fValues.cend(),
+                                                 [](const SpatialValue& v) {
+                                                     return v.cmeasure != nullptr;
+                                                 })) {}
+
+    // Plain 2D lerps are batchable: both components are interpolated with the same weight.
+    size_t batchComponents() const override { return fBatchable ? 2 : 0; }
+
+    float* batchTarget() const override { return fVecTarget->ptr(); }
+
+    const float* batchValues(const Keyframe::Value& v) const override {
+        SkASSERT(v.idx < fValues.size());
+        return fValues[v.idx].v2.ptr();
+    }
 
 private:
     StateChanged update(const Vec2Value& new_vec_value, const Vec2Value& new_tan_value) {
@@ -123,6 +137,7 @@ private:
     const std::vector<Vec2KeyframeAnimator::SpatialValue> fValues;
     Vec2Value*                      fVecTarget;
     float*                          fRotTarget;
+    const bool                      fBatchable;
 
     using INHERITED = KeyframeAnimator;
 };
@@ -99,6 +99,18 @@ public:
         fTarget->resize(fVecLen);
     }
 
+    size_t batchComponents() const override { return fVecLen; }
+
+    float* batchTarget() const override {
+        SkASSERT(fTarget->size() == fVecLen);
+        return fTarget->data();
+    }
+
+    const float* batchValues(const Keyframe::Value& v) const override {
+        SkASSERT(v.idx + fVecLen <= fStorage.size());
+        return fStorage.data() + v.idx;
+    }
+
 private:
     StateChanged onSeek(float t) override {
         const auto& lerp_info = this->getLERPInfo(t);
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkString.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/SkottieValue.h"
@@ -12,6 +13,7 @@
 #include "src/utils/SkJSON.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace skottie;
@@ -198,3 +200,99 @@ DEF_TEST(Skottie_Keyframe, reporter) {
         REPORTER_ASSERT(reporter, prop(0.85f).y > 200);
     }
 }
+
+DEF_TEST(Skottie_KeyframeBatch, reporter) {
+    // Scalar, 2D and vector properties bound to the same container are evaluated as a batch,
+    // one lane per component; use counts which don't add up to a multiple of the batch width.
+    static constexpr size_t kScalarCount = 7,
+                            kVec2Count   = 3,
+                            kVectorCount = 2,
+                            kVectorLen   = 3;
+
+    // Component c of property i: k^2 * (i + 1) * (c + 1), for keyframes k = 0..4 at t = k.
+    const auto make_jprop = [](size_t i, size_t components) {
+        SkString jprop("{ \"a\": 1, \"k\": [");
+        for (int k = 0; k <= 4; ++k) {
+            jprop.appendf("%s{ \"t\": %d, \"s\": %s", k ? "," : "", k, components ? "[" : "");
+            for (size_t c = 0; c < std::max<size_t>(components, 1); ++c) {
+                jprop.appendf("%s%d", c ? "," : "",
+                              k * k * static_cast<int>((i + 1) * (c + 1)));
+            }
+            jprop.appendf("%s }", components ? "]" : "");
+        }
+        jprop.append("] }");
+
+        return jprop;
+    };
+
+    class MockContainer final : public AnimatablePropertyContainer {
+    public:
+        ScalarValue fScalars[kScalarCount] = {};
+        Vec2Value   fVec2s[kVec2Count]     = {};
+        VectorValue fVectors[kVectorCount];
+
+    private:
+        void onSync() override {}
+    };
+
+    MockContainer container;
+    AnimationBuilder abuilder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                              nullptr, nullptr, nullptr,
+                              {100, 100}, 10, 1, 0);
+    const auto bind = [&](size_t i, size_t components, auto* value) {
+        const auto jprop = make_jprop(i, components);
+        skjson::DOM json_dom(jprop.c_str(), jprop.size());
+        REPORTER_ASSERT(reporter, container.bind(abuilder, json_dom.root(), value));
+    };
+    for (size_t i = 0; i < kScalarCount; ++i) {
+        bind(i, 0, &container.fScalars[i]);
+    }
+    for (size_t i = 0; i < kVec2Count; ++i) {
+        bind(i, 2, &container.fVec2s[i]);
+    }
+    for (size_t i = 0; i < kVectorCount; ++i) {
+        bind(i, kVectorLen, &container.fVectors[i]);
+    }
+    REPORTER_ASSERT(reporter, !container.isStatic());
+
+    const auto expected = [](size_t i, size_t c, float t) {
+        const float k  = std::floor(t),
+                    v0 = k * k,
+                    v1 = (k + 1) * (k + 1);
+        return (v0 + (v1 - v0) * (t - k)) * (i + 1) * (c + 1);
+    };
+
+    const auto check_values = [&](float t) {
+        for (size_t i = 0; i < kScalarCount; ++i) {
+            REPORTER_ASSERT(reporter,
+                            SkScalarNearlyEqual(container.fScalars[i], expected(i, 0, t)));
+        }
+        for (size_t i = 0; i < kVec2Count; ++i) {
+            REPORTER_ASSERT(reporter,
+                            SkScalarNearlyEqual(container.fVec2s[i].x, expected(i, 0, t)));
+            REPORTER_ASSERT(reporter,
+                            SkScalarNearlyEqual(container.fVec2s[i].y, expected(i, 1, t)));
+        }
+        for (size_t i = 0; i < kVectorCount; ++i) {
+            REPORTER_ASSERT(reporter, container.fVectors[i].size() == kVectorLen);
+            for (size_t c = 0; c < kVectorLen; ++c) {
+                REPORTER_ASSERT(reporter,
+                                SkScalarNearlyEqual(container.fVectors[i][c], expected(i, c, t)));
+            }
+        }
+    };
+
+    // Forward playback, reverse playback, and random access.
+    for (float t : { 0.5f, 1.25f, 1.75f, 2.5f, 3.5f, 2.75f, 1.5f, 0.25f, 3.9f, 0.1f, 2.2f }) {
+        REPORTER_ASSERT(reporter, container.seek(t));
+        check_values(t);
+
+        // Seeking to the same time again doesn't change anything.
+        REPORTER_ASSERT(reporter, !container.seek(t));
+    }
+
+    // Clamped outside the keyframe range.
+    container.seek(-1);
+    container.seek(5);
+    check_values(4);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace skottie;
+
+namespace {
+
+// A solid layer moving across the frame, and fading in.
+constexpr char gJson[] =
+    R"({
+         "v": "5.2.1",
+         "w": 100,
+         "h": 100,
+         "fr": 10,
+         "ip": 0,
+         "op": 20,
+         "layers": [
+           {
+             "ty": 1,
+             "ip": 0,
+             "op": 20,
+             "sw": 40,
+             "sh": 30,
+             "sc": "#20c040",
+             "ks": {
+               "p": { "a": 1, "k": [ { "t":  0, "s": [ 0,  0] },
+                                     { "t": 19, "s": [90, 80] } ] },
+               "o": { "a": 1, "k": [ { "t":  0, "s": 10 },
+                                     { "t": 19, "s": 100 } ] }
+             }
+           }
+         ]
+       })";
+
+// Renders a frame the same way as ParallelFrameRenderer, with a single animation instance.
+SkBitmap render_sequential(Animation* anim, const SkImageInfo& info, double frame,
+                           SkColor background) {
+    SkBitmap bm;
+    bm.allocPixels(info);
+
+    SkCanvas canvas(bm);
+    canvas.clear(background);
+    canvas.concat(SkMatrix::RectToRect(SkRect::MakeSize(anim->size()),
+                                       SkRect::Make(info.dimensions()),
+                                       SkMatrix::kCenter_ScaleToFit));
+    anim->seekFrame(frame);
+    anim->render(&canvas);
+
+    return bm;
+}
+
+bool same_pixels(const SkPixmap& a, const SkPixmap& b) {
+    if (a.info() != b.info()) {
+        return false;
+    }
+    for (int y = 0; y < a.height(); ++y) {
+        if (0 != memcmp(a.addr(0, y), b.addr(0, y), a.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+DEF_TEST(Skottie_ParallelFrameRenderer, r) {
+    static constexpr SkColor kBackground = SK_ColorWHITE;
+    const auto info = SkImageInfo::MakeN32Premul(64, 48);
+
+    auto reference = Animation::Builder().make(gJson, strlen(gJson));
+    REPORTER_ASSERT(r, reference);
+
+    auto renderer = skottie_utils::ParallelFrameRenderer::Make(Animation::Builder(),
+                                                               gJson, strlen(gJson), 3);
+    REPORTER_ASSERT(r, renderer);
+    REPORTER_ASSERT(r, renderer->animation()->duration() == reference->duration());
+
+    // Out of order, and repeated, frames: they are delivered in the order requested.
+    const std::vector<double> frames = { 7, 0, 19, 3.5, 12, 12, 1, 18, 5, 0.25, 15, 9 };
+
+    const auto render = [&](const skottie_utils::ParallelFrameRenderer& frame_renderer,
+                            const std::vector<double>& frame_times,
+                            size_t stop_after) {
+        size_t delivered = 0;
+        const auto proc = [&](size_t index, const SkPixmap& pm) {
+            REPORTER_ASSERT(r, index == delivered, "%zu != %zu", index, delivered);
+            REPORTER_ASSERT(r, index < frame_times.size());
+            if (index < frame_times.size()) {
+                const auto expected = render_sequential(reference.get(), info,
+                                                        frame_times[index], kBackground);
+                REPORTER_ASSERT(r, same_pixels(pm, expected.pixmap()),
+                                "frame %zu (%g) differs", index, frame_times[index]);
+            }
+            return ++delivered < stop_after;
+        };
+        const bool completed = frame_renderer.render(info, frame_times, proc, kBackground);
+
+        return std::make_pair(completed, delivered);
+    };
+
+    {
+        // All frames, in order.
+        const auto [completed, delivered] = render(*renderer, frames, frames.size() + 1);
+        REPORTER_ASSERT(r, completed);
+        REPORTER_ASSERT(r, delivered == frames.size());
+    }
+    {
+        // The renderer can be reused; returning false stops it early.
+        const auto [completed, delivered] = render(*renderer, frames, 4);
+        REPORTER_ASSERT(r, !completed);
+        REPORTER_ASSERT(r, delivered == 4);
+    }
+    {
+        // More threads than frames.
+        auto wide_renderer = skottie_utils::ParallelFrameRenderer::Make(Animation::Builder(),
+                                                                        gJson, strlen(gJson), 8);
+        REPORTER_ASSERT(r, wide_renderer);
+        const auto [completed, delivered] = render(*wide_renderer, { 11, 2 }, 3);
+        REPORTER_ASSERT(r, completed);
+        REPORTER_ASSERT(r, delivered == 2);
+    }
+    {
+        // No frames.
+        const auto [completed, delivered] = render(*renderer, {}, 1);
+        REPORTER_ASSERT(r, completed);
+        REPORTER_ASSERT(r, delivered == 0);
+    }
+
+    // Invalid configurations are rejected.
+    REPORTER_ASSERT(r, !renderer->render(SkImageInfo::MakeN32Premul(0, 0), frames,
+                                         [](size_t, const SkPixmap&) { return true; }));
+    REPORTER_ASSERT(r, !skottie_utils::ParallelFrameRenderer::Make(Animation::Builder(),
+                                                                   "{}", 2, 2));
+}
@@ -7,14 +7,26 @@
 
 #include "modules/skottie/utils/SkottieUtils.h"
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skresources/include/SkResources.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 class SkCanvas;
@@ -296,4 +308,162 @@ sk_sp<skottie::ExternalLayer> ExternalAnimationPrecompInterceptor::onLoadPrecomp
                 : nullptr;
 }
 
+std::unique_ptr<ParallelFrameRenderer> ParallelFrameRenderer::Make(
+        const skottie::Animation::Builder& builder, const char json[], size_t length,
+        int threads) {
+    // Parse once: the workers instantiate their animations from the binary JSON.
+    auto data = skottie::Animation::Builder::EncodeBinaryJSON(json, length);
+    if (!data) {
+        return nullptr;
+    }
+
+    auto anim = skottie::Animation::Builder(builder)
+                    .makeFromBinaryJSON(static_cast<const char*>(data->data()), data->size());
+    if (!anim) {
+        return nullptr;
+    }
+
+    if (threads <= 0) {
+        threads = std::max(1, SkToInt(std::thread::hardware_concurrency()));
+    }
+
+    return std::unique_ptr<ParallelFrameRenderer>(
+            new ParallelFrameRenderer(builder, std::move(data), std::move(anim), threads));
+}
+
+ParallelFrameRenderer::ParallelFrameRenderer(const skottie::Animation::Builder& builder,
+                                             sk_sp<SkData> json,
+                                             sk_sp<skottie::Animation> anim,
+                                             int threads)
+    : fBuilder(builder)
+    , fJson(std::move(json))
+    , fAnimation(std::move(anim))
+    , fThreads(threads)
+    // The calling thread is busy delivering frames, so it doesn't borrow tasks.
+    , fExecutor(SkExecutor::MakeFIFOThreadPool(threads, /*allowBorrowing=*/false)) {}
+
+ParallelFrameRenderer::~ParallelFrameRenderer() = default;
+
+bool ParallelFrameRenderer::render(const SkImageInfo& info, const std::vector<double>& frames,
+                                   const FrameProc& proc, SkColor background) const {
+    if (info.isEmpty() || info.colorType() == kUnknown_SkColorType) {
+        return false;
+    }
+
+    const auto frame_count = frames.size();
+
+    // Frames can be large (a 4K RGBA frame is ~33MB): bound the number of frames in flight,
+    // and recycle their pixel storage.
+    const auto max_in_flight = 2 * SkToSizeT(fThreads);
+
+    const auto scale_matrix = SkMatrix::RectToRect(SkRect::MakeSize(fAnimation->size()),
+                                                   SkRect::Make(info.dimensions()),
+                                                   SkMatrix::kCenter_ScaleToFit);
+
+    std::mutex                             mutex;
+    std::condition_variable                frame_ready;     // a rendered frame was posted
+    bool                                   stopped = false;
+    std::map<size_t, SkBitmap>             rendered;        // rendered frames, pending delivery
+    std::vector<SkBitmap>                  free_bitmaps;    // recycled pixel storage
+    std::vector<sk_sp<skottie::Animation>> free_animations; // idle instances
+
+    const auto render_frame = [&](size_t index) {
+        // Animations are not thread safe: each task uses an idle instance (or builds one),
+        // so there are at most as many instances as executor threads.
+        sk_sp<skottie::Animation> anim;
+        SkBitmap bm;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopped) {
+                return;
+            }
+            if (!free_animations.empty()) {
+                anim = std::move(free_animations.back());
+                free_animations.pop_back();
+            }
+            if (!free_bitmaps.empty()) {
+                bm = std::move(free_bitmaps.back());
+                free_bitmaps.pop_back();
+            }
+        }
+
+        if (!anim) {
+            anim = skottie::Animation::Builder(fBuilder)
+                       .makeFromBinaryJSON(static_cast<const char*>(fJson->data()),
+                                           fJson->size());
+        }
+        if (bm.drawsNothing() && !bm.tryAllocPixels(info)) {
+            bm.reset();
+        }
+
+        if (anim && !bm.drawsNothing()) {
+            SkCanvas canvas(bm);
+            canvas.clear(background);
+            canvas.concat(scale_matrix);
+
+            anim->seekFrame(frames[index]);
+            anim->render(&canvas);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            rendered[index] = std::move(bm);
+            if (anim) {
+                free_animations.push_back(std::move(anim));
+            }
+        }
+        frame_ready.notify_one();
+    };
+
+    // Frames are queued in order, and a new one is queued as each frame is delivered.
+    SkTaskGroup tasks(*fExecutor);
+    size_t next_frame = 0;
+    const auto queue_frame = [&]() {
+        const auto index = next_frame++;
+        tasks.add([&render_frame, index]() { render_frame(index); });
+    };
+    while (next_frame < std::min(frame_count, max_in_flight)) {
+        queue_frame();
+    }
+
+    bool completed = true;
+    for (size_t delivered = 0; delivered < frame_count; ++delivered) {
+        SkBitmap bm;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            frame_ready.wait(lock, [&]() { return rendered.count(delivered) > 0; });
+            auto it = rendered.find(delivered);
+            bm = std::move(it->second);
+            rendered.erase(it);
+        }
+
+        // Frames which failed to render (allocation failure) are delivered as empty pixmaps.
+        SkPixmap pm;
+        if (!bm.peekPixels(&pm)) {
+            pm.reset(info, nullptr, 0);
+        }
+        completed = proc(delivered, pm);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = !completed;
+            if (!bm.drawsNothing()) {
+                free_bitmaps.push_back(std::move(bm));
+            }
+        }
+
+        if (!completed) {
+            break;
+        }
+        if (next_frame < frame_count) {
+            queue_frame();
+        }
+    }
+
+    // Frames still queued after an early stop are skipped.
+    tasks.wait();
+
+    return completed;
+}
+
 } // namespace skottie_utils
@@ -8,17 +8,24 @@
 #ifndef SkottieUtils_DEFINED
 #define SkottieUtils_DEFINED
 
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 #include "modules/skottie/include/ExternalLayer.h"
+#include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class SkExecutor;
+class SkPixmap;
 struct SkSize;
 
 namespace skottie {
@@ -146,6 +153,65 @@ private:
     const SkString                             fPrefix;
 };
 
+/**
+ * Renders animation frames concurrently, into raster surfaces (e.g. for offline video export).
+ *
+ * Frames are rendered as tasks on a thread pool (SkExecutor) owned by the renderer.  Animation
+ * instances are not thread safe, so each pool thread builds its own copy, using the same Builder
+ * configuration.  The JSON is parsed once (see Animation::Builder::EncodeBinaryJSON), and
+ * everything handed out by the Builder's providers is shared by all copies: wrapping the
+ * ResourceProvider in a CachingResourceProvider ensures images are loaded and decoded once, and
+ * typefaces are shared through the font manager.  Consequently, resource providers, loggers and
+ * observers attached to the Builder must be thread safe.
+ *
+ * Frames are delivered in order, on the calling thread.
+ */
+class ParallelFrameRenderer final {
+public:
+    /**
+     * Returns nullptr if the animation cannot be built.
+     *
+     * @param threads  number of rendering threads (0 -> number of cores)
+     */
+    static std::unique_ptr<ParallelFrameRenderer> Make(const skottie::Animation::Builder&,
+                                                       const char json[], size_t length,
+                                                       int threads = 0);
+
+    ~ParallelFrameRenderer();
+
+    /**
+     * An instance for the calling thread, suitable for querying animation properties
+     * (duration, fps, size, etc).
+     */
+    const sk_sp<skottie::Animation>& animation() const { return fAnimation; }
+
+    /**
+     * Called for each rendered frame, in order.  The pixels are only valid for the
+     * duration of the call.  Returning false stops the rendering.
+     */
+    using FrameProc = std::function<bool(size_t index, const SkPixmap&)>;
+
+    /**
+     * Renders the given frames (see Animation::seekFrame), scaled to fit |info|, and passes
+     * them to |proc| in order.
+     *
+     * Returns false if the rendering was stopped by |proc|, or if |info| is not a valid
+     * raster configuration.
+     */
+    bool render(const SkImageInfo& info, const std::vector<double>& frames,
+                const FrameProc& proc, SkColor background = SK_ColorTRANSPARENT) const;
+
+private:
+    ParallelFrameRenderer(const skottie::Animation::Builder&, sk_sp<SkData> json,
+                          sk_sp<skottie::Animation>, int threads);
+
+    const skottie::Animation::Builder fBuilder;
+    const sk_sp<SkData>               fJson;
+    const sk_sp<skottie::Animation>   fAnimation;
+    const int                         fThreads;
+    const std::unique_ptr<SkExecutor> fExecutor;
+};
+
 } // namespace skottie_utils
 
 #endif // SkottieUtils_DEFINED
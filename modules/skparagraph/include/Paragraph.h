@@ -10,6 +10,7 @@
 #include <unordered_set>
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -41,6 +42,18 @@ public:
 
     virtual void layout(SkScalar width) = 0;
 
+    /* Lays out each paragraph at the width with the same index, with the same result as
+     * calling layout() on each of them in turn
+     *
+     * @param paragraphs  distinct paragraphs; they may share a font collection
+     * @param widths      one width per paragraph
+     * @param executor    if not null, the paragraphs are laid out concurrently on its threads
+     *                    (and on the calling thread); this returns when all of them are done
+     */
+    static void LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkSpan<const SkScalar> widths,
+                          SkExecutor* executor);
+
     virtual void paint(SkCanvas* canvas, SkScalar x, SkScalar y) = 0;
 
     virtual void paint(ParagraphPainter* painter, SkScalar x, SkScalar y) = 0;
@@ -80,6 +93,13 @@ public:
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
 
+    // Experimental API that replaces the UTF-8 text in [from, to) with 'text', which takes the
+    // style of the text before it. If the paragraph has been laid out, the next layout only
+    // reshapes the words around the edit and reuses the shaping of the rest of the text.
+    // Returns false (and leaves the paragraph as it was) if the edit splits a code point or
+    // overlaps a placeholder.
+    virtual bool updateText(size_t from, size_t to, const SkString& text) = 0;
+
     enum VisitorFlags {
         kWhiteSpace_VisitorFlag = 1 << 0,
     };
@@ -3,7 +3,11 @@
 #define ParagraphCache_DEFINED
 
 #include "include/private/base/SkMutex.h"
-#include "src/core/SkLRUCache.h"
+#include "include/core/SkString.h"
+#include "src/base/SkTInternalLList.h"
+#include "src/core/SkTHash.h"
+#include <atomic>
+#include <cstddef>
 #include <functional>  // std::function
 
 #define PARAGRAPH_CACHE_STATS
@@ -15,8 +19,16 @@ class ParagraphImpl;
 class ParagraphCacheKey;
 class ParagraphCacheValue;
 
+// Caches the shaped text of paragraphs (which does not depend on the layout width), so a paragraph
+// with the same text and styles can be broken into lines at any width without shaping it again.
+// The cache is LRU and bounded by an (approximate) number of bytes.
+//
+// The cache is split into shards, each with its own lock, so that paragraphs that share a
+// FontCollection can be laid out on different threads without serializing on a single mutex.
 class ParagraphCache {
 public:
+    static constexpr size_t kDefaultByteLimit = 4 * 1024 * 1024;
+
     ParagraphCache();
     ~ParagraphCache();
 
@@ -31,7 +43,12 @@ public:
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
+
+    // Setting the limit to 0 empties the cache and keeps it empty. Returns the previous limit.
+    size_t setByteLimit(size_t bytes);
+    size_t getByteLimit() const { return fByteLimit; }
+    size_t getBytesUsed();
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
@@ -41,23 +58,38 @@ public:
     void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
 
-     mutable SkMutex fParagraphMutex;
-     std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
+    std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
+
+    static const int kShardCount = 8;
 
-    static const int kMaxEntries = 128;
+    struct EntryTraits {
+        static const ParagraphCacheKey& GetKey(const Entry* entry);
+        static uint32_t Hash(const ParagraphCacheKey& key);
+    };
+
+    // Every shard gets an equal part of the byte limit
+    struct Shard {
+        SkMutex fMutex;
+        skia_private::THashTable<Entry*, ParagraphCacheKey, EntryTraits> fMap SK_GUARDED_BY(fMutex);
+        SkTInternalLList<Entry> fLRU SK_GUARDED_BY(fMutex);
+        size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
 
-    struct KeyHash {
-        uint32_t operator()(const ParagraphCacheKey& key) const;
+        void purgeAsNeeded(size_t byteLimit) SK_REQUIRES(fMutex);
     };
+    Shard& shardFor(const ParagraphCacheKey& key);
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
+    Shard fShards[kShardCount];
     bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
+    std::atomic<size_t> fByteLimit;
+
+    // The text of the last paragraph that was added (to any shard)
+    SkMutex fLastCachedTextMutex;
+    SkString fLastCachedText SK_GUARDED_BY(fLastCachedTextMutex);
 
 #ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fTotalRequests;
+    std::atomic<int> fCacheMisses;
+    std::atomic<int> fHashMisses; // cache hit but hash table missed
 #endif
 };
 
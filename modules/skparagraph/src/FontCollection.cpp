@@ -92,11 +92,17 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
 std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<SkString>& familyNames, SkFontStyle fontStyle, const std::optional<FontArguments>& fontArgs) {
     // Look inside the font collections cache first
     FamilyKey familyKey(familyNames, fontStyle, fontArgs);
-    auto found = fTypefaces.find(familyKey);
-    if (found) {
-        return *found;
+    {
+        SkAutoMutexExclusive lock(fTypefacesMutex);
+        auto found = fTypefaces.find(familyKey);
+        if (found) {
+            return *found;
+        }
     }
 
+    // Match outside of the lock. Two threads that miss on the same key both match it, with the
+    // same result.
+
     std::vector<sk_sp<SkTypeface>> typefaces;
     for (const SkString& familyName : familyNames) {
         sk_sp<SkTypeface> match = matchTypeface(familyName, fontStyle);
@@ -129,6 +135,7 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
         }
     }
 
+    SkAutoMutexExclusive lock(fTypefacesMutex);
     fTypefaces.set(familyKey, typefaces);
     return typefaces;
 }
@@ -220,7 +227,10 @@ void FontCollection::enableFontFallback() { fEnableFontFallback = true; }
 
 void FontCollection::clearCaches() {
     fParagraphCache.reset();
-    fTypefaces.reset();
+    {
+        SkAutoMutexExclusive lock(fTypefacesMutex);
+        fTypefaces.reset();
+    }
     SkShapers::HB::PurgeCaches();
 }
 
@@ -539,11 +539,12 @@ void OneLineShaper::matchResolvedFonts(const TextStyle& textStyle,
     }
 }
 
-bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
+bool OneLineShaper::iterateThroughShapingRegions(TextRange shapingRange,
+                                                 SkScalar& advanceX,
+                                                 const ShapeVisitor& shape) {
 
     size_t bidiIndex = 0;
 
-    SkScalar advanceX = 0;
     for (auto& placeholder : fParagraph->fPlaceholders) {
 
         if (placeholder.fTextBefore.width() > 0) {
@@ -555,12 +556,19 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
 
                 // Set up the iterators (the style iterator points to a bigger region that it could
                 TextRange textRange(start, end);
-                auto blockRange = fParagraph->findAllBlocks(textRange);
+                bool clipped = !shapingRange.contains(textRange);
+                if (clipped) {
+                    // Only shape the part of the region that was asked for
+                    textRange = textRange.intersection(shapingRange);
+                }
+                auto blockRange = clipped && textRange.start >= textRange.end
+                                          ? BlockRange(EMPTY_RANGE)
+                                          : fParagraph->findAllBlocks(textRange);
                 if (!blockRange.empty()) {
                     SkSpan<Block> styleSpan(fParagraph->blocks(blockRange));
 
                     // Shape the text between placeholders
-                    if (!shape(textRange, styleSpan, advanceX, start, bidiRegion.level)) {
+                    if (!shape(textRange, styleSpan, advanceX, textRange.start, bidiRegion.level)) {
                         return false;
                     }
                 }
@@ -573,7 +581,7 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
             }
         }
 
-        if (placeholder.fRange.width() == 0) {
+        if (placeholder.fRange.width() == 0 || !shapingRange.contains(placeholder.fRange)) {
             continue;
         }
 
@@ -615,12 +623,17 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
 }
 
 bool OneLineShaper::shape() {
+    SkScalar advanceX = 0;
+    return this->shape(TextRange(0, fParagraph->fText.size()), advanceX);
+}
+
+bool OneLineShaper::shape(TextRange textRange, SkScalar& advanceX) {
 
     // The text can be broken into many shaping sequences
     // (by place holders, possibly, by hard line breaks or tabs, too)
     auto limitlessWidth = std::numeric_limits<SkScalar>::max();
 
-    auto result = iterateThroughShapingRegions(
+    auto result = iterateThroughShapingRegions(textRange, advanceX,
             [this, limitlessWidth]
             (TextRange textRange, SkSpan<Block> styleSpan, SkScalar& advanceX, TextIndex textStart, uint8_t defaultBidiLevel) {
 
@@ -26,6 +26,10 @@ public:
 
     bool shape();
 
+    // Shapes only the text in 'textRange' (which must not cut through placeholders), starting at
+    // 'advanceX' and moving it to the end of the shaped text
+    bool shape(TextRange textRange, SkScalar& advanceX);
+
     size_t unresolvedGlyphs() { return fUnresolvedGlyphs; }
 
     /**
@@ -63,7 +67,9 @@ private:
 
     using ShapeVisitor =
             std::function<SkScalar(TextRange textRange, SkSpan<Block>, SkScalar&, TextIndex, uint8_t)>;
-    bool iterateThroughShapingRegions(const ShapeVisitor& shape);
+    bool iterateThroughShapingRegions(TextRange textRange,
+                                      SkScalar& advanceX,
+                                      const ShapeVisitor& shape);
 
     using ShapeSingleFontVisitor =
             std::function<void(Block, skia_private::TArray<SkShaper::Feature>)>;
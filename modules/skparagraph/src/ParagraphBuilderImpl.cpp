@@ -265,10 +265,7 @@ const ParagraphStyle& ParagraphBuilderImpl::getParagraphStyle() const {
 
 void ParagraphBuilderImpl::ensureUTF16Mapping() {
     fillUTF16MappingOnce([&] {
-        SkUnicode::extractUtfConversionMapping(
-                this->getText(),
-                [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
-                [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+        extractUTF16Mapping(this->getText(), &fUTF8IndexForUTF16Index, &fUTF16IndexForUTF8Index);
     });
 }
 
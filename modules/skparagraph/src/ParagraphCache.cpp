@@ -55,6 +55,12 @@ public:
 
     const SkString& text() const { return fText; }
 
+    size_t approximateSize() const {
+        return sizeof(ParagraphCacheKey) + fText.size() +
+               fPlaceholders.size() * sizeof(Placeholder) +
+               fTextStyles.size() * sizeof(Block);
+    }
+
 private:
     static uint32_t mix(uint32_t hash, uint32_t data);
     uint32_t computeHash() const;
@@ -80,6 +86,22 @@ public:
         , fHasWhitespacesInside(paragraph->fHasWhitespacesInside)
         , fTrailingSpaces(paragraph->fTrailingSpaces) { }
 
+    size_t approximateSize() const {
+        size_t size = sizeof(ParagraphCacheValue) - sizeof(ParagraphCacheKey) +
+                      fKey.approximateSize();
+        for (auto& run : fRuns) {
+            // The glyphs are shared with the paragraphs but the cache keeps them alive
+            size += sizeof(Run) + run.size() * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) +
+                                                sizeof(uint32_t));
+        }
+        size += fClusters.size() * sizeof(Cluster);
+        size += fClustersIndexFromCodeUnit.size() * sizeof(size_t);
+        size += fCodeUnitProperties.size() * sizeof(SkUnicode::CodeUnitFlags);
+        size += fWords.size() * sizeof(size_t);
+        size += fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+        return size;
+    }
+
     // Input == key
     ParagraphCacheKey fKey;
 
@@ -162,9 +184,6 @@ uint32_t ParagraphCacheKey::computeHash() const {
     return hash;
 }
 
-uint32_t ParagraphCache::KeyHash::operator()(const ParagraphCacheKey& key) const {
-    return key.hash();
-}
 
 bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
     if (fText.size() != other.fText.size()) {
@@ -234,15 +253,36 @@ bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
 
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    Entry(ParagraphCacheValue* value) : fValue(value), fSize(value->approximateSize()) {}
     std::unique_ptr<ParagraphCacheValue> fValue;
+    size_t fSize;
+
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
 };
 
+const ParagraphCacheKey& ParagraphCache::EntryTraits::GetKey(const Entry* entry) {
+    return entry->fValue->fKey;
+}
+
+uint32_t ParagraphCache::EntryTraits::Hash(const ParagraphCacheKey& key) {
+    return key.hash();
+}
+
+void ParagraphCache::Shard::purgeAsNeeded(size_t byteLimit) {
+    while (fBytesUsed > byteLimit) {
+        Entry* entry = fLRU.tail();
+        SkASSERT(entry);
+        fLRU.remove(entry);
+        fMap.remove(entry->fValue->fKey);
+        fBytesUsed -= entry->fSize;
+        delete entry;
+    }
+}
+
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
+    , fByteLimit(kDefaultByteLimit)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
@@ -250,7 +290,41 @@ ParagraphCache::ParagraphCache()
 #endif
 { }
 
-ParagraphCache::~ParagraphCache() { }
+ParagraphCache::~ParagraphCache() {
+    this->reset();
+}
+
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) {
+    // The low bits pick the slot inside the shard's hash table, so use the high ones here
+    return fShards[(key.hash() >> 24) % kShardCount];
+}
+
+int ParagraphCache::count() {
+    int count = 0;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        count += shard.fMap.count();
+    }
+    return count;
+}
+
+size_t ParagraphCache::setByteLimit(size_t bytes) {
+    size_t prevLimit = fByteLimit.exchange(bytes);
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.purgeAsNeeded(bytes / kShardCount);
+    }
+    return prevLimit;
+}
+
+size_t ParagraphCache::getBytesUsed() {
+    size_t bytes = 0;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        bytes += shard.fBytesUsed;
+    }
+    return bytes;
+}
 
 void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
@@ -274,11 +348,15 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
 void ParagraphCache::printStatistics() {
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
+#ifdef PARAGRAPH_CACHE_STATS
+    int totalRequests = fTotalRequests;
+    int cacheMisses = fCacheMisses;
+    SkDebugf("Total requests: %d\n", totalRequests);
+    SkDebugf("Cache misses: %d\n", cacheMisses);
+    SkDebugf("Cache miss %%: %f\n", (totalRequests > 0) ? 100.f * cacheMisses / totalRequests : 0.f);
+    int cacheHits = totalRequests - cacheMisses;
     SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+#endif
     SkDebugf("---------------------\n");
 }
 
@@ -287,14 +365,17 @@ void ParagraphCache::abandon() {
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
 #ifdef PARAGRAPH_CACHE_STATS
     fTotalRequests = 0;
     fCacheMisses = 0;
     fHashMisses = 0;
 #endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.purgeAsNeeded(0);
+    }
+    SkAutoMutexExclusive lock(fLastCachedTextMutex);
+    fLastCachedText.reset();
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -304,9 +385,10 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    Entry** entry = shard.fMap.find(key);
 
     if (!entry) {
         // We have a cache miss
@@ -316,7 +398,11 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
         fChecker(paragraph, "missingParagraph", true);
         return false;
     }
-    updateTo(paragraph, entry->get());
+    if (*entry != shard.fLRU.head()) {
+        shard.fLRU.remove(*entry);
+        shard.fLRU.addToHead(*entry);
+    }
+    updateTo(paragraph, *entry);
     fChecker(paragraph, "foundParagraph", true);
     return true;
 }
@@ -328,20 +414,30 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
-
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    Entry** entry = shard.fMap.find(key);
     if (!entry) {
         // isTooMuchMemoryWasted(paragraph) not needed for now
         if (isPossiblyTextEditing(paragraph)) {
             // Skip this paragraph
             return false;
         }
-        ParagraphCacheValue* value = new ParagraphCacheValue(std::move(key), paragraph);
-        fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value));
+        const size_t byteLimit = fByteLimit / kShardCount;
+        auto newEntry = std::make_unique<Entry>(new ParagraphCacheValue(std::move(key), paragraph));
+        if (newEntry->fSize > byteLimit) {
+            // The paragraph would push everything else out of the shard
+            return false;
+        }
+        const ParagraphCacheValue* value = newEntry->fValue.get();
+        shard.fBytesUsed += newEntry->fSize;
+        shard.fMap.set(newEntry.get());
+        shard.fLRU.addToHead(newEntry.release());
+        shard.purgeAsNeeded(byteLimit);
         fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
+        SkAutoMutexExclusive lastLock(fLastCachedTextMutex);
+        fLastCachedText = value->fKey.text();
         return true;
     } else {
         // We do not have to update the paragraph
@@ -352,11 +448,8 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
 #define NOCACHE_PREFIX_LENGTH 40
 bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
-        return false;
-    }
-
-    auto& lastText = fLastCachedValue->fKey.text();
+    SkAutoMutexExclusive lock(fLastCachedTextMutex);
+    auto& lastText = fLastCachedText;
     auto& text = paragraph->fText;
 
     if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
@@ -1,5 +1,6 @@
 // Copyright 2019 Google LLC.
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
@@ -21,6 +22,7 @@
 #include "modules/skparagraph/src/TextWrapper.h"
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTextBlobPriv.h"
 
 #include <algorithm>
@@ -156,20 +158,24 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
     }
 
     if (fState < kShaped) {
+        fShapedIncrementally = false;
         // Check if we have the text in the cache and don't need to shape it again
-        if (!fFontCollection->getParagraphCache()->findParagraph(this)) {
+        // (unless only a part of it was edited and the rest is already shaped)
+        if (fTextEdit || !fFontCollection->getParagraphCache()->findParagraph(this)) {
             if (fState < kIndexed) {
-                // This only happens once at the first layout; the text is immutable
-                // and there is no reason to repeat it
+                // This only happens at the first layout (and after updateText);
+                // there is no reason to repeat it
                 if (this->computeCodeUnitProperties()) {
                     fState = kIndexed;
                 }
             }
-            this->fRuns.clear();
             this->fClusters.clear();
             this->fClustersIndexFromCodeUnit.clear();
             this->fClustersIndexFromCodeUnit.push_back_n(fText.size() + 1, EMPTY_INDEX);
-            if (!this->shapeTextIntoEndlessLine()) {
+            fShapedIncrementally = this->reshapeEditedText();
+            if (fShapedIncrementally) {
+                // Only the edited text was shaped; the rest of the runs were reused
+            } else if (!this->shapeTextIntoEndlessLine()) {
                 this->resetContext();
                 // TODO: merge the two next calls - they always come together
                 this->resolveStrut();
@@ -554,6 +560,7 @@ void ParagraphImpl::buildClusterTable() {
 
 bool ParagraphImpl::shapeTextIntoEndlessLine() {
 
+    fRuns.clear();
     if (fText.size() == 0) {
         return false;
     }
@@ -1086,6 +1093,7 @@ void ParagraphImpl::updateFontSize(size_t from, size_t to, SkScalar fontSize) {
   }
 
   fState = std::min(fState, kIndexed);
+  fTextEdit.reset();
   fOldWidth = 0;
   fOldHeight = 0;
 }
@@ -1120,6 +1128,341 @@ void ParagraphImpl::updateBackgroundPaint(size_t from, size_t to, SkPaint paint)
     }
 }
 
+bool ParagraphImpl::updateText(size_t from, size_t to, const SkString& text) {
+    auto startsCodepoint = [this](size_t index) {
+        return index == fText.size() || (fText[index] & 0xC0) != 0x80;
+    };
+    if (from > to || to > fText.size() || !startsCodepoint(from) || !startsCodepoint(to)) {
+        return false;
+    }
+    for (auto& placeholder : fPlaceholders) {
+        auto range = placeholder.fRange;
+        if (range.width() > 0 && from < range.end && (to > range.start || from > range.start)) {
+            return false;
+        }
+    }
+
+    // Everything after the edit moves by the difference in length
+    const TextIndex newEnd = from + text.size();
+    const size_t newSize = fText.size() - (to - from) + text.size();
+    auto shift = [to, newEnd](TextIndex index) { return index - to + newEnd; };
+
+    // Cut the edited text out of the styled blocks; the new text takes the style before it
+    bool gapHasStyle = text.isEmpty();
+    TArray<Block, true> blocks;
+    for (auto& block : fTextStyles) {
+        bool before = block.fRange.start < from;
+        bool after = block.fRange.end > to;
+        if (before && after) {
+            blocks.emplace_back(block.fRange.start, shift(block.fRange.end), block.fStyle);
+            gapHasStyle = true;
+        } else if (before) {
+            blocks.emplace_back(block.fRange.start, std::min(block.fRange.end, from), block.fStyle);
+        } else if (after) {
+            blocks.emplace_back(shift(std::max(block.fRange.start, to)), shift(block.fRange.end),
+                                block.fStyle);
+        }
+    }
+    if (blocks.empty()) {
+        blocks.emplace_back(from, newEnd, fTextStyles.empty() ? fParagraphStyle.getTextStyle()
+                                                              : fTextStyles.front().fStyle);
+        gapHasStyle = true;
+    }
+    if (!gapHasStyle) {
+        Block* owner = nullptr;
+        for (auto& block : blocks) {
+            if (block.fRange.end == from && !block.fStyle.isPlaceholder()) {
+                owner = &block;
+                owner->fRange.end = newEnd;
+                break;
+            }
+        }
+        for (auto& block : blocks) {
+            if (owner == nullptr && block.fRange.start == newEnd && !block.fStyle.isPlaceholder()) {
+                owner = &block;
+                owner->fRange.start = from;
+            }
+        }
+        if (owner == nullptr) {
+            // The text would have to be squeezed between two placeholders
+            return false;
+        }
+    }
+
+    TArray<Placeholder, true> placeholders(fPlaceholders.size());
+    size_t blocksBefore = 0;
+    for (auto& placeholder : fPlaceholders) {
+        auto start = placeholder.fRange.start < from ? placeholder.fRange.start
+                                                     : shift(placeholder.fRange.start);
+        auto prev = placeholders.empty() ? nullptr : &placeholders.back();
+        auto& moved = placeholders.push_back(placeholder);
+        moved.fRange = TextRange(start, start + placeholder.fRange.width());
+        moved.fTextBefore = TextRange(prev == nullptr ? 0 : prev->fRange.end, start);
+        while (blocksBefore < SkToSizeT(blocks.size()) && blocks[blocksBefore].fRange.end <= start) {
+            ++blocksBefore;
+        }
+        moved.fBlocksBefore = BlockRange(prev == nullptr ? 0 : prev->fBlocksBefore.end + 1,
+                                         blocksBefore);
+    }
+
+    // If the last layout shaped the text without surprises we only need to reshape the text
+    // between the closest boundaries around the edit that are safe to shape from:
+    // a cluster after a whitespace in a left-to-right run, or the edge of any other run
+    std::optional<TextEdit> edit;
+    bool hasSpacing = false;
+    for (auto& block : fTextStyles) {
+        hasSpacing |= !SkScalarNearlyZero(block.fStyle.getLetterSpacing()) ||
+                      !SkScalarNearlyZero(block.fStyle.getWordSpacing());
+    }
+    if (fState >= kShaped && fUnresolvedGlyphs == 0 && !fRuns.empty() && !hasSpacing &&
+        !fText.isEmpty() && newSize > 0) {
+        auto runAt = [this](TextIndex index) -> const Run* {
+            for (auto& run : fRuns) {
+                if (run.fTextRange.start <= index && index < run.fTextRange.end) {
+                    return &run;
+                }
+            }
+            return nullptr;
+        };
+        auto isSafeStart = [this](TextIndex index) {
+            return this->codeUnitHasProperty(index - 1, SkUnicode::CodeUnitFlags::kPartOfWhiteSpaceBreak) &&
+                   this->codeUnitHasProperty(index, SkUnicode::CodeUnitFlags::kGlyphClusterStart) &&
+                   this->codeUnitHasProperty(index, SkUnicode::CodeUnitFlags::kGraphemeStart);
+        };
+
+        TextIndex start = 0;
+        const Run* first = from == 0 ? nullptr : runAt(from - 1);
+        if (first == nullptr) {
+            start = from == 0 ? 0 : EMPTY_INDEX;
+        } else if (first->isPlaceholder()) {
+            start = first->fTextRange.end;
+        } else if (!first->leftToRight()) {
+            start = first->fTextRange.start;
+        } else {
+            start = from;
+            while (start > first->fTextRange.start && !isSafeStart(start)) {
+                --start;
+            }
+        }
+
+        TextIndex end = fText.size();
+        const Run* last = to == fText.size() ? nullptr : runAt(to);
+        if (last == nullptr) {
+            end = to == fText.size() ? end : EMPTY_INDEX;
+        } else if (last->isPlaceholder() || last->fTextRange.start == to) {
+            end = to;
+        } else if (!last->leftToRight()) {
+            end = last->fTextRange.end;
+        } else {
+            end = to + 1;
+            while (end < last->fTextRange.end && !isSafeStart(end)) {
+                ++end;
+            }
+        }
+
+        if (start != EMPTY_INDEX && end != EMPTY_INDEX) {
+            edit = TextEdit{TextRange(start, end), shift(end)};
+        }
+    }
+
+    SkString newText(fText.c_str(), from);
+    newText.append(text);
+    newText.append(fText.c_str() + to, fText.size() - to);
+    fText = std::move(newText);
+    fTextStyles = std::move(blocks);
+    fPlaceholders = std::move(placeholders);
+    fTextEdit = edit;
+    if (!fTextEdit) {
+        fRuns.clear();
+    }
+
+    // Everything we know about the old text has to be computed again
+    fState = kUnknown;
+    fBidiRegions.clear();
+    fWords.clear();
+    fHasLineBreaks = false;
+    fHasWhitespacesInside = false;
+    fClusters.clear();
+    fClustersIndexFromCodeUnit.clear();
+    fLines.clear();
+    fPicture = nullptr;
+    if (!fUTF8IndexForUTF16Index.empty()) {
+        // The mapping has been filled once already and is not going to be filled again
+        extractUTF16Mapping(this->text(), &fUTF8IndexForUTF16Index, &fUTF16IndexForUTF8Index);
+    }
+    fOldWidth = 0;
+    fOldHeight = 0;
+
+    return true;
+}
+
+// Returns the first glyph of the cluster that starts at 'textIndex' in a left-to-right run
+static GlyphIndex find_cluster_glyph(const Run& run, TextIndex textIndex) {
+    for (GlyphIndex glyph = 0; glyph < run.size(); ++glyph) {
+        auto index = run.globalClusterIndex(glyph);
+        if (index >= textIndex) {
+            return index == textIndex ? glyph : EMPTY_INDEX;
+        }
+    }
+    return EMPTY_INDEX;
+}
+
+void ParagraphImpl::appendRunPiece(const Run& run,
+                                   GlyphRange glyphs,
+                                   TextIndex textStart,
+                                   SkScalar shiftX) {
+    const bool whole = glyphs.start == 0 && glyphs.end == run.size();
+    const TextRange text = whole ? run.fTextRange
+                                 : TextRange(run.globalClusterIndex(glyphs.start),
+                                             run.globalClusterIndex(glyphs.end));
+    const SkShaper::RunHandler::RunInfo info = {
+            run.fFont,
+            run.fBidiLevel,
+            whole ? run.fAdvance
+                  : SkVector::Make(run.posX(glyphs.end) - run.posX(glyphs.start), run.fAdvance.fY),
+            glyphs.width(),
+            SkShaper::RunHandler::Range(0, text.width())
+    };
+    auto& piece = fRuns.emplace_back(this,
+                                     info,
+                                     textStart,
+                                     run.fHeightMultiplier,
+                                     run.fUseHalfLeading,
+                                     run.fBaselineShift,
+                                     fRuns.size(),
+                                     (whole ? run.fOffset.fX : run.posX(glyphs.start)) + shiftX);
+
+    // Cluster indexes are relative to the start of the piece text now
+    const size_t base = text.start - run.fClusterStart;
+    for (size_t i = glyphs.start; i <= glyphs.end; ++i) {
+        auto index = i - glyphs.start;
+        if (i < glyphs.end) {
+            piece.fGlyphs[index] = run.fGlyphs[i];
+            piece.fClusterIndexes[index] = run.fClusterIndexes[i] - base;
+        }
+        piece.fPositions[index] = run.fPositions[i] + SkVector::Make(shiftX, 0);
+        piece.fOffsets[index] = run.fOffsets[i];
+    }
+    piece.fPlaceholderIndex = run.fPlaceholderIndex;
+}
+
+bool ParagraphImpl::reshapeEditedText() {
+    auto edit = std::exchange(fTextEdit, std::nullopt);
+    if (!edit || fState < kIndexed) {
+        return false;
+    }
+
+    const TextRange oldText = edit->fOldText;
+    const TextRange newText(oldText.start, edit->fNewEnd);
+    auto graphemeStart = [this](TextIndex index) {
+        return index == fText.size() ||
+               this->codeUnitHasProperty(index, SkUnicode::CodeUnitFlags::kGraphemeStart);
+    };
+    if (!graphemeStart(newText.start) || !graphemeStart(newText.end)) {
+        return false;
+    }
+
+    // Keep the runs before the edited text (cutting the last one if needed)
+    TArray<Run, false> oldRuns = std::move(fRuns);
+    fRuns.clear();
+    SkScalar advanceX = 0;
+    int runIndex = 0;
+    for (; runIndex < oldRuns.size(); ++runIndex) {
+        const Run& run = oldRuns[runIndex];
+        if (run.fTextRange.end <= oldText.start) {
+            auto& copy = fRuns.emplace_back(run);
+            copy.fIndex = fRuns.size() - 1;
+            copy.resetJustificationShifts();
+            advanceX = run.fOffset.fX + run.fAdvance.fX;
+            continue;
+        }
+        if (run.fTextRange.start < oldText.start) {
+            SkASSERT(run.leftToRight() && !run.isPlaceholder());
+            auto glyph = find_cluster_glyph(run, oldText.start);
+            if (glyph == EMPTY_INDEX) {
+                return false;
+            }
+            this->appendRunPiece(run, GlyphRange(0, glyph), run.fTextRange.start, 0);
+            advanceX = run.posX(glyph);
+        }
+        break;
+    }
+
+    // Shape the edited text
+    fUnresolvedCodepoints.clear();
+    OneLineShaper oneLineShaper(this);
+    if (newText.width() > 0 && !oneLineShaper.shape(newText, advanceX)) {
+        return false;
+    }
+    fUnresolvedGlyphs = oneLineShaper.unresolvedGlyphs();
+
+    // Move the runs after the edited text (cutting the first one if needed) so they start where
+    // the edited text ends now, as if the whole text had been shaped again
+    const TextIndex oldEnd = oldText.end;
+    const TextIndex newEnd = newText.end;
+    std::optional<SkScalar> shiftX;
+    for (; runIndex < oldRuns.size(); ++runIndex) {
+        const Run& run = oldRuns[runIndex];
+        if (run.fTextRange.end <= oldEnd) {
+            continue;
+        }
+        if (run.fTextRange.start < oldEnd) {
+            SkASSERT(run.leftToRight() && !run.isPlaceholder());
+            auto glyph = find_cluster_glyph(run, oldEnd);
+            if (glyph == EMPTY_INDEX) {
+                return false;
+            }
+            shiftX = advanceX - run.posX(glyph);
+            this->appendRunPiece(run, GlyphRange(glyph, run.size()), newEnd, *shiftX);
+            continue;
+        }
+        if (!shiftX) {
+            shiftX = advanceX - run.fOffset.fX;
+        }
+        if (run.fClusterStart >= oldEnd && *shiftX == 0) {
+            // Share the glyphs, just move the text
+            auto& copy = fRuns.emplace_back(run);
+            copy.fIndex = fRuns.size() - 1;
+            copy.resetJustificationShifts();
+            copy.fTextRange = TextRange(run.fTextRange.start - oldEnd + newEnd,
+                                        run.fTextRange.end - oldEnd + newEnd);
+            copy.fClusterStart = run.fClusterStart - oldEnd + newEnd;
+        } else {
+            // The glyph positions are shared with the old run, so they have to be copied to move
+            this->appendRunPiece(run, GlyphRange(0, run.size()),
+                                 run.fTextRange.start - oldEnd + newEnd, *shiftX);
+        }
+    }
+
+    // The bidi levels of the text around the edit may have changed
+    size_t bidiIndex = 0;
+    for (auto& run : fRuns) {
+        if (run.isPlaceholder()) {
+            continue;
+        }
+        while (bidiIndex < fBidiRegions.size() &&
+               fBidiRegions[bidiIndex].end <= run.fTextRange.start) {
+            ++bidiIndex;
+        }
+        if (bidiIndex == fBidiRegions.size() ||
+            fBidiRegions[bidiIndex].start > run.fTextRange.start ||
+            fBidiRegions[bidiIndex].end < run.fTextRange.end ||
+            fBidiRegions[bidiIndex].level != run.fBidiLevel) {
+            return false;
+        }
+    }
+
+    fFontSwitches.clear();
+    for (auto& run : fRuns) {
+        if (!run.isPlaceholder()) {
+            fFontSwitches.emplace_back(run.fTextRange.start, run.fFont);
+        }
+    }
+
+    this->applySpacingAndBuildClusterTable();
+    return true;
+}
+
 TArray<TextIndex> ParagraphImpl::countSurroundingGraphemes(TextRange textRange) const {
     textRange = textRange.intersection({0, fText.size()});
     TArray<TextIndex> graphemes;
@@ -1167,12 +1510,32 @@ TextIndex ParagraphImpl::findPreviousGlyphClusterBoundary(TextIndex utf8) const
     return utf8;
 }
 
+void extractUTF16Mapping(SkSpan<const char> text,
+                         TArray<TextIndex, true>* utf8IndexForUTF16Index,
+                         TArray<TextIndex, true>* utf16IndexForUTF8Index) {
+    // The UTF-16 text is never longer than the UTF-8 one, so both maps fit in text.size() + 1
+    utf8IndexForUTF16Index->resize_back(SkToInt(text.size() + 1));
+    utf16IndexForUTF8Index->resize_back(SkToInt(text.size() + 1));
+    int utf16Units = SkUTF::UTF8ToUTF16Indices(text.data(), text.size(),
+                                               utf8IndexForUTF16Index->data(),
+                                               utf16IndexForUTF8Index->data());
+    if (utf16Units >= 0) {
+        utf8IndexForUTF16Index->resize_back(utf16Units + 1);
+        return;
+    }
+
+    // Invalid UTF-8 is mapped the way SkUnicode always did
+    utf8IndexForUTF16Index->clear();
+    utf16IndexForUTF8Index->clear();
+    SkUnicode::extractUtfConversionMapping(
+            text,
+            [&](size_t index) { utf8IndexForUTF16Index->emplace_back(index); },
+            [&](size_t index) { utf16IndexForUTF8Index->emplace_back(index); });
+}
+
 void ParagraphImpl::ensureUTF16Mapping() {
     fillUTF16MappingOnce([&] {
-        SkUnicode::extractUtfConversionMapping(
-                this->text(),
-                [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
-                [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+        extractUTF16Mapping(this->text(), &fUTF8IndexForUTF16Index, &fUTF16IndexForUTF8Index);
     });
 }
 
@@ -1501,6 +1864,24 @@ int ParagraphImpl::getPath(int lineNumber, SkPath* dest) {
     return notConverted;
 }
 
+void Paragraph::LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkSpan<const SkScalar> widths,
+                          SkExecutor* executor) {
+    SkASSERT(paragraphs.size() == widths.size());
+    if (!executor || paragraphs.size() < 2) {
+        for (size_t i = 0; i < paragraphs.size(); ++i) {
+            paragraphs[i]->layout(widths[i]);
+        }
+        return;
+    }
+    // Paragraphs only share their font collection, whose caches are thread-safe
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(SkToInt(paragraphs.size()), [&](int i) {
+        paragraphs[i]->layout(widths[i]);
+    });
+    taskGroup.wait();
+}
+
 SkPath Paragraph::GetPath(SkTextBlob* textBlob) {
     SkPath path;
     SkTextBlobRunIterator iter(textBlob);
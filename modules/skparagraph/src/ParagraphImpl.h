@@ -29,6 +29,7 @@
 #include "src/core/SkTHash.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -68,6 +69,11 @@ struct ResolvedFontDescriptor {
     TextIndex fTextStart;
 };
 
+// Fills the maps between the UTF-8 indices of 'text' and the UTF-16 ones (see SkUTF::UTF8ToUTF16Indices)
+void extractUTF16Mapping(SkSpan<const char> text,
+                         skia_private::TArray<TextIndex, true>* utf8IndexForUTF16Index,
+                         skia_private::TArray<TextIndex, true>* utf16IndexForUTF8Index);
+
 enum InternalState {
   kUnknown = 0,
   kIndexed = 1,     // Text is indexed
@@ -128,6 +134,8 @@ public:
 
     SkSpan<const char> text() const { return SkSpan<const char>(fText.c_str(), fText.size()); }
     InternalState state() const { return fState; }
+    // Whether the last shaping only reshaped the text around an edit made by updateText()
+    bool shapedIncrementally() const { return fShapedIncrementally; }
     SkSpan<Run> runs() { return SkSpan<Run>(fRuns.data(), fRuns.size()); }
     SkSpan<Block> styles() {
         return SkSpan<Block>(fTextStyles.data(), fTextStyles.size());
@@ -183,6 +191,7 @@ public:
         if (fState > kIndexed) {
             fState = kIndexed;
         }
+        fTextEdit.reset();
     }
 
     int32_t unresolvedGlyphs() override;
@@ -207,6 +216,7 @@ public:
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
+    bool updateText(size_t from, size_t to, const SkString& text) override;
 
     void visit(const Visitor&) override;
     void extendedVisit(const ExtendedVisitor&) override;
@@ -257,6 +267,9 @@ private:
 
     void computeEmptyMetrics();
 
+    bool reshapeEditedText();
+    void appendRunPiece(const Run& run, GlyphRange glyphs, TextIndex textStart, SkScalar shiftX);
+
     // Input
     skia_private::TArray<StyleBlock<SkScalar>> fLetterSpaceStyles;
     skia_private::TArray<StyleBlock<SkScalar>> fWordSpaceStyles;
@@ -300,6 +313,14 @@ private:
     bool fHasLineBreaks;
     bool fHasWhitespacesInside;
     TextIndex fTrailingSpaces;
+
+    // Set by updateText() when the runs from the last layout can be reused by the next one
+    struct TextEdit {
+        TextRange fOldText;  // The text to reshape, as it was before the edit
+        TextIndex fNewEnd;   // The end of that text after the edit
+    };
+    std::optional<TextEdit> fTextEdit;
+    bool fShapedIncrementally = false;
 };
 }  // namespace textlayout
 }  // namespace skia
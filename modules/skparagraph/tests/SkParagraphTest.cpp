@@ -7,6 +7,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkPaint.h"
@@ -37,6 +38,7 @@
 #include "modules/skparagraph/utils/TestFontCollection.h"
 #include "modules/skshaper/utils/FactoryHelpers.h"
 #include "src/base/SkTSort.h"
+#include "src/base/SkUTF.h"
 #include "src/core/SkOSFile.h"
 #include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
@@ -52,6 +54,7 @@
 #include <utility>
 #include <vector>
 #include <thread>
+#include <tuple>
 
 #include "modules/skunicode/include/SkUnicode.h"
 
@@ -6417,6 +6420,62 @@ UNIX_ONLY_TEST(SkParagraph_NoCache1, reporter) {
     test("different strings", "0123456789 0123456789 0123456789 0123456789 0123456789", false);
 }
 
+// This test does not produce an image
+UNIX_ONLY_TEST(SkParagraph_CacheByteLimit, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>(true);
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    auto cache = fontCollection->getParagraphCache();
+    cache->reset();
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(14);
+    text_style.setColor(SK_ColorBLACK);
+
+    auto layout = [&](const SkString& text, SkScalar width) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        auto paragraph = builder.Build();
+        paragraph->layout(width);
+        return paragraph;
+    };
+
+    // Short different texts so none of them looks like editing the previous one
+    auto text = [](int i) {
+        SkString text;
+        text.printf("%d: Sphinx of black quartz", i);
+        return text;
+    };
+
+    for (int i = 0; i < 32; ++i) {
+        layout(text(i), 300);
+    }
+    REPORTER_ASSERT(reporter, cache->count() == 32);
+    REPORTER_ASSERT(reporter, cache->getBytesUsed() > 0);
+    REPORTER_ASSERT(reporter, cache->getBytesUsed() <= cache->getByteLimit());
+
+    // A paragraph found in the cache is only broken into lines at its new width
+    auto cached = layout(text(0), 100);
+    auto impl = static_cast<ParagraphImpl*>(cached.get());
+    REPORTER_ASSERT(reporter, cache->count() == 32);
+    REPORTER_ASSERT(reporter, impl->lines().size() > 1);
+
+    // Shrinking the limit evicts the least recently used paragraphs
+    auto prevLimit = cache->setByteLimit(cache->getBytesUsed() / 2);
+    REPORTER_ASSERT(reporter, prevLimit == ParagraphCache::kDefaultByteLimit);
+    REPORTER_ASSERT(reporter, cache->count() < 32);
+    REPORTER_ASSERT(reporter, cache->getBytesUsed() <= cache->getByteLimit());
+
+    cache->setByteLimit(0);
+    REPORTER_ASSERT(reporter, cache->count() == 0);
+    layout(text(100), 300);
+    REPORTER_ASSERT(reporter, cache->count() == 0);
+    cache->setByteLimit(prevLimit);
+}
+
 UNIX_ONLY_TEST(SkParagraph_HeightCalculations, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
     SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
@@ -7486,6 +7545,322 @@ UNIX_ONLY_TEST(SkParagraph_GetRectsForRangeConcurrently, reporter) {
     }
 }
 
+UNIX_ONLY_TEST(SkParagraph_LayoutAllConcurrently, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraphStyle;
+    TextStyle textStyle;
+    textStyle.setFontFamilies({SkString("Roboto")});
+    textStyle.setFontSize(14);
+    textStyle.setColor(SK_ColorBLACK);
+
+    const int count = 32;
+    auto build = [&](int i) {
+        ParagraphBuilderImpl builder(paragraphStyle, fontCollection, get_unicode());
+        builder.pushStyle(textStyle);
+        SkString text;
+        text.printf("Paragraph %d: the quick brown fox jumps over the lazy dog", i);
+        for (int j = 0; j < i % 5; ++j) {
+            text.append(" and then over the lazy dog again");
+        }
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    std::vector<std::unique_ptr<Paragraph>> expected;
+    std::vector<std::unique_ptr<Paragraph>> paragraphs;
+    std::vector<Paragraph*> paragraphPtrs;
+    std::vector<SkScalar> widths;
+    for (int i = 0; i < count; ++i) {
+        expected.push_back(build(i));
+        paragraphs.push_back(build(i));
+        paragraphPtrs.push_back(paragraphs.back().get());
+        widths.push_back(100 + 10 * i);
+    }
+    // Start with a cold cache so that the paragraphs are shaped concurrently
+    fontCollection->clearCaches();
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    Paragraph::LayoutAll(paragraphPtrs, widths, executor.get());
+
+    for (int i = 0; i < count; ++i) {
+        expected[i]->layout(widths[i]);
+        REPORTER_ASSERT(reporter, paragraphs[i]->getHeight() == expected[i]->getHeight());
+        REPORTER_ASSERT(reporter, paragraphs[i]->getLongestLine() == expected[i]->getLongestLine());
+        REPORTER_ASSERT(reporter, paragraphs[i]->lineNumber() == expected[i]->lineNumber());
+    }
+}
+
+// Checks that 'paragraph' is laid out like 'expected', as far as the public API can tell
+static void check_same_layout(skiatest::Reporter* reporter,
+                              const char* name,
+                              Paragraph* paragraph,
+                              Paragraph* expected,
+                              unsigned utf16Size) {
+    REPORTER_ASSERT(reporter, paragraph->lineNumber() == expected->lineNumber(), "%s", name);
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getHeight(), expected->getHeight()),
+                    "%s", name);
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getLongestLine(),
+                                                  expected->getLongestLine()), "%s", name);
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getMaxIntrinsicWidth(),
+                                                  expected->getMaxIntrinsicWidth()), "%s", name);
+
+    auto checkRects = [&](unsigned start, unsigned end) {
+        auto boxes = paragraph->getRectsForRange(start, end, RectHeightStyle::kTight,
+                                                 RectWidthStyle::kTight);
+        auto expectedBoxes = expected->getRectsForRange(start, end, RectHeightStyle::kTight,
+                                                        RectWidthStyle::kTight);
+        REPORTER_ASSERT(reporter, boxes.size() == expectedBoxes.size(),
+                        "%s: [%u:%u) %zu boxes instead of %zu",
+                        name, start, end, boxes.size(), expectedBoxes.size());
+        for (size_t i = 0; i < std::min(boxes.size(), expectedBoxes.size()); ++i) {
+            const SkRect& rect = boxes[i].rect;
+            const SkRect& expectedRect = expectedBoxes[i].rect;
+            REPORTER_ASSERT(reporter,
+                            SkScalarNearlyEqual(rect.fLeft, expectedRect.fLeft, EPSILON100) &&
+                            SkScalarNearlyEqual(rect.fTop, expectedRect.fTop, EPSILON100) &&
+                            SkScalarNearlyEqual(rect.fRight, expectedRect.fRight, EPSILON100) &&
+                            SkScalarNearlyEqual(rect.fBottom, expectedRect.fBottom, EPSILON100) &&
+                            boxes[i].direction == expectedBoxes[i].direction,
+                            "%s: [%u:%u) box %zu is (%f %f %f %f) instead of (%f %f %f %f)",
+                            name, start, end, i,
+                            rect.fLeft, rect.fTop, rect.fRight, rect.fBottom,
+                            expectedRect.fLeft, expectedRect.fTop,
+                            expectedRect.fRight, expectedRect.fBottom);
+        }
+    };
+    checkRects(0, utf16Size);
+    for (unsigned start = 0; start < utf16Size; ++start) {
+        checkRects(start, start + 1);
+        checkRects(start, start + 5);
+    }
+
+    for (SkScalar y = -5; y < expected->getHeight() + 10; y += 7) {
+        for (SkScalar x = -5; x < expected->getMaxWidth() + 10; x += 3) {
+            auto position = paragraph->getGlyphPositionAtCoordinate(x, y);
+            auto expectedPosition = expected->getGlyphPositionAtCoordinate(x, y);
+            REPORTER_ASSERT(reporter, position.position == expectedPosition.position &&
+                                      position.affinity == expectedPosition.affinity,
+                            "%s: (%f, %f) hits %d instead of %d",
+                            name, x, y, position.position, expectedPosition.position);
+        }
+    }
+
+    // The runs can be split differently, so compare the glyphs of each line in text order
+    struct VisitedGlyph {
+        int fLine;
+        uint32_t fUtf8Start;
+        SkGlyphID fGlyph;
+        SkPoint fPosition;
+    };
+    auto visitGlyphs = [](Paragraph* visited) {
+        std::vector<VisitedGlyph> glyphs;
+        visited->visit([&](int lineNumber, const Paragraph::VisitorInfo* info) {
+            if (info == nullptr) {
+                return;
+            }
+            for (int i = 0; i < info->count; ++i) {
+                glyphs.push_back({lineNumber, info->utf8Starts[i], info->glyphs[i],
+                                  info->origin + info->positions[i]});
+            }
+        });
+        std::stable_sort(glyphs.begin(), glyphs.end(),
+                         [](const VisitedGlyph& a, const VisitedGlyph& b) {
+            return std::tie(a.fLine, a.fUtf8Start) < std::tie(b.fLine, b.fUtf8Start);
+        });
+        return glyphs;
+    };
+    auto glyphs = visitGlyphs(paragraph);
+    auto expectedGlyphs = visitGlyphs(expected);
+    REPORTER_ASSERT(reporter, glyphs.size() == expectedGlyphs.size(),
+                    "%s: %zu glyphs instead of %zu", name, glyphs.size(), expectedGlyphs.size());
+    for (size_t i = 0; i < std::min(glyphs.size(), expectedGlyphs.size()); ++i) {
+        const VisitedGlyph& glyph = glyphs[i];
+        const VisitedGlyph& expectedGlyph = expectedGlyphs[i];
+        REPORTER_ASSERT(reporter,
+                        glyph.fLine == expectedGlyph.fLine &&
+                        glyph.fUtf8Start == expectedGlyph.fUtf8Start &&
+                        glyph.fGlyph == expectedGlyph.fGlyph &&
+                        SkScalarNearlyEqual(glyph.fPosition.fX, expectedGlyph.fPosition.fX,
+                                            EPSILON100) &&
+                        SkScalarNearlyEqual(glyph.fPosition.fY, expectedGlyph.fPosition.fY,
+                                            EPSILON100),
+                        "%s: glyph %zu (line %d, text %u) is %hu at (%f, %f) instead of "
+                        "%hu at (%f, %f) (line %d, text %u)",
+                        name, i, glyph.fLine, glyph.fUtf8Start,
+                        glyph.fGlyph, glyph.fPosition.fX, glyph.fPosition.fY,
+                        expectedGlyph.fGlyph, expectedGlyph.fPosition.fX, expectedGlyph.fPosition.fY,
+                        expectedGlyph.fLine, expectedGlyph.fUtf8Start);
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_UpdateText, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->disableFontFallback();
+
+    TextStyle textStyle;
+    textStyle.setFontFamilies({SkString("Roboto")});
+    textStyle.setFontSize(20);
+    textStyle.setColor(SK_ColorBLACK);
+
+    TextStyle bigStyle = textStyle;
+    bigStyle.setFontSize(28);
+    bigStyle.setColor(SK_ColorBLUE);
+
+    TextStyle arabicStyle = textStyle;
+    arabicStyle.setFontFamilies({SkString("Noto Naskh Arabic"), SkString("Roboto")});
+
+    PlaceholderStyle placeholderStyle(40, 30, PlaceholderAlignment::kBaseline,
+                                      TextBaseline::kAlphabetic, 0);
+
+    // The paragraphs are described by their pieces of styled text (or placeholders, which have no
+    // style), so they can be built again from scratch after every edit
+    struct Piece {
+        std::string fText;
+        const TextStyle* fStyle;
+    };
+    const std::string kPlaceholderText = "\xEF\xBF\xBC";  // U+FFFC added by addPlaceholder()
+
+    auto build = [&](const ParagraphStyle& paragraphStyle, const std::vector<Piece>& pieces) {
+        ParagraphBuilderImpl builder(paragraphStyle, fontCollection, get_unicode());
+        builder.pushStyle(textStyle);
+        for (auto& piece : pieces) {
+            if (piece.fStyle == nullptr) {
+                builder.addPlaceholder(placeholderStyle);
+                continue;
+            }
+            builder.pushStyle(*piece.fStyle);
+            builder.addText(piece.fText.c_str(), piece.fText.size());
+            builder.pop();
+        }
+        builder.pop();
+        return builder.Build();
+    };
+
+    // Like updateText(), the new text takes the style of the text before it (or after it, if it
+    // follows a placeholder). The edits in this test stay within one piece of text.
+    auto applyEdit = [](std::vector<Piece>& pieces, size_t from, size_t to, const char* text) {
+        size_t start = 0;
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            Piece& piece = pieces[i];
+            size_t end = start + piece.fText.size();
+            bool afterText = i > 0 && pieces[i - 1].fStyle != nullptr;
+            if (piece.fStyle != nullptr && to <= end &&
+                (from > start || (from == start && !afterText))) {
+                piece.fText.replace(from - start, to - from, text);
+                return;
+            }
+            start = end;
+        }
+        SkASSERT(false);
+    };
+
+    struct Edit {
+        size_t fFrom;
+        size_t fTo;  // SIZE_MAX for the end of the text
+        const char* fText;
+        bool fIncremental;  // Whether the edit must only reshape the text around it
+    };
+    auto testEdits = [&](const char* name,
+                         const ParagraphStyle& paragraphStyle,
+                         std::vector<Piece> pieces,
+                         SkSpan<const Edit> edits) {
+        const SkScalar width = 200;
+        auto paragraph = build(paragraphStyle, pieces);
+        paragraph->layout(width);
+        auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+
+        for (auto& edit : edits) {
+            auto to = std::min(edit.fTo, impl->text().size());
+            auto from = std::min(edit.fFrom, to);
+            REPORTER_ASSERT(reporter, paragraph->updateText(from, to, SkString(edit.fText)),
+                            "%s: [%zu:%zu)", name, from, to);
+            applyEdit(pieces, from, to, edit.fText);
+            paragraph->layout(width);
+            REPORTER_ASSERT(reporter, !edit.fIncremental || impl->shapedIncrementally(),
+                            "%s: [%zu:%zu) was not reshaped incrementally", name, from, to);
+
+            std::string text;
+            for (auto& piece : pieces) {
+                text += piece.fStyle != nullptr ? piece.fText : kPlaceholderText;
+            }
+            REPORTER_ASSERT(reporter, std::string(impl->text().data(), impl->text().size()) == text,
+                            "%s", name);
+
+            auto expected = build(paragraphStyle, pieces);
+            expected->layout(width);
+            check_same_layout(reporter, name, paragraph.get(), expected.get(),
+                              SkUTF::CountUTF8(text.data(), text.size()));
+        }
+        return paragraph;
+    };
+
+    ParagraphStyle paragraphStyle;
+
+    const Edit kPlainEdits[] = {
+        {10, 10, "red ", true},                   // Insert a word
+        {4, 9, "slow", true},                     // Replace a word
+        {20, 21, "", true},                       // Delete a character
+        {0, 0, "Oh! ", true},                     // Insert at the start
+        {SIZE_MAX, SIZE_MAX, " The end.", true},  // Insert at the end
+        {30, 50, "\n", false},                    // Replace a few words with a hard line break
+    };
+    auto paragraph = testEdits(
+            "plain", paragraphStyle,
+            {{"The quick brown fox jumps over the lazy dog. The quick brown fox jumps again.",
+              &textStyle}},
+            kPlainEdits);
+
+    // Invalid edits leave the paragraph alone
+    REPORTER_ASSERT(reporter, !paragraph->updateText(5, 4, SkString("x")));
+    REPORTER_ASSERT(reporter, !paragraph->updateText(0, 1000, SkString("x")));
+    ParagraphBuilderImpl multibyteBuilder(paragraphStyle, fontCollection, get_unicode());
+    multibyteBuilder.pushStyle(textStyle);
+    multibyteBuilder.addText("café");
+    REPORTER_ASSERT(reporter, !multibyteBuilder.Build()->updateText(4, 4, SkString("x")));
+
+    const Edit kStyledEdits[] = {
+        {10, 10, "dark ", true},  // At the end of the first style
+        {17, 20, "ow", true},     // Inside the second style
+        {24, 24, "!", true},      // At the end of the second style
+        {30, 35, "", true},       // Inside the third style
+    };
+    testEdits("styled", paragraphStyle,
+              {{"The quick ", &textStyle},
+               {"brown fox ", &bigStyle},
+               {"jumps over the lazy dog.", &textStyle}},
+              kStyledEdits);
+
+    const Edit kPlaceholderEdits[] = {
+        {6, 11, "there", true},  // Before the placeholder
+        {12, 12, "big ", true},  // Right before the placeholder
+        {19, 19, "X", true},     // Right after the placeholder
+        {25, 29, "", true},      // After the placeholder
+    };
+    paragraph = testEdits("placeholder", paragraphStyle,
+                          {{"Hello world ", &textStyle},
+                           {kPlaceholderText, nullptr},
+                           {" and more text after it", &textStyle}},
+                          kPlaceholderEdits);
+    // The placeholder is at [16:19) now
+    REPORTER_ASSERT(reporter, !paragraph->updateText(17, 18, SkString("x")));
+    REPORTER_ASSERT(reporter, !paragraph->updateText(10, 17, SkString("x")));
+
+    ParagraphStyle rtlParagraphStyle;
+    rtlParagraphStyle.setTextDirection(TextDirection::kRtl);
+    const Edit kRtlEdits[] = {
+        {15, 15, "جديد ", true},  // Insert a word in a right-to-left run
+        {60, 65, "slow", true},   // Replace a word in a left-to-right run
+        {78, 82, "كتاب", true},   // Replace the last word
+        {0, 0, "abc ", false},    // Insert left-to-right text at the start
+    };
+    testEdits("rtl", rtlParagraphStyle,
+              {{"بمباركة التقليدية قام عن. The quick fox تصفح يد", &arabicStyle}},
+              kRtlEdits);
+}
+
 UNIX_ONLY_TEST(SkParagraph_TabSubstitution, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>(true);
     SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
@@ -118,6 +118,7 @@ private:
 
     sk_sp<SkImage> generateFrame(float t);
 
+    SkMutex                            fMutex;
     std::unique_ptr<SkAnimCodecPlayer> fPlayer;
     sk_sp<SkImage>                     fCachedFrame;
     ImageDecodeStrategy fStrategy;
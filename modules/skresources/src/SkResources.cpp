@@ -173,6 +173,9 @@ sk_sp<SkImage> MultiFrameImageAsset::generateFrame(float t) {
 }
 
 sk_sp<SkImage> MultiFrameImageAsset::getFrame(float t) {
+    // Assets may be shared by animation instances on different threads.
+    SkAutoMutexExclusive amx(fMutex);
+
     // For static images we can reuse the cached frame
     // (which includes the optional pre-decode step).
     if (!fCachedFrame || this->isMultiFrame()) {
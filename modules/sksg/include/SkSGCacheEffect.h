@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGCacheEffect_DEFINED
+#define SkSGCacheEffect_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "modules/sksg/include/SkSGEffectNode.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+class SkCanvas;
+class SkImage;
+class SkPicture;
+
+namespace sksg {
+class InvalidationController;
+
+/**
+ * Opt-in render cache for static sub-DAGs.
+ *
+ * The child content is snapshotted (into an SkPicture or a raster SkImage), and replayed until
+ * the child is invalidated.  Snapshots are only taken once the content has been rendered
+ * unchanged twice in a row, so frequently changing sub-DAGs are not cached.
+ *
+ * Cached content is composited as a unit: paint overrides from ancestor effects (opacity, color
+ * filters, etc) are applied to it as a group.
+ *
+ * All cached content is accounted against a process-wide byte budget.  Content which doesn't fit
+ * the budget is rendered uncached.
+ */
+class CacheEffect final : public EffectNode {
+public:
+    enum class Mode {
+        kPicture, // Records the content into an SkPicture (resolution independent).
+        kRaster,  // Rasterizes the content at device resolution.  Remains valid for integer
+                  // translations of the CTM, and is re-rasterized for any other CTM change.
+    };
+
+    static sk_sp<CacheEffect> Make(sk_sp<RenderNode> child, Mode mode = Mode::kRaster) {
+        return child ? sk_sp<CacheEffect>(new CacheEffect(std::move(child), mode)) : nullptr;
+    }
+
+    ~CacheEffect() override;
+
+    inline static constexpr size_t kDefaultByteLimit = 32 * 1024 * 1024;
+
+    // Sets the process-wide budget for cached content.  Returns the previous limit.
+    // Lowering the limit doesn't purge existing snapshots; it only prevents new ones.
+    static size_t SetByteLimit(size_t);
+    static size_t GetByteLimit();
+
+    struct Stats {
+        uint64_t fHits;      // renders served from a snapshot
+        uint64_t fMisses;    // renders of the uncached content
+        size_t   fBytesUsed; // size of all current snapshots
+    };
+    static Stats GetStats();
+
+protected:
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    CacheEffect(sk_sp<RenderNode>, Mode);
+
+    bool isCompatible(const SkMatrix& ctm, const SkMatrix& cached_ctm) const;
+    bool snapshot(SkCanvas*, const SkMatrix& ctm) const;
+    void purge() const;
+
+    const Mode fMode;
+
+    // Rendering doesn't change the observable node state: snapshots are mutable.
+    mutable sk_sp<SkPicture> fPicture;
+    mutable sk_sp<SkImage>   fImage;
+    mutable SkIPoint         fImageOrigin = {0, 0}; // device space, for fSnapshotCTM
+    mutable SkMatrix         fSnapshotCTM;
+    mutable SkMatrix         fLastCTM;
+    mutable size_t           fSnapshotBytes = 0;
+    mutable bool             fRenderedSinceInval = false;
+
+    using INHERITED = EffectNode;
+};
+
+} // namespace sksg
+
+#endif // SkSGCacheEffect_DEFINED
@@ -34,6 +34,17 @@ public:
     auto begin() const { return fRects.cbegin(); }
     auto   end() const { return fRects.cend();   }
 
+    // Returns the damage rects, merged to trade overdraw for fewer rects (and cheaper clipping):
+    //
+    //   - two rects are merged when their bounding rect repaints at most |mergeSlack| extra area,
+    //     relative to the damaged area they cover (e.g. 0.25 allows 25% of extra repaint);
+    //     merges which don't repaint anything extra (nested, or aligned adjacent/overlapping
+    //     rects) always happen
+    //
+    //   - rects are merged unconditionally (cheapest merges first), until at most |maxRects|
+    //     remain
+    std::vector<SkRect> mergedRects(size_t maxRects, float mergeSlack = 0) const;
+
     void reset();
 
 private:
@@ -36,7 +36,8 @@ protected:
     struct RenderContext;
 
 public:
-    // Render the node and its descendants to the canvas.
+    // Render the node and its descendants to the canvas.  Nodes whose bounds fall outside the
+    // canvas clip are skipped.
     void render(SkCanvas*, const RenderContext* = nullptr) const;
 
     // Perform a front-to-back hit-test, and return the RenderNode located at |point|.
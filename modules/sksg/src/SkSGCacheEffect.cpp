@@ -0,0 +1,212 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGCacheEffect.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSurface.h"
+#include "include/private/base/SkAssert.h"
+
+#include <atomic>
+#include <cmath>
+
+namespace sksg {
+
+namespace {
+
+std::atomic<size_t>   gByteLimit{CacheEffect::kDefaultByteLimit};
+std::atomic<size_t>   gBytesUsed{0};
+std::atomic<uint64_t> gHits{0};
+std::atomic<uint64_t> gMisses{0};
+
+bool reserve_bytes(size_t bytes) {
+    const size_t limit = gByteLimit.load(std::memory_order_relaxed);
+
+    size_t used = gBytesUsed.load(std::memory_order_relaxed);
+    do {
+        if (used > limit || bytes > limit - used) {
+            return false;
+        }
+    } while (!gBytesUsed.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+    return true;
+}
+
+void release_bytes(size_t bytes) {
+    SkASSERT(gBytesUsed.load(std::memory_order_relaxed) >= bytes);
+    gBytesUsed.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+bool is_integer(float v) {
+    return v == std::floor(v);
+}
+
+} // namespace
+
+size_t CacheEffect::SetByteLimit(size_t bytes) {
+    return gByteLimit.exchange(bytes, std::memory_order_relaxed);
+}
+
+size_t CacheEffect::GetByteLimit() {
+    return gByteLimit.load(std::memory_order_relaxed);
+}
+
+CacheEffect::Stats CacheEffect::GetStats() {
+    return {
+        gHits.load(std::memory_order_relaxed),
+        gMisses.load(std::memory_order_relaxed),
+        gBytesUsed.load(std::memory_order_relaxed),
+    };
+}
+
+CacheEffect::CacheEffect(sk_sp<RenderNode> child, Mode mode)
+    : INHERITED(std::move(child))
+    , fMode(mode) {}
+
+CacheEffect::~CacheEffect() {
+    this->purge();
+}
+
+void CacheEffect::purge() const {
+    fPicture.reset();
+    fImage.reset();
+    release_bytes(fSnapshotBytes);
+    fSnapshotBytes = 0;
+}
+
+bool CacheEffect::isCompatible(const SkMatrix& ctm, const SkMatrix& cached_ctm) const {
+    if (fMode == Mode::kPicture) {
+        return true;
+    }
+
+    // Raster snapshots can be reused for integer translations.
+    return !ctm.hasPerspective()
+        && ctm.getScaleX() == cached_ctm.getScaleX()
+        && ctm.getSkewX()  == cached_ctm.getSkewX()
+        && ctm.getSkewY()  == cached_ctm.getSkewY()
+        && ctm.getScaleY() == cached_ctm.getScaleY()
+        && is_integer(ctm.getTranslateX() - cached_ctm.getTranslateX())
+        && is_integer(ctm.getTranslateY() - cached_ctm.getTranslateY());
+}
+
+bool CacheEffect::snapshot(SkCanvas* canvas, const SkMatrix& ctm) const {
+    SkASSERT(!fPicture && !fImage && !fSnapshotBytes);
+
+    if (fMode == Mode::kPicture) {
+        SkPictureRecorder recorder;
+        this->INHERITED::onRender(recorder.beginRecording(this->bounds()), nullptr);
+        auto picture = recorder.finishRecordingAsPicture();
+
+        const auto bytes = picture ? picture->approximateBytesUsed() : 0;
+        if (!picture || !reserve_bytes(bytes)) {
+            return false;
+        }
+
+        fPicture       = std::move(picture);
+        fSnapshotBytes = bytes;
+        fSnapshotCTM   = ctm;
+        return true;
+    }
+
+    if (ctm.hasPerspective()) {
+        return false;
+    }
+
+    const auto dev_bounds = ctm.mapRect(this->bounds()).roundOut();
+    const auto info = SkImageInfo::MakeN32Premul(dev_bounds.width(), dev_bounds.height(),
+                                                 canvas->imageInfo().refColorSpace());
+    const auto bytes = info.computeMinByteSize();
+    if (info.isEmpty() || SkImageInfo::ByteSizeOverflowed(bytes) || !reserve_bytes(bytes)) {
+        return false;
+    }
+
+    // Prefer a surface compatible with the destination (e.g. GPU-backed).
+    auto surface = canvas->makeSurface(info);
+    if (!surface) {
+        surface = SkSurfaces::Raster(info);
+    }
+    if (!surface) {
+        release_bytes(bytes);
+        return false;
+    }
+
+    auto* snapshot_canvas = surface->getCanvas();
+    snapshot_canvas->translate(-dev_bounds.x(), -dev_bounds.y());
+    snapshot_canvas->concat(ctm);
+    this->INHERITED::onRender(snapshot_canvas, nullptr);
+
+    fImage         = surface->makeImageSnapshot();
+    fImageOrigin   = dev_bounds.topLeft();
+    fSnapshotBytes = bytes;
+    fSnapshotCTM   = ctm;
+    return true;
+}
+
+void CacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    // Shader overrides apply to the individual draws, and cannot be applied to a snapshot.
+    if (ctx && ctx->fShader) {
+        gMisses.fetch_add(1, std::memory_order_relaxed);
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    const auto ctm = canvas->getTotalMatrix();
+
+    const auto has_snapshot = fPicture || fImage;
+    if (has_snapshot && !this->isCompatible(ctm, fSnapshotCTM)) {
+        this->purge();
+    }
+
+    // Only snapshot content which is static: unchanged since the previous render.
+    if (!fPicture && !fImage && fRenderedSinceInval && this->isCompatible(ctm, fLastCTM)) {
+        this->snapshot(canvas, ctm);
+    }
+
+    fLastCTM            = ctm;
+    fRenderedSinceInval = true;
+
+    if (!fPicture && !fImage) {
+        gMisses.fetch_add(1, std::memory_order_relaxed);
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    gHits.fetch_add(1, std::memory_order_relaxed);
+
+    // Apply the paint overrides to the snapshot as a group.
+    const auto local_ctx = ScopedRenderContext(canvas, ctx).setIsolation(this->bounds(), ctm,
+                                                                         true);
+    if (fPicture) {
+        canvas->drawPicture(fPicture);
+        return;
+    }
+
+    // The snapshot is in device space: blit, adjusting for integer translations.
+    const auto dx = ctm.getTranslateX() - fSnapshotCTM.getTranslateX(),
+               dy = ctm.getTranslateY() - fSnapshotCTM.getTranslateY();
+
+    SkAutoCanvasRestore acr(canvas, true);
+    canvas->resetMatrix();
+    canvas->drawImage(fImage, fImageOrigin.x() + dx, fImageOrigin.y() + dy);
+}
+
+SkRect CacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    SkASSERT(this->hasInval());
+
+    // The content has changed.
+    this->purge();
+    fRenderedSinceInval = false;
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+} // namespace sksg
@@ -8,8 +8,11 @@
 #include "modules/sksg/include/SkSGInvalidationController.h"
 
 #include "include/core/SkRect.h"
+#include "include/private/base/SkFloatingPoint.h"
 #include "src/base/SkTLazy.h"
 
+#include <algorithm>
+
 namespace sksg {
 
 InvalidationController::InvalidationController() : fBounds(SkRect::MakeEmpty()) {}
@@ -29,6 +32,66 @@ void InvalidationController::inval(const SkRect& r, const SkMatrix& ctm) {
     fBounds.join(*rect);
 }
 
+std::vector<SkRect> InvalidationController::mergedRects(size_t maxRects,
+                                                        float mergeSlack) const {
+    const auto area = [](const SkRect& r) { return r.width() * r.height(); };
+
+    // The damaged area covered by two rects.
+    const auto covered = [&](const SkRect& a, const SkRect& b) {
+        SkRect i;
+        return area(a) + area(b) - (i.intersect(a, b) ? area(i) : 0);
+    };
+
+    // The extra (undamaged) area repainted as a result of merging two rects.
+    const auto merge_cost = [&](const SkRect& a, const SkRect& b) {
+        SkRect u = a;
+        u.join(b);
+        return area(u) - covered(a, b);
+    };
+
+    std::vector<SkRect> rects;
+    rects.reserve(fRects.size());
+
+    for (auto r : fRects) {
+        // Merge with existing rects for as long as it's cheap, then add.
+        for (size_t i = 0; i < rects.size();) {
+            if (merge_cost(rects[i], r) <= mergeSlack * covered(rects[i], r)) {
+                // The merged rect may now be a good candidate for previously rejected merges.
+                r.join(rects[i]);
+                rects[i] = rects.back();
+                rects.pop_back();
+                i = 0;
+            } else {
+                ++i;
+            }
+        }
+        rects.push_back(r);
+    }
+
+    maxRects = std::max<size_t>(maxRects, 1);
+    while (rects.size() > maxRects) {
+        size_t best_i = 0,
+               best_j = 1;
+        float  best_cost = SK_FloatInfinity;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                const auto cost = merge_cost(rects[i], rects[j]);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_i = i;
+                    best_j = j;
+                }
+            }
+        }
+
+        rects[best_i].join(rects[best_j]);
+        rects[best_j] = rects.back();
+        rects.pop_back();
+    }
+
+    return rects;
+}
+
 void InvalidationController::reset() {
     fRects.clear();
     fBounds.setEmpty();
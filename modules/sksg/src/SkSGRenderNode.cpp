@@ -47,7 +47,8 @@ void RenderNode::setVisible(bool v) {
 
 void RenderNode::render(SkCanvas* canvas, const RenderContext* ctx) const {
     SkASSERT(!this->hasInval());
-    if (this->isVisible() && !this->bounds().isEmpty()) {
+    // Skip sub-DAGs entirely outside the clip (e.g. when only repainting damaged regions).
+    if (this->isVisible() && !this->bounds().isEmpty() && !canvas->quickReject(this->bounds())) {
         this->onRender(canvas, ctx);
     }
     SkASSERT(!this->hasInval());
@@ -9,8 +9,11 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkRect.h"
 #include "include/private/base/SkTo.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
@@ -22,6 +25,7 @@
 
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <vector>
 
 static void check_inval(skiatest::Reporter* reporter, const sk_sp<sksg::Node>& root,
@@ -355,4 +359,102 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+DEF_TEST(SGInvalidation_MergedRects, reporter) {
+    sksg::InvalidationController ic;
+    ic.inval(SkRect::MakeLTRB(  0,   0,  10,  10));
+    ic.inval(SkRect::MakeLTRB( 10,   0,  20,  10)); // adjacent to #1
+    ic.inval(SkRect::MakeLTRB(  0,   5,  20,  15)); // overlaps #1 + #2
+    ic.inval(SkRect::MakeLTRB(100, 100, 110, 110));
+    ic.inval(SkRect::MakeLTRB(100, 120, 110, 130)); // 10px gap from #4
+    ic.inval(SkRect::MakeLTRB(  5,   5,   8,   8)); // nested in #1
+
+    // Merges which don't repaint any undamaged area always happen.
+    auto rects = ic.mergedRects(10);
+    REPORTER_ASSERT(reporter, rects.size() == 3);
+    REPORTER_ASSERT(reporter, std::count(rects.begin(), rects.end(),
+                                         SkRect::MakeLTRB(0, 0, 20, 15)) == 1);
+
+    // Merging #4 and #5 repaints 50% extra.
+    rects = ic.mergedRects(10, 0.49f);
+    REPORTER_ASSERT(reporter, rects.size() == 3);
+    rects = ic.mergedRects(10, 0.5f);
+    REPORTER_ASSERT(reporter, rects.size() == 2);
+    REPORTER_ASSERT(reporter, std::count(rects.begin(), rects.end(),
+                                         SkRect::MakeLTRB(100, 100, 110, 130)) == 1);
+
+    // Rect count limit.
+    rects = ic.mergedRects(1);
+    REPORTER_ASSERT(reporter, rects.size() == 1);
+    REPORTER_ASSERT(reporter, rects[0] == ic.bounds());
+}
+
+DEF_TEST(SGCacheEffect, reporter) {
+    auto color = sksg::Color::Make(SK_ColorRED);
+    auto cache = sksg::CacheEffect::Make(
+            sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeLTRB(10, 10, 50, 50)), color));
+
+    SkBitmap bm;
+    bm.allocN32Pixels(64, 64);
+    SkCanvas canvas(bm);
+
+    // Renders the cache with an optional CTM translation, and checks for expected content.
+    const auto render = [&](SkColor expected, int dx = 0, int dy = 0) {
+        sksg::InvalidationController ic;
+        cache->revalidate(&ic, SkMatrix::I());
+
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        canvas.save();
+        canvas.translate(dx, dy);
+        cache->render(&canvas);
+        canvas.restore();
+
+        REPORTER_ASSERT(reporter, bm.getColor(30 + dx, 30 + dy) == expected);
+        REPORTER_ASSERT(reporter, bm.getColor( 5 + dx,  5 + dy) == SK_ColorTRANSPARENT);
+    };
+
+    const auto check_stats = [&](const sksg::CacheEffect::Stats& prev,
+                                 uint64_t hits, uint64_t misses) {
+        const auto stats = sksg::CacheEffect::GetStats();
+        REPORTER_ASSERT(reporter, stats.fHits   - prev.fHits   == hits);
+        REPORTER_ASSERT(reporter, stats.fMisses - prev.fMisses == misses);
+    };
+
+    auto stats = sksg::CacheEffect::GetStats();
+
+    // The first render is never cached; the content is snapshotted once found to be static.
+    render(SK_ColorRED);
+    render(SK_ColorRED);
+    render(SK_ColorRED);
+    check_stats(stats, 2, 1);
+    REPORTER_ASSERT(reporter, sksg::CacheEffect::GetStats().fBytesUsed > 0);
+
+    // Integer translations reuse the snapshot.
+    stats = sksg::CacheEffect::GetStats();
+    render(SK_ColorRED, 7, 3);
+    check_stats(stats, 1, 0);
+
+    // Content changes purge the snapshot.
+    stats = sksg::CacheEffect::GetStats();
+    color->setColor(SK_ColorBLUE);
+    render(SK_ColorBLUE);
+    render(SK_ColorBLUE);
+    check_stats(stats, 1, 1);
+
+    // Content which doesn't fit the budget is not cached.
+    color->setColor(SK_ColorGREEN);
+    const auto prev_limit = sksg::CacheEffect::SetByteLimit(0);
+    stats = sksg::CacheEffect::GetStats();
+    render(SK_ColorGREEN);
+    render(SK_ColorGREEN);
+    check_stats(stats, 0, 2);
+    sksg::CacheEffect::SetByteLimit(prev_limit);
+
+    // Snapshot memory is released when the node goes away.
+    const auto bytes = sksg::CacheEffect::GetStats().fBytesUsed;
+    render(SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, sksg::CacheEffect::GetStats().fBytesUsed > bytes);
+    cache.reset();
+    REPORTER_ASSERT(reporter, sksg::CacheEffect::GetStats().fBytesUsed == bytes);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
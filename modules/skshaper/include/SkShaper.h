@@ -303,6 +303,37 @@ private:
     SkPoint fOffset;
 };
 
+namespace SkShapers {
+/**
+ * A memory-bounded LRU cache of shaped text for the shapers returned by Cached(). It is safe to
+ * share between shapers that are used on different threads. It can't be subclassed; use Make().
+ */
+class SKSHAPER_API ShapedRunCache : public SkRefCnt {
+public:
+    static constexpr size_t kDefaultByteLimit = 2 * 1024 * 1024;
+    static sk_sp<ShapedRunCache> Make(size_t byteLimit = kDefaultByteLimit);
+
+    virtual size_t bytesUsed() const = 0;
+    virtual int count() const = 0;
+    virtual void purgeAll() = 0;
+
+private:
+    // Make() is the only way to create a cache; Cached() relies on its implementation.
+    ShapedRunCache() = default;
+    friend class ShapedRunCacheImpl;
+};
+
+/**
+ * Returns a shaper that shapes with 'shaper' and keeps the results in 'cache'. Shaping the same
+ * text with the same font, bidi, script and language runs, features and width again replays the
+ * glyph IDs, positions and clusters from the cache into the RunHandler instead of shaping it.
+ * The shapers that share a cache should all be of the same kind (and use the same fallback font
+ * manager), since the cache can't tell their results apart.
+ */
+SKSHAPER_API std::unique_ptr<SkShaper> Cached(std::unique_ptr<SkShaper> shaper,
+                                              sk_sp<ShapedRunCache> cache);
+}  // namespace SkShapers
+
 namespace SkShapers::Primitive {
 SKSHAPER_API std::unique_ptr<SkShaper> PrimitiveText();
 
@@ -35,6 +35,13 @@ namespace Primitive {
 SKSHAPER_API sk_sp<Factory> Factory();
 }
 
+/**
+ * Returns a factory that makes the shapers of 'factory' and wraps them with Cached(), all sharing
+ * one ShapedRunCache. Text that is shaped again (e.g. every frame) is then replayed from the cache.
+ */
+SKSHAPER_API sk_sp<Factory> CachingFactory(sk_sp<Factory> factory,
+                                           size_t byteLimit = ShapedRunCache::kDefaultByteLimit);
+
 }  // namespace SkShapers
 
 #endif  // SkShaperFactory_DEFINED
@@ -0,0 +1,535 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkFont.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTo.h"
+#include "modules/skshaper/include/SkShaper.h"
+#include "modules/skshaper/include/SkShaper_factory.h"
+#include "src/base/SkTInternalLList.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkTHash.h"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace skia_private;
+
+namespace {
+
+using RunHandler = SkShaper::RunHandler;
+
+// Everything the output of a shaper depends on, written out as bytes: the text, the runs of all
+// the iterators, the features and the width. Typefaces are identified by their unique ID.
+class Key {
+public:
+    enum class Kind : uint8_t { kFont, kIterators };
+
+    Key(Kind kind, const char* utf8, size_t utf8Bytes) {
+        this->write(kind);
+        this->write(utf8Bytes);
+        this->write(utf8, utf8Bytes);
+    }
+
+    void write(const void* data, size_t size) {
+        fBytes.push_back_n(SkToInt(size), static_cast<const char*>(data));
+    }
+
+    template <typename T>
+    void write(T value) {
+        static_assert(std::is_trivially_copyable<T>::value);
+        this->write(&value, sizeof(value));
+    }
+
+    void write(const SkFont& font) {
+        this->write(font.getTypeface() ? font.getTypeface()->uniqueID() : SkTypefaceID(0));
+        this->write(font.getSize());
+        this->write(font.getScaleX());
+        this->write(font.getSkewX());
+        this->write(font.getEdging());
+        this->write(font.getHinting());
+        uint8_t flags = SkToU8((font.isForceAutoHinting() << 0) |
+                        (font.isEmbeddedBitmaps()  << 1) |
+                        (font.isSubpixel()         << 2) |
+                        (font.isLinearMetrics()    << 3) |
+                        (font.isEmbolden()         << 4) |
+                        (font.isBaselineSnap()     << 5));
+        this->write(flags);
+    }
+
+    void write(const SkString& string) {
+        this->write(string.size());
+        this->write(string.c_str(), string.size());
+    }
+
+    void finish() { fHash = SkChecksum::Hash32(fBytes.data(), fBytes.size()); }
+
+    bool operator==(const Key& that) const {
+        return fHash == that.fHash &&
+               fBytes.size() == that.fBytes.size() &&
+               memcmp(fBytes.data(), that.fBytes.data(), fBytes.size()) == 0;
+    }
+
+    uint32_t hash() const { return fHash; }
+    size_t size() const { return sizeof(Key) + fBytes.size(); }
+
+private:
+    TArray<char, true> fBytes;
+    uint32_t fHash = 0;
+};
+
+// The calls a shaper made to its RunHandler, with everything it wrote into the run buffers.
+class ShapedText {
+public:
+    struct Run {
+        SkFont fFont;
+        uint8_t fBidiLevel;
+        SkVector fAdvance;
+        size_t fGlyphCount;
+        RunHandler::Range fUtf8Range;
+        TArray<SkGlyphID, true> fGlyphs;
+        TArray<SkPoint, true> fPositions;
+        TArray<SkPoint, true> fOffsets;
+        TArray<uint32_t, true> fClusters;
+
+        explicit Run(const RunHandler::RunInfo& info)
+                : fFont(info.fFont)
+                , fBidiLevel(info.fBidiLevel)
+                , fAdvance(info.fAdvance)
+                , fGlyphCount(info.glyphCount)
+                , fUtf8Range(info.utf8Range) {}
+
+        RunHandler::RunInfo info() const {
+            return {fFont, fBidiLevel, fAdvance, fGlyphCount, fUtf8Range};
+        }
+
+        // Writes the glyphs into a buffer the way the handler asked for them
+        void fill(const RunHandler::Buffer& buffer) const {
+            SkASSERT(buffer.glyphs && buffer.positions);
+            memcpy(buffer.glyphs, fGlyphs.data(), fGlyphCount * sizeof(SkGlyphID));
+            for (size_t i = 0; i < fGlyphCount; ++i) {
+                if (buffer.offsets) {
+                    buffer.positions[i] = fPositions[i] + buffer.point;
+                    buffer.offsets[i] = fOffsets[i];
+                } else {
+                    buffer.positions[i] = fPositions[i] + buffer.point + fOffsets[i];
+                }
+            }
+            if (buffer.clusters) {
+                memcpy(buffer.clusters, fClusters.data(), fGlyphCount * sizeof(uint32_t));
+            }
+        }
+    };
+
+    enum class Op : uint8_t {
+        kBeginLine,
+        kRunInfo,          // Uses the next run
+        kCommitRunInfo,
+        kRunBuffer,        // Uses the next run (and includes commitRunBuffer)
+        kCommitLine,
+    };
+
+    void replay(RunHandler* handler) const {
+        size_t runIndex = 0;
+        for (Op op : fOps) {
+            switch (op) {
+                case Op::kBeginLine:
+                    handler->beginLine();
+                    break;
+                case Op::kRunInfo:
+                    handler->runInfo(fRuns[runIndex++].info());
+                    break;
+                case Op::kCommitRunInfo:
+                    handler->commitRunInfo();
+                    break;
+                case Op::kRunBuffer: {
+                    const Run& run = fRuns[runIndex++];
+                    const RunHandler::RunInfo info = run.info();
+                    run.fill(handler->runBuffer(info));
+                    handler->commitRunBuffer(info);
+                    break;
+                }
+                case Op::kCommitLine:
+                    handler->commitLine();
+                    break;
+            }
+        }
+    }
+
+    size_t approximateSize() const {
+        size_t size = sizeof(ShapedText) + fOps.size() * sizeof(Op);
+        for (const Run& run : fRuns) {
+            size += sizeof(Run) + run.fGlyphs.size() * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) +
+                                                        sizeof(uint32_t));
+        }
+        return size;
+    }
+
+    TArray<Op, true> fOps;
+    std::vector<Run> fRuns;
+};
+
+// Passes everything through to 'handler' while recording it.
+class RecordingRunHandler final : public RunHandler {
+public:
+    explicit RecordingRunHandler(RunHandler* handler)
+            : fHandler(handler), fText(std::make_shared<ShapedText>()) {}
+
+    std::shared_ptr<const ShapedText> detach() { return std::move(fText); }
+
+    void beginLine() override {
+        fText->fOps.push_back(ShapedText::Op::kBeginLine);
+        fHandler->beginLine();
+    }
+
+    void runInfo(const RunInfo& info) override {
+        fText->fOps.push_back(ShapedText::Op::kRunInfo);
+        fText->fRuns.emplace_back(info);
+        fHandler->runInfo(info);
+    }
+
+    void commitRunInfo() override {
+        fText->fOps.push_back(ShapedText::Op::kCommitRunInfo);
+        fHandler->commitRunInfo();
+    }
+
+    Buffer runBuffer(const RunInfo& info) override {
+        // The shaper fills our buffer, which we copy into the handler's one when it's done
+        fText->fOps.push_back(ShapedText::Op::kRunBuffer);
+        ShapedText::Run& run = fText->fRuns.emplace_back(info);
+        const int count = SkToInt(info.glyphCount);
+        run.fGlyphs.push_back_n(count, SkGlyphID(0));
+        run.fPositions.push_back_n(count, SkPoint{0, 0});
+        run.fOffsets.push_back_n(count, SkPoint{0, 0});
+        run.fClusters.push_back_n(count, 0u);
+        fBuffer = fHandler->runBuffer(info);
+        return {run.fGlyphs.data(), run.fPositions.data(), run.fOffsets.data(),
+                run.fClusters.data(), {0, 0}};
+    }
+
+    void commitRunBuffer(const RunInfo& info) override {
+        fText->fRuns.back().fill(fBuffer);
+        fHandler->commitRunBuffer(info);
+    }
+
+    void commitLine() override {
+        fText->fOps.push_back(ShapedText::Op::kCommitLine);
+        fHandler->commitLine();
+    }
+
+private:
+    RunHandler* fHandler;
+    std::shared_ptr<ShapedText> fText;
+    Buffer fBuffer;
+};
+
+}  // namespace
+
+// This is in SkShapers, rather than the anonymous namespace, so ShapedRunCache can befriend it.
+namespace SkShapers {
+
+class ShapedRunCacheImpl final : public ShapedRunCache {
+public:
+    explicit ShapedRunCacheImpl(size_t byteLimit) : fByteLimit(byteLimit) {}
+
+    ~ShapedRunCacheImpl() override { this->purgeAll(); }
+
+    std::shared_ptr<const ShapedText> find(const Key& key) {
+        SkAutoMutexExclusive lock(fMutex);
+        Entry** found = fMap.find(key);
+        if (!found) {
+            return nullptr;
+        }
+        if (*found != fLRU.head()) {
+            fLRU.remove(*found);
+            fLRU.addToHead(*found);
+        }
+        return (*found)->fText;
+    }
+
+    void add(Key key, std::shared_ptr<const ShapedText> text) {
+        const size_t size = key.size() + text->approximateSize();
+        SkAutoMutexExclusive lock(fMutex);
+        if (size > fByteLimit || fMap.find(key)) {
+            return;
+        }
+        Entry* entry = new Entry{std::move(key), std::move(text), size};
+        fMap.set(entry);
+        fLRU.addToHead(entry);
+        fBytesUsed += size;
+        this->purgeAsNeeded(fByteLimit);
+    }
+
+    size_t bytesUsed() const override {
+        SkAutoMutexExclusive lock(fMutex);
+        return fBytesUsed;
+    }
+
+    int count() const override {
+        SkAutoMutexExclusive lock(fMutex);
+        return fMap.count();
+    }
+
+    void purgeAll() override {
+        SkAutoMutexExclusive lock(fMutex);
+        this->purgeAsNeeded(0);
+    }
+
+private:
+    struct Entry {
+        Key fKey;
+        std::shared_ptr<const ShapedText> fText;
+        size_t fSize;
+
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+    };
+
+    struct Traits {
+        static const Key& GetKey(const Entry* e) { return e->fKey; }
+        static uint32_t Hash(const Key& key) { return key.hash(); }
+    };
+
+    void purgeAsNeeded(size_t byteLimit) SK_REQUIRES(fMutex) {
+        while (fBytesUsed > byteLimit) {
+            Entry* entry = fLRU.tail();
+            SkASSERT(entry);
+            fLRU.remove(entry);
+            fMap.remove(entry->fKey);
+            fBytesUsed -= entry->fSize;
+            delete entry;
+        }
+    }
+
+    const size_t fByteLimit;
+    mutable SkMutex fMutex;
+    THashTable<Entry*, Key, Traits> fMap SK_GUARDED_BY(fMutex);
+    SkTInternalLList<Entry> fLRU SK_GUARDED_BY(fMutex);
+    size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+};
+
+}  // namespace SkShapers
+
+namespace {
+
+using SkShapers::ShapedRunCacheImpl;
+
+// Iterates through runs that were recorded from another iterator.
+template <typename Base, typename T>
+class ReplayRunIterator : public Base {
+public:
+    using Runs = std::vector<std::pair<size_t, T>>;
+
+    explicit ReplayRunIterator(const Runs& runs) : fRuns(runs) {}
+
+    void consume() override {
+        SkASSERT(!this->atEnd());
+        ++fConsumed;
+    }
+    size_t endOfCurrentRun() const override {
+        return fConsumed > 0 ? fRuns[fConsumed - 1].first : 0;
+    }
+    bool atEnd() const override { return fConsumed == fRuns.size(); }
+
+protected:
+    const T& current() const {
+        SkASSERT(fConsumed > 0);
+        return fRuns[fConsumed - 1].second;
+    }
+
+private:
+    const Runs& fRuns;
+    size_t fConsumed = 0;
+};
+
+class ReplayFontRunIterator final
+        : public ReplayRunIterator<SkShaper::FontRunIterator, SkFont> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    const SkFont& currentFont() const override { return this->current(); }
+};
+
+class ReplayBiDiRunIterator final
+        : public ReplayRunIterator<SkShaper::BiDiRunIterator, uint8_t> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    uint8_t currentLevel() const override { return this->current(); }
+};
+
+class ReplayScriptRunIterator final
+        : public ReplayRunIterator<SkShaper::ScriptRunIterator, SkFourByteTag> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    SkFourByteTag currentScript() const override { return this->current(); }
+};
+
+class ReplayLanguageRunIterator final
+        : public ReplayRunIterator<SkShaper::LanguageRunIterator, SkString> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    const char* currentLanguage() const override { return this->current().c_str(); }
+};
+
+// Consumes 'iterator' and writes its runs into 'key'
+template <typename Iterator, typename T, typename Current>
+void record_runs(Iterator& iterator, std::vector<std::pair<size_t, T>>* runs, Key* key,
+                 Current current) {
+    while (!iterator.atEnd()) {
+        iterator.consume();
+        runs->emplace_back(iterator.endOfCurrentRun(), current(iterator));
+        key->write(runs->back().first);
+        key->write(runs->back().second);
+    }
+    key->write(runs->size());
+}
+
+class CachingShaper final : public SkShaper {
+public:
+    CachingShaper(std::unique_ptr<SkShaper> shaper, sk_sp<ShapedRunCacheImpl> cache)
+            : fShaper(std::move(shaper)), fCache(std::move(cache)) {}
+
+#if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
+    void shape(const char* utf8, size_t utf8Bytes,
+               const SkFont& srcFont,
+               bool leftToRight,
+               SkScalar width,
+               RunHandler* handler) const override {
+        Key key(Key::Kind::kFont, utf8, utf8Bytes);
+        key.write(srcFont);
+        key.write(leftToRight);
+        key.write(width);
+        this->shape(std::move(key), handler, [&](RunHandler* h) {
+            fShaper->shape(utf8, utf8Bytes, srcFont, leftToRight, width, h);
+        });
+    }
+
+    void shape(const char* utf8, size_t utf8Bytes,
+               FontRunIterator& font,
+               BiDiRunIterator& bidi,
+               ScriptRunIterator& script,
+               LanguageRunIterator& language,
+               SkScalar width,
+               RunHandler* handler) const override {
+        this->shape(utf8, utf8Bytes, font, bidi, script, language, nullptr, 0, width, handler);
+    }
+#endif
+
+    void shape(const char* utf8, size_t utf8Bytes,
+               FontRunIterator& font,
+               BiDiRunIterator& bidi,
+               ScriptRunIterator& script,
+               LanguageRunIterator& language,
+               const Feature* features, size_t featuresSize,
+               SkScalar width,
+               RunHandler* handler) const override {
+        // The iterators can only be consumed once, so record their runs for the key and give
+        // the shaper iterators over the recording.
+        Key key(Key::Kind::kIterators, utf8, utf8Bytes);
+        ReplayFontRunIterator::Runs fontRuns;
+        ReplayBiDiRunIterator::Runs bidiRuns;
+        ReplayScriptRunIterator::Runs scriptRuns;
+        ReplayLanguageRunIterator::Runs languageRuns;
+        record_runs(font, &fontRuns, &key,
+                    [](const FontRunIterator& it) { return it.currentFont(); });
+        record_runs(bidi, &bidiRuns, &key,
+                    [](const BiDiRunIterator& it) { return it.currentLevel(); });
+        record_runs(script, &scriptRuns, &key,
+                    [](const ScriptRunIterator& it) { return it.currentScript(); });
+        record_runs(language, &languageRuns, &key,
+                    [](const LanguageRunIterator& it) { return SkString(it.currentLanguage()); });
+        for (size_t i = 0; i < featuresSize; ++i) {
+            key.write(features[i].tag);
+            key.write(features[i].value);
+            key.write(features[i].start);
+            key.write(features[i].end);
+        }
+        key.write(featuresSize);
+        key.write(width);
+
+        this->shape(std::move(key), handler, [&](RunHandler* h) {
+            ReplayFontRunIterator fontIter(fontRuns);
+            ReplayBiDiRunIterator bidiIter(bidiRuns);
+            ReplayScriptRunIterator scriptIter(scriptRuns);
+            ReplayLanguageRunIterator languageIter(languageRuns);
+            fShaper->shape(utf8, utf8Bytes, fontIter, bidiIter, scriptIter, languageIter,
+                           features, featuresSize, width, h);
+        });
+    }
+
+private:
+    void shape(Key key, RunHandler* handler, const std::function<void(RunHandler*)>& shape) const {
+        key.finish();
+        if (std::shared_ptr<const ShapedText> text = fCache->find(key)) {
+            text->replay(handler);
+            return;
+        }
+        RecordingRunHandler recorder(handler);
+        shape(&recorder);
+        fCache->add(std::move(key), recorder.detach());
+    }
+
+    std::unique_ptr<SkShaper> fShaper;
+    sk_sp<ShapedRunCacheImpl> fCache;
+};
+
+class CachingFactory final : public SkShapers::Factory {
+public:
+    CachingFactory(sk_sp<SkShapers::Factory> factory, size_t byteLimit)
+            : fFactory(std::move(factory)), fCache(sk_make_sp<ShapedRunCacheImpl>(byteLimit)) {}
+
+    std::unique_ptr<SkShaper> makeShaper(sk_sp<SkFontMgr> fallback) override {
+        return SkShapers::Cached(fFactory->makeShaper(std::move(fallback)), fCache);
+    }
+    std::unique_ptr<SkShaper::BiDiRunIterator> makeBidiRunIterator(
+            const char* utf8, size_t utf8Bytes, uint8_t bidiLevel) override {
+        return fFactory->makeBidiRunIterator(utf8, utf8Bytes, bidiLevel);
+    }
+    std::unique_ptr<SkShaper::ScriptRunIterator> makeScriptRunIterator(
+            const char* utf8, size_t utf8Bytes, SkFourByteTag script) override {
+        return fFactory->makeScriptRunIterator(utf8, utf8Bytes, script);
+    }
+    SkUnicode* getUnicode() override { return fFactory->getUnicode(); }
+
+private:
+    sk_sp<SkShapers::Factory> fFactory;
+    sk_sp<ShapedRunCacheImpl> fCache;
+};
+
+}  // namespace
+
+namespace SkShapers {
+
+sk_sp<ShapedRunCache> ShapedRunCache::Make(size_t byteLimit) {
+    return sk_make_sp<ShapedRunCacheImpl>(byteLimit);
+}
+
+std::unique_ptr<SkShaper> Cached(std::unique_ptr<SkShaper> shaper, sk_sp<ShapedRunCache> cache) {
+    if (!shaper || !cache) {
+        return shaper;
+    }
+    // ShapedRunCache can't be subclassed outside of this file, so this is the implementation.
+    sk_sp<ShapedRunCacheImpl> impl(static_cast<ShapedRunCacheImpl*>(cache.release()));
+    return std::make_unique<CachingShaper>(std::move(shaper), std::move(impl));
+}
+
+sk_sp<Factory> CachingFactory(sk_sp<Factory> factory, size_t byteLimit) {
+    if (!factory) {
+        return nullptr;
+    }
+    return sk_make_sp<::CachingFactory>(std::move(factory), byteLimit);
+}
+
+}  // namespace SkShapers
@@ -329,6 +329,9 @@ HBFont create_typeface_hb_font(const SkTypeface& typeface) {
         }
     }
 
+    // The font is shared between threads from now on; make sure nothing modifies it
+    // (hb_font_create_sub_font would otherwise do that on whichever thread gets there first).
+    hb_font_make_immutable(otFont.get());
     return otFont;
 }
 
@@ -1241,38 +1244,55 @@ void ShapeDontWrapOrReorder::wrap(char const * const utf8, size_t utf8Bytes,
     handler->commitLine();
 }
 
-class HBLockedFaceCache {
+// An HBFont for a typeface is expensive to make (creating its face sanitizes the font data), so
+// they are cached and shared by every thread. The cached fonts are immutable; a lookup only takes a
+// new reference to one, so no lock is held while creating a font or shaping with it. The cache is
+// sharded by typeface to keep threads that shape with different typefaces out of each other's way.
+class HBFontCache {
 public:
-    HBLockedFaceCache(SkLRUCache<SkTypefaceID, HBFont>& lruCache, SkMutex& mutex)
-        : fLRUCache(lruCache), fMutex(mutex)
-    {
-        fMutex.acquire();
-    }
-    HBLockedFaceCache(const HBLockedFaceCache&) = delete;
-    HBLockedFaceCache& operator=(const HBLockedFaceCache&) = delete;
-    HBLockedFaceCache& operator=(HBLockedFaceCache&&) = delete;
-
-    ~HBLockedFaceCache() {
-        fMutex.release();
+    HBFont find(SkTypefaceID typefaceId) {
+        Shard& shard = this->shardFor(typefaceId);
+        SkAutoMutexExclusive lock(shard.fMutex);
+        HBFont* font = shard.fLRUCache.find(typefaceId);
+        return font ? HBFont(hb_font_reference(font->get())) : nullptr;
+    }
+
+    // Returns the cached font, which is not 'font' if another thread added one first.
+    HBFont insert(SkTypefaceID typefaceId, HBFont font) {
+        Shard& shard = this->shardFor(typefaceId);
+        SkAutoMutexExclusive lock(shard.fMutex);
+        HBFont* cached = shard.fLRUCache.find(typefaceId);
+        if (!cached) {
+            cached = shard.fLRUCache.insert(typefaceId, std::move(font));
+        }
+        return HBFont(hb_font_reference(cached->get()));
     }
 
-    HBFont* find(SkTypefaceID fontId) {
-        return fLRUCache.find(fontId);
-    }
-    HBFont* insert(SkTypefaceID fontId, HBFont hbFont) {
-        return fLRUCache.insert(fontId, std::move(hbFont));
-    }
     void reset() {
-        fLRUCache.reset();
+        for (Shard& shard : fShards) {
+            SkAutoMutexExclusive lock(shard.fMutex);
+            shard.fLRUCache.reset();
+        }
     }
+
 private:
-    SkLRUCache<SkTypefaceID, HBFont>& fLRUCache;
-    SkMutex& fMutex;
+    // The total size of 100 is completely arbitrary and used to match libtxt.
+    static constexpr int kShardCount = 4;
+    static constexpr int kMaxEntries = 100;
+
+    struct Shard {
+        Shard() : fLRUCache(kMaxEntries / kShardCount) {}
+
+        SkMutex fMutex;
+        SkLRUCache<SkTypefaceID, HBFont> fLRUCache SK_GUARDED_BY(fMutex);
+    };
+    Shard& shardFor(SkTypefaceID typefaceId) { return fShards[typefaceId % kShardCount]; }
+
+    Shard fShards[kShardCount];
 };
-static HBLockedFaceCache get_hbFace_cache() {
-    static SkMutex gHBFaceCacheMutex;
-    static SkLRUCache<SkTypefaceID, HBFont> gHBFaceCache(100);
-    return HBLockedFaceCache(gHBFaceCache, gHBFaceCacheMutex);
+static HBFontCache& get_hbFont_cache() {
+    static HBFontCache gHBFontCache;
+    return gHBFontCache;
 }
 
 ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
@@ -1330,17 +1350,20 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     // An HBFace is expensive (it sanitizes the bits).
     // An HBFont is fairly inexpensive.
     // An HBFace is actually tied to the data, not the typeface.
-    // The size of 100 here is completely arbitrary and used to match libtxt.
     HBFont hbFont;
     {
-        HBLockedFaceCache cache = get_hbFace_cache();
+        HBFontCache& cache = get_hbFont_cache();
         SkTypefaceID dataId = font.currentFont().getTypeface()->uniqueID();
-        HBFont* typefaceFontCached = cache.find(dataId);
-        if (!typefaceFontCached) {
-            HBFont typefaceFont(create_typeface_hb_font(*font.currentFont().getTypeface()));
-            typefaceFontCached = cache.insert(dataId, std::move(typefaceFont));
+        HBFont typefaceFont = cache.find(dataId);
+        if (!typefaceFont) {
+            typefaceFont = create_typeface_hb_font(*font.currentFont().getTypeface());
+            if (typefaceFont) {
+                typefaceFont = cache.insert(dataId, std::move(typefaceFont));
+            }
+        }
+        if (typefaceFont) {
+            hbFont = create_sub_hb_font(font.currentFont(), typefaceFont);
         }
-        hbFont = create_sub_hb_font(font.currentFont(), *typefaceFontCached);
     }
     if (!hbFont) {
         return run;
@@ -1532,7 +1555,6 @@ std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8,
 }
 
 void PurgeCaches() {
-    HBLockedFaceCache cache = get_hbFace_cache();
-    cache.reset();
+    get_hbFont_cache().reset();
 }
 }  // namespace SkShapers::HB
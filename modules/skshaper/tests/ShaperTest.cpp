@@ -11,6 +11,7 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skshaper/include/SkShaper.h"
 #include "modules/skshaper/include/SkShaper_harfbuzz.h"
@@ -272,3 +273,72 @@ SHAPER_TEST(tamil)
 #undef SHAPER_TEST
 
 #endif  // #if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
+
+namespace {
+
+// Keeps every glyph it's given, with the offsets folded into the positions.
+struct GlyphRecorder final : public SkShaper::RunHandler {
+    skia_private::TArray<SkGlyphID> fGlyphs;
+    skia_private::TArray<SkPoint> fPositions;
+    skia_private::TArray<uint32_t> fClusters;
+    int fLines = 0;
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        const int count = SkToInt(info.glyphCount);
+        return {fGlyphs.push_back_n(count),
+                fPositions.push_back_n(count),
+                nullptr,
+                fClusters.push_back_n(count),
+                {0, SkIntToScalar(fLines) * 20}};
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override { ++fLines; }
+};
+
+}  // namespace
+
+DEF_TEST(Shaper_cached_replay, r) {
+    sk_sp<SkShapers::ShapedRunCache> cache = SkShapers::ShapedRunCache::Make();
+    std::unique_ptr<SkShaper> shaper = SkShapers::Cached(SkShapers::Primitive::PrimitiveText(),
+                                                         cache);
+    REPORTER_ASSERT(r, shaper);
+
+    constexpr char kText[] = "The quick brown fox jumps over the lazy dog";
+    constexpr size_t kTextBytes = sizeof(kText) - 1;
+    SkFont font = ToolUtils::DefaultFont();
+
+    auto shape = [&](SkScalar width, GlyphRecorder* recorder) {
+        auto fontRuns = SkShaper::TrivialFontRunIterator(font, kTextBytes);
+        auto bidiRuns = SkShaper::TrivialBiDiRunIterator(0, kTextBytes);
+        auto scriptRuns = SkShaper::TrivialScriptRunIterator(0, kTextBytes);
+        auto languageRuns = SkShaper::TrivialLanguageRunIterator("en-US", kTextBytes);
+        shaper->shape(kText, kTextBytes, fontRuns, bidiRuns, scriptRuns, languageRuns,
+                      nullptr, 0, width, recorder);
+    };
+
+    GlyphRecorder shaped, replayed;
+    shape(100, &shaped);
+    REPORTER_ASSERT(r, cache->count() == 1);
+    shape(100, &replayed);
+    REPORTER_ASSERT(r, cache->count() == 1);
+    REPORTER_ASSERT(r, cache->bytesUsed() > 0);
+
+    REPORTER_ASSERT(r, shaped.fLines > 1);
+    REPORTER_ASSERT(r, shaped.fLines == replayed.fLines);
+    REPORTER_ASSERT(r, shaped.fGlyphs == replayed.fGlyphs);
+    REPORTER_ASSERT(r, shaped.fPositions == replayed.fPositions);
+    REPORTER_ASSERT(r, shaped.fClusters == replayed.fClusters);
+
+    // A different width breaks the lines differently, so it is shaped again
+    GlyphRecorder wide;
+    shape(1000, &wide);
+    REPORTER_ASSERT(r, cache->count() == 2);
+    REPORTER_ASSERT(r, wide.fLines < shaped.fLines);
+
+    cache->purgeAll();
+    REPORTER_ASSERT(r, cache->count() == 0);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 0);
+}
@@ -15,6 +15,8 @@ class SK_API SkSVGContainer : public SkSVGTransformableNode {
 public:
     void appendChild(sk_sp<SkSVGNode>) override;
 
+    void setGenerationID(sk_sp<SkSVGGenerationID>) override;
+
 protected:
     explicit SkSVGContainer(SkSVGTag);
 
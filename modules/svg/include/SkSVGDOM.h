@@ -11,14 +11,20 @@
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "modules/skresources/include/SkResources.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "modules/svg/include/SkSVGIDMapper.h"
 
+#include <cstdint>
+
 class SkCanvas;
 class SkDOM;
+class SkPicture;
 class SkStream;
+class SkSVGGenerationID;
 class SkSVGNode;
 struct SkSVGPresentationContext;
 class SkSVGSVG;
@@ -46,14 +52,26 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * When enabled, render() records the DOM into an SkPicture with all styles, references
+         * and resources resolved, and replays it for subsequent calls (at any canvas transform)
+         * until a node is mutated or the container size changes.
+         *
+         * Useful for documents rendered repeatedly, such as icons.  Disabled by default.
+         */
+        Builder& setRenderCaching(bool);
+
         sk_sp<SkSVGDOM> make(SkStream&) const;
 
     private:
         sk_sp<SkFontMgr>                             fFontMgr;
         sk_sp<skresources::ResourceProvider>         fResourceProvider;
         sk_sp<SkShapers::Factory>                    fTextShapingFactory;
+        bool                                         fRenderCaching = false;
     };
 
+    ~SkSVGDOM() override;
+
     static sk_sp<SkSVGDOM> MakeFromStream(SkStream& str) {
         return Builder().make(str);
     }
@@ -101,7 +119,11 @@ private:
              sk_sp<SkFontMgr>,
              sk_sp<skresources::ResourceProvider>,
              SkSVGIDMapper&&,
-             sk_sp<SkShapers::Factory>);
+             sk_sp<SkShapers::Factory>,
+             bool renderCaching);
+
+    void renderUncached(SkCanvas*) const;
+    sk_sp<SkPicture> cachedPicture() const;
 
     const sk_sp<SkSVGSVG>                       fRoot;
     const sk_sp<SkFontMgr>                      fFontMgr;
@@ -109,6 +131,14 @@ private:
     const sk_sp<skresources::ResourceProvider>  fResourceProvider;
     const SkSVGIDMapper                         fIDMapper;
     SkSize                                      fContainerSize;
+
+    // Render cache (when enabled), valid for the recorded generation ID and container size.
+    const bool                                  fRenderCaching;
+    sk_sp<SkSVGGenerationID>                    fGenerationID; // shared by all nodes
+    mutable SkMutex                             fCacheMutex;
+    mutable sk_sp<SkPicture>                    fCachedPicture       SK_GUARDED_BY(fCacheMutex);
+    mutable uint32_t                            fCachedGenerationID  SK_GUARDED_BY(fCacheMutex) = 0;
+    mutable SkSize                              fCachedContainerSize SK_GUARDED_BY(fCacheMutex) = {0, 0};
 };
 
 #endif // SkSVGDOM_DEFINED
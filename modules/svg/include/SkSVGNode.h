@@ -12,6 +12,9 @@
 #include "modules/svg/include/SkSVGAttribute.h"
 #include "modules/svg/include/SkSVGAttributeParser.h"
 
+#include <atomic>
+#include <cstdint>
+
 class SkCanvas;
 class SkMatrix;
 class SkPaint;
@@ -20,6 +23,20 @@ class SkSVGLengthContext;
 class SkSVGRenderContext;
 class SkSVGValue;
 
+/**
+ * Mutation counter, shared by all nodes of an SkSVGDOM: setting attributes or appending children
+ * bumps it.  Used to invalidate cached renders.
+ */
+class SkSVGGenerationID final : public SkNVRefCnt<SkSVGGenerationID> {
+public:
+    uint32_t value() const { return fValue.load(std::memory_order_relaxed); }
+
+    void bump() { fValue.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> fValue{1};
+};
+
 enum class SkSVGTag {
     kCircle,
     kClipPath,
@@ -81,6 +98,7 @@ public:                                                                      \
         return fPresentationAttributes.f##attr_name;                         \
     }                                                                        \
     void set##attr_name(const SkSVGProperty<attr_type, attr_inherited>& v) { \
+        this->bumpGenerationID();                                            \
         auto* dest = &fPresentationAttributes.f##attr_name;                  \
         if (!dest->isInheritable() || v.isValue()) {                         \
             /* TODO: If dest is not inheritable, handle v == "inherit" */    \
@@ -90,6 +108,7 @@ public:                                                                      \
         }                                                                    \
     }                                                                        \
     void set##attr_name(SkSVGProperty<attr_type, attr_inherited>&& v) {      \
+        this->bumpGenerationID();                                            \
         auto* dest = &fPresentationAttributes.f##attr_name;                  \
         if (!dest->isInheritable() || v.isValue()) {                         \
             /* TODO: If dest is not inheritable, handle v == "inherit" */    \
@@ -118,6 +137,13 @@ public:
     // TODO: consolidate with existing setAttribute
     virtual bool parseAndSetAttribute(const char* name, const char* value);
 
+    /**
+     * Shares a mutation counter with this node and its children: their mutations (attributes
+     * set, children appended, etc) bump it from now on.  SkSVGDOM attaches its counter once
+     * constructed, and children appended later inherit their parent's.
+     */
+    virtual void setGenerationID(sk_sp<SkSVGGenerationID>);
+
     // inherited
     SVG_PRES_ATTR(ClipRule                 , SkSVGFillRule  , true)
     SVG_PRES_ATTR(Color                    , SkSVGColorType , true)
@@ -156,6 +182,15 @@ public:
 protected:
     SkSVGNode(SkSVGTag);
 
+    // Must be called by all mutators.
+    void bumpGenerationID() {
+        if (fGenerationID) {
+            fGenerationID->bump();
+        }
+    }
+
+    const sk_sp<SkSVGGenerationID>& generationID() const { return fGenerationID; }
+
     static SkMatrix ComputeViewboxMatrix(const SkRect&, const SkRect&, SkSVGPreserveAspectRatio);
 
     // Called before onRender(), to apply local attributes to the context.  Unlike onRender(),
@@ -186,6 +221,9 @@ private:
     // FIXME: this should be sparse
     SkSVGPresentationAttributes fPresentationAttributes;
 
+    // Shared with the owning DOM, if any.
+    sk_sp<SkSVGGenerationID>    fGenerationID;
+
     using INHERITED = SkRefCnt;
 };
 
@@ -204,8 +242,14 @@ private:
             return pr.isValid();                                              \
         }                                                                     \
     public:                                                                   \
-        void set##attr_name(const attr_type& a) { set_cp(a); }                \
-        void set##attr_name(attr_type&& a) { set_mv(std::move(a)); }
+        void set##attr_name(const attr_type& a) {                             \
+            this->bumpGenerationID();                                         \
+            set_cp(a);                                                        \
+        }                                                                     \
+        void set##attr_name(attr_type&& a) {                                  \
+            this->bumpGenerationID();                                         \
+            set_mv(std::move(a));                                             \
+        }
 
 #define SVG_ATTR(attr_name, attr_type, attr_default)                        \
     private:                                                                \
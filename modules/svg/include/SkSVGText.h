@@ -47,6 +47,8 @@ public:
 
     void appendChild(sk_sp<SkSVGNode>) final;
 
+    void setGenerationID(sk_sp<SkSVGGenerationID>) final;
+
 protected:
     explicit SkSVGTextContainer(SkSVGTag t) : INHERITED(t) {}
 
@@ -13,7 +13,10 @@
 
 class SK_API SkSVGTransformableNode : public SkSVGNode {
 public:
-    void setTransform(const SkSVGTransformType& t) { fTransform = t; }
+    void setTransform(const SkSVGTransformType& t) {
+        this->bumpGenerationID();
+        fTransform = t;
+    }
 
 protected:
     SkSVGTransformableNode(SkSVGTag);
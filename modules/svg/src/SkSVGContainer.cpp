@@ -14,9 +14,20 @@ SkSVGContainer::SkSVGContainer(SkSVGTag t) : INHERITED(t) { }
 
 void SkSVGContainer::appendChild(sk_sp<SkSVGNode> node) {
     SkASSERT(node);
+    this->bumpGenerationID();
+    if (const auto& id = this->generationID()) {
+        node->setGenerationID(id);
+    }
     fChildren.push_back(std::move(node));
 }
 
+void SkSVGContainer::setGenerationID(sk_sp<SkSVGGenerationID> id) {
+    for (const auto& child : fChildren) {
+        child->setGenerationID(id);
+    }
+    INHERITED::setGenerationID(std::move(id));
+}
+
 bool SkSVGContainer::hasChildren() const {
     return !fChildren.empty();
 }
@@ -9,6 +9,8 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
@@ -51,8 +53,11 @@
 #include "modules/svg/include/SkSVGUse.h"
 #include "modules/svg/include/SkSVGValue.h"
 #include "src/base/SkTSearch.h"
+#include "src/core/SkRectPriv.h"
 #include "src/core/SkTraceEvent.h"
-#include "src/xml/SkDOM.h"
+#include "src/xml/SkXMLParser.h"
+
+#include <vector>
 
 namespace {
 
@@ -286,15 +291,6 @@ SortedDictionaryEntry<sk_sp<SkSVGNode>(*)()> gTagFactories[] = {
     { "use"                , []() -> sk_sp<SkSVGNode> { return SkSVGUse::Make();                 }},
 };
 
-struct ConstructionContext {
-    ConstructionContext(SkSVGIDMapper* mapper) : fParent(nullptr), fIDMapper(mapper) {}
-    ConstructionContext(const ConstructionContext& other, const sk_sp<SkSVGNode>& newParent)
-        : fParent(newParent.get()), fIDMapper(other.fIDMapper) {}
-
-    SkSVGNode*     fParent;
-    SkSVGIDMapper* fIDMapper;
-};
-
 bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value) {
     if (node->parseAndSetAttribute(name, value)) {
         // Handled by new code path
@@ -323,76 +319,116 @@ bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     return true;
 }
 
-void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
-                           const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
-    const char* name, *value;
-    SkDOM::AttrIter attrIter(xmlDom, xmlNode);
-    while ((name = attrIter.next(&value))) {
-        // We're handling id attributes out of band for now.
-        if (!strcmp(name, "id")) {
-            mapper->set(SkString(value), svgNode);
-            continue;
-        }
-        set_string_attribute(svgNode, name, value);
+sk_sp<SkSVGNode> make_node(const char* elem, const SkSVGNode* parent) {
+    if (strcmp(elem, "svg") == 0) {
+        // Outermost SVG element must be tagged as such.
+        return SkSVGSVG::Make(parent ? SkSVGSVG::Type::kInner
+                                     : SkSVGSVG::Type::kRoot);
     }
-}
 
-sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext& ctx,
-                                    const SkDOM::Node* xmlNode) {
-    const char* elem = dom.getName(xmlNode);
-    const SkDOM::Type elemType = dom.getType(xmlNode);
+    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
+                                     SkTo<int>(std::size(gTagFactories)),
+                                     elem, sizeof(gTagFactories[0]));
+    if (tagIndex < 0) {
+#if defined(SK_VERBOSE_SVG_PARSING)
+        SkDebugf("unhandled element: <%s>\n", elem);
+#endif
+        return nullptr;
+    }
+    SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+
+    return gTagFactories[tagIndex].fValue();
+}
 
-    if (elemType == SkDOM::kText_Type) {
-        // Text literals require special handling.
-        SkASSERT(dom.countChildren(xmlNode) == 0);
-        auto txt = SkSVGTextLiteral::Make();
-        txt->setText(SkString(dom.getName(xmlNode)));
-        ctx.fParent->appendChild(std::move(txt));
+// Constructs the SVG node tree directly from XML parser callbacks, in a single pass
+// (no intermediate SkDOM).  Attribute values are parsed in place, straight out of the
+// XML parser buffers.
+class SVGNodeBuilder final : public SkXMLParser {
+public:
+    explicit SVGNodeBuilder(SkSVGIDMapper* mapper) : fIDMapper(mapper) {}
 
-        return nullptr;
+    sk_sp<SkSVGNode> detachRoot() {
+        SkASSERT(fNodeStack.empty());
+        return std::move(fRoot);
     }
 
-    SkASSERT(elemType == SkDOM::kElement_Type);
+protected:
+    bool onStartElement(const char elem[]) override {
+        if (fSkipDepth > 0) {
+            fSkipDepth++;
+            return false;
+        }
+
+        const SkSVGNode* parent = fNodeStack.empty() ? nullptr : fNodeStack.back().get();
 
-    auto make_node = [](const ConstructionContext& ctx, const char* elem) -> sk_sp<SkSVGNode> {
-        if (strcmp(elem, "svg") == 0) {
-            // Outermost SVG element must be tagged as such.
-            return SkSVGSVG::Make(ctx.fParent ? SkSVGSVG::Type::kInner
-                                              : SkSVGSVG::Type::kRoot);
+        // Only <svg> roots are accepted: skip anything else, rather than constructing it.
+        auto node = (parent || !strcmp(elem, "svg")) ? make_node(elem, parent) : nullptr;
+        if (!node) {
+            // Unsupported elements are dropped along with their whole subtree.
+            fSkipDepth = 1;
+            return false;
         }
 
-        const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                         SkTo<int>(std::size(gTagFactories)),
-                                         elem, sizeof(gTagFactories[0]));
-        if (tagIndex < 0) {
-#if defined(SK_VERBOSE_SVG_PARSING)
-            SkDebugf("unhandled element: <%s>\n", elem);
-#endif
-            return nullptr;
+        fNodeStack.push_back(std::move(node));
+        return false;
+    }
+
+    bool onAddAttribute(const char name[], const char value[]) override {
+        if (fSkipDepth > 0 || fNodeStack.empty()) {
+            return false;
         }
-        SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
 
-        return gTagFactories[tagIndex].fValue();
-    };
+        const auto& node = fNodeStack.back();
 
-    auto node = make_node(ctx, elem);
-    if (!node) {
-        return nullptr;
+        // We're handling id attributes out of band for now.
+        if (!strcmp(name, "id")) {
+            fIDMapper->set(SkString(value), node);
+            return false;
+        }
+        set_string_attribute(node, name, value);
+
+        return false;
     }
 
-    parse_node_attributes(dom, xmlNode, node, ctx.fIDMapper);
+    bool onEndElement(const char[]) override {
+        if (fSkipDepth > 0) {
+            fSkipDepth--;
+            return false;
+        }
+
+        SkASSERT(!fNodeStack.empty());
+        auto node = std::move(fNodeStack.back());
+        fNodeStack.pop_back();
+
+        // Children are attached once fully constructed.
+        if (fNodeStack.empty()) {
+            fRoot = std::move(node);
+        } else {
+            fNodeStack.back()->appendChild(std::move(node));
+        }
+
+        return false;
+    }
 
-    ConstructionContext localCtx(ctx, node);
-    for (auto* child = dom.getFirstChild(xmlNode, nullptr); child;
-         child = dom.getNextSibling(child)) {
-        sk_sp<SkSVGNode> childNode = construct_svg_node(dom, localCtx, child);
-        if (childNode) {
-            node->appendChild(std::move(childNode));
+    bool onText(const char text[], int len) override {
+        if (fSkipDepth > 0 || fNodeStack.empty()) {
+            return false;
         }
+
+        // Text literals require special handling.
+        auto txt = SkSVGTextLiteral::Make();
+        txt->setText(SkString(text, SkTo<size_t>(len)));
+        fNodeStack.back()->appendChild(std::move(txt));
+
+        return false;
     }
 
-    return node;
-}
+private:
+    SkSVGIDMapper*                fIDMapper;
+    std::vector<sk_sp<SkSVGNode>> fNodeStack;  // currently open elements
+    sk_sp<SkSVGNode>              fRoot;
+    int                           fSkipDepth = 0;
+};
 
 } // anonymous namespace
 
@@ -411,17 +447,20 @@ SkSVGDOM::Builder& SkSVGDOM::Builder::setTextShapingFactory(sk_sp<SkShapers::Fac
     return *this;
 }
 
+SkSVGDOM::Builder& SkSVGDOM::Builder::setRenderCaching(bool enable) {
+    fRenderCaching = enable;
+    return *this;
+}
+
 sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
-    SkDOM xmlDom;
-    if (!xmlDom.build(str)) {
+    SkSVGIDMapper mapper;
+    SVGNodeBuilder builder(&mapper);
+    if (!builder.parse(str)) {
         return nullptr;
     }
 
-    SkSVGIDMapper mapper;
-    ConstructionContext ctx(&mapper);
-
-    auto root = construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
+    auto root = builder.detachRoot();
     if (!root || root->tag() != SkSVGTag::kSvg) {
         return nullptr;
     }
@@ -439,26 +478,75 @@ sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
                                         std::move(fFontMgr),
                                         std::move(resource_provider),
                                         std::move(mapper),
-                                        std::move(factory)));
+                                        std::move(factory),
+                                        fRenderCaching));
 }
 
 SkSVGDOM::SkSVGDOM(sk_sp<SkSVGSVG> root,
                    sk_sp<SkFontMgr> fmgr,
                    sk_sp<skresources::ResourceProvider> rp,
                    SkSVGIDMapper&& mapper,
-                   sk_sp<SkShapers::Factory> fact)
+                   sk_sp<SkShapers::Factory> fact,
+                   bool renderCaching)
         : fRoot(std::move(root))
         , fFontMgr(std::move(fmgr))
         , fTextShapingFactory(std::move(fact))
         , fResourceProvider(std::move(rp))
         , fIDMapper(std::move(mapper))
-        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0)))) {
+        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0))))
+        , fRenderCaching(renderCaching) {
     SkASSERT(fResourceProvider);
     SkASSERT(fTextShapingFactory);
+
+    // Parsing is done: from here on, node mutations invalidate the cached render.
+    if (fRenderCaching && fRoot) {
+        fGenerationID = sk_make_sp<SkSVGGenerationID>();
+        fRoot->setGenerationID(fGenerationID);
+    }
 }
 
+SkSVGDOM::~SkSVGDOM() = default;
+
 void SkSVGDOM::render(SkCanvas* canvas) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
+
+    if (fRenderCaching) {
+        if (auto picture = this->cachedPicture()) {
+            canvas->drawPicture(picture);
+        }
+        return;
+    }
+
+    this->renderUncached(canvas);
+}
+
+sk_sp<SkPicture> SkSVGDOM::cachedPicture() const {
+    if (!fRoot) {
+        return nullptr;
+    }
+
+    // Read before recording: mutations from here on must invalidate the new picture.
+    const auto generation_id = fGenerationID->value();
+
+    SkAutoMutexExclusive lock(fCacheMutex);
+    if (!fCachedPicture ||
+        fCachedGenerationID  != generation_id ||
+        fCachedContainerSize != fContainerSize) {
+        TRACE_EVENT0("skia", "SkSVGDOM::recordPicture");
+
+        // Content is not necessarily clipped to the root viewport: record unbounded.
+        SkPictureRecorder recorder;
+        this->renderUncached(recorder.beginRecording(SkRectPriv::MakeLargeS32()));
+
+        fCachedPicture       = recorder.finishRecordingAsPicture();
+        fCachedGenerationID  = generation_id;
+        fCachedContainerSize = fContainerSize;
+    }
+
+    return fCachedPicture;
+}
+
+void SkSVGDOM::renderUncached(SkCanvas* canvas) const {
     if (fRoot) {
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
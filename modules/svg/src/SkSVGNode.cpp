@@ -14,6 +14,8 @@
 #include "modules/svg/include/SkSVGValue.h"
 #include "src/base/SkTLazy.h"
 
+#include <utility>
+
 SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
     // Uninherited presentation attributes need a non-null default value.
     fPresentationAttributes.fStopColor.set(SkSVGColor(SK_ColorBLACK));
@@ -25,6 +27,10 @@ SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
 
 SkSVGNode::~SkSVGNode() { }
 
+void SkSVGNode::setGenerationID(sk_sp<SkSVGGenerationID> id) {
+    fGenerationID = std::move(id);
+}
+
 void SkSVGNode::render(const SkSVGRenderContext& ctx) const {
     SkSVGRenderContext localContext(ctx, this);
 
@@ -73,6 +79,7 @@ bool SkSVGNode::onPrepareToRender(SkSVGRenderContext* ctx) const {
 }
 
 void SkSVGNode::setAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
+    this->bumpGenerationID();
     this->onSetAttribute(attr, v);
 }
 
@@ -550,6 +550,10 @@ void SkSVGTextContainer::appendChild(sk_sp<SkSVGNode> child) {
     case SkSVGTag::kTextLiteral:
     case SkSVGTag::kTextPath:
     case SkSVGTag::kTSpan:
+        this->bumpGenerationID();
+        if (const auto& id = this->generationID()) {
+            child->setGenerationID(id);
+        }
         fChildren.push_back(
             sk_sp<SkSVGTextFragment>(static_cast<SkSVGTextFragment*>(child.release())));
         break;
@@ -558,6 +562,13 @@ void SkSVGTextContainer::appendChild(sk_sp<SkSVGNode> child) {
     }
 }
 
+void SkSVGTextContainer::setGenerationID(sk_sp<SkSVGGenerationID> id) {
+    for (const auto& child : fChildren) {
+        child->setGenerationID(id);
+    }
+    INHERITED::setGenerationID(std::move(id));
+}
+
 void SkSVGTextContainer::onShapeText(const SkSVGRenderContext& ctx, SkSVGTextContext* tctx,
                                      SkSVGXmlSpace) const {
     SkASSERT(tctx);
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <string>
+
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGRect.h"
+#include "modules/svg/include/SkSVGSVG.h"
+#include "tests/Test.h"
+
+static sk_sp<SkSVGDOM> make_dom(const std::string& svgText) {
+    auto str = SkMemoryStream::MakeDirect(svgText.c_str(), svgText.size());
+    return SkSVGDOM::Builder().make(*str);
+}
+
+DEF_TEST(Svg_Parse_Structure, r) {
+    auto dom = make_dom(R"EOF(
+    <svg width="100" height="100" xmlns="http://www.w3.org/2000/svg">
+        <foo id="unknown">
+            <rect id="unknown_child" width="10" height="10"/>
+        </foo>
+        <g id="g" style="opacity: 0.5; fill: red" transform="translate(1 2)">
+            <rect id="r" x="3" y="4" width="10" height="10"/>
+            <svg id="inner"/>
+        </g>
+        <text id="t">Hello <tspan id="ts">World</tspan></text>
+    </svg>
+    )EOF");
+    REPORTER_ASSERT(r, dom);
+    REPORTER_ASSERT(r, dom->getRoot()->tag() == SkSVGTag::kSvg);
+
+    // Unsupported elements are dropped along with their subtree.
+    REPORTER_ASSERT(r, !dom->findNodeById("unknown"));
+    REPORTER_ASSERT(r, !dom->findNodeById("unknown_child"));
+
+    auto check_tag = [&](const char* id, SkSVGTag tag) -> SkSVGNode* {
+        auto* node = dom->findNodeById(id);
+        REPORTER_ASSERT(r, node && *node && (*node)->tag() == tag, "%s", id);
+        return node && *node ? node->get() : nullptr;
+    };
+
+    if (auto* g = check_tag("g", SkSVGTag::kG)) {
+        // Style declarations are expanded into individual attributes.
+        REPORTER_ASSERT(r, g->getOpacity().isValue() && *g->getOpacity() == 0.5f);
+        REPORTER_ASSERT(r, g->getFill().isValue() &&
+                           *g->getFill() == SkSVGPaint(SkSVGColor(SK_ColorRED)));
+    }
+    if (auto* rect = static_cast<SkSVGRect*>(check_tag("r", SkSVGTag::kRect))) {
+        REPORTER_ASSERT(r, rect->getX() == SkSVGLength(3));
+        REPORTER_ASSERT(r, rect->getY() == SkSVGLength(4));
+    }
+    check_tag("inner", SkSVGTag::kSvg);
+    check_tag("t"    , SkSVGTag::kText);
+    check_tag("ts"   , SkSVGTag::kTSpan);
+}
+
+DEF_TEST(Svg_Parse_InvalidRoot, r) {
+    REPORTER_ASSERT(r, !make_dom(R"(<g xmlns="http://www.w3.org/2000/svg"/>)"));
+    REPORTER_ASSERT(r, !make_dom(R"(<foo><svg xmlns="http://www.w3.org/2000/svg"/></foo>)"));
+    REPORTER_ASSERT(r, !make_dom(R"(<svg xmlns="http://www.w3.org/2000/svg"><g></svg>)"));
+    REPORTER_ASSERT(r, !make_dom(""));
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGRect.h"
+#include "modules/svg/include/SkSVGSVG.h"
+#include "tests/Test.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+static sk_sp<SkSVGDOM> make_dom(const std::string& svgText, bool caching) {
+    auto str = SkMemoryStream::MakeDirect(svgText.c_str(), svgText.size());
+    return SkSVGDOM::Builder().setRenderCaching(caching).make(*str);
+}
+
+DEF_TEST(Svg_RenderCache, r) {
+    const std::string svgText = R"EOF(
+    <svg width="100%" height="100%" viewBox="0 0 10 10" xmlns="http://www.w3.org/2000/svg"
+         xmlns:xlink="http://www.w3.org/1999/xlink">
+        <defs>
+            <linearGradient id="g">
+                <stop offset="0" stop-color="green"/>
+                <stop offset="1" stop-color="blue"/>
+            </linearGradient>
+            <rect id="r" x="0" y="0" width="5" height="10" fill="red"/>
+        </defs>
+        <use xlink:href="#r"/>
+        <rect x="5" y="0" width="5" height="10" fill="url(#g)" opacity="0.5"/>
+    </svg>
+    )EOF";
+
+    auto cached   = make_dom(svgText, true),
+         uncached = make_dom(svgText, false);
+    REPORTER_ASSERT(r, cached && uncached);
+
+    auto check = [&](SkSize containerSize, float scale) {
+        cached->setContainerSize(containerSize);
+        uncached->setContainerSize(containerSize);
+
+        SkBitmap expected, actual;
+        expected.allocN32Pixels(64, 64);
+        actual.allocN32Pixels(64, 64);
+        expected.eraseColor(SK_ColorTRANSPARENT);
+        actual.eraseColor(SK_ColorTRANSPARENT);
+
+        SkCanvas expected_canvas(expected),
+                 actual_canvas(actual);
+        expected_canvas.scale(scale, scale);
+        actual_canvas.scale(scale, scale);
+        uncached->render(&expected_canvas);
+        cached->render(&actual_canvas);
+
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                REPORTER_ASSERT(r, expected.getColor(x, y) == actual.getColor(x, y));
+            }
+        }
+
+        return actual.getColor(1, 1);
+    };
+
+    REPORTER_ASSERT(r, check({32, 32}, 1) == SK_ColorRED);
+
+    // The cached picture replays at any scale.
+    REPORTER_ASSERT(r, check({32, 32}, 1) == SK_ColorRED);
+    REPORTER_ASSERT(r, check({32, 32}, 2) == SK_ColorRED);
+
+    // Container size changes re-record.
+    REPORTER_ASSERT(r, check({64, 64}, 1) == SK_ColorRED);
+
+    // As do node mutations, including referenced nodes.
+    for (const auto& dom : {cached, uncached}) {
+        auto* node = dom->findNodeById("r");
+        REPORTER_ASSERT(r, node && *node);
+        REPORTER_ASSERT(r, (*node)->setAttribute("fill", "blue"));
+    }
+    REPORTER_ASSERT(r, check({64, 64}, 1) == SK_ColorBLUE);
+
+    // Appending nodes re-records, and appended nodes invalidate the cache when mutated.
+    std::vector<sk_sp<SkSVGRect>> rects;
+    for (const auto& dom : {cached, uncached}) {
+        auto rect = SkSVGRect::Make();
+        REPORTER_ASSERT(r, rect->setAttribute("width", "2"));
+        REPORTER_ASSERT(r, rect->setAttribute("height", "2"));
+        REPORTER_ASSERT(r, rect->setAttribute("fill", "yellow"));
+        dom->getRoot()->appendChild(rect);
+        rects.push_back(std::move(rect));
+    }
+    REPORTER_ASSERT(r, check({64, 64}, 1) == SK_ColorYELLOW);
+
+    for (const auto& rect : rects) {
+        REPORTER_ASSERT(r, rect->setAttribute("fill", "black"));
+    }
+    REPORTER_ASSERT(r, check({64, 64}, 1) == SK_ColorBLACK);
+}
@@ -407,6 +407,7 @@ BASE_SRCS_ALL = [
     "src/core/SkBlitter_A8.h",
     "src/core/SkBlitter_ARGB32.cpp",
     "src/core/SkBlitter_Sprite.cpp",
+    "src/core/SkBlurEngine.cpp",
     "src/core/SkBlurEngine.h",
     "src/core/SkBlurMask.cpp",
     "src/core/SkBlurMask.h",
@@ -526,6 +527,8 @@ BASE_SRCS_ALL = [
     "src/core/SkMask.h",
     "src/core/SkMaskBlurFilter.cpp",
     "src/core/SkMaskBlurFilter.h",
+    "src/core/SkMaskBlurFilter_opts.cpp",
+    "src/core/SkMaskBlurFilter_opts_hsw.cpp",
     "src/core/SkMaskCache.cpp",
     "src/core/SkMaskCache.h",
     "src/core/SkMaskFilter.cpp",
@@ -1297,6 +1300,7 @@ BASE_SRCS_ALL = [
     "src/opts/SkBitmapProcState_opts.h",
     "src/opts/SkBlitMask_opts.h",
     "src/opts/SkBlitRow_opts.h",
+    "src/opts/SkMaskBlurFilter_opts.h",
     "src/opts/SkMemset_opts.h",
     "src/opts/SkOpts_RestoreTarget.h",
     "src/opts/SkOpts_SetTarget.h",
@@ -2318,6 +2322,7 @@ MACOS_DEFINES = [
 ################################################################################
 
 SKSG_LIB_HDRS = [
+    "modules/sksg/include/SkSGCacheEffect.h",
     "modules/sksg/include/SkSGClipEffect.h",
     "modules/sksg/include/SkSGColorFilter.h",
     "modules/sksg/include/SkSGDraw.h",
@@ -2344,6 +2349,7 @@ SKSG_LIB_HDRS = [
 ]
 
 SKSG_LIB_SRCS = [
+    "modules/sksg/src/SkSGCacheEffect.cpp",
     "modules/sksg/src/SkSGClipEffect.cpp",
     "modules/sksg/src/SkSGColorFilter.cpp",
     "modules/sksg/src/SkSGDraw.cpp",
@@ -2615,6 +2621,7 @@ SKSHAPER_HDRS = [
 
 SKSHAPER_HARFBUZZ_SRCS = [
     "modules/skshaper/src/SkShaper.cpp",
+    "modules/skshaper/src/SkShaper_cache.cpp",
     "modules/skshaper/src/SkShaper_factory.cpp",
     "modules/skshaper/src/SkShaper_harfbuzz.cpp",
     "modules/skshaper/src/SkShaper_primitive.cpp",
@@ -2623,6 +2630,7 @@ SKSHAPER_HARFBUZZ_SRCS = [
 
 SKSHAPER_CORETEXT_SRCS = [
     "modules/skshaper/src/SkShaper.cpp",
+    "modules/skshaper/src/SkShaper_cache.cpp",
     "modules/skshaper/src/SkShaper_coretext.cpp",
     "modules/skshaper/src/SkShaper_factory.cpp",
     "modules/skshaper/src/SkShaper_primitive.cpp",
@@ -2630,6 +2638,7 @@ SKSHAPER_CORETEXT_SRCS = [
 
 SKSHAPER_PRIMITIVE_SRCS = [
     "modules/skshaper/src/SkShaper.cpp",
+    "modules/skshaper/src/SkShaper_cache.cpp",
     "modules/skshaper/src/SkShaper_factory.cpp",
     "modules/skshaper/src/SkShaper_primitive.cpp",
 ]
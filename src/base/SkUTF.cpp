@@ -4,6 +4,10 @@
 #include "src/base/SkUTF.h"
 
 #include "include/private/base/SkTFitsIn.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
+
+#include <algorithm>
 
 static constexpr inline int32_t left_shift(int32_t value, int32_t shift) {
     return (int32_t) ((uint32_t) value << shift);
@@ -42,6 +46,51 @@ static bool utf8_type_is_valid_leading_byte(int type) { return type > 0; }
 
 static bool utf8_byte_is_continuation(uint8_t c) { return utf8_byte_type(c) == 0; }
 
+// Most text is mostly ASCII, which needs no decoding. These find and convert runs of it 16 bytes
+// (or 8 UTF-16 code units) at a time.
+
+/** @returns the number of ASCII bytes at the start of [src, stop). */
+static size_t utf8_ascii_prefix(const uint8_t* src, const uint8_t* stop) {
+    const uint8_t* p = src;
+    while (stop - p >= 16 && !any(skvx::byte16::Load(p) >= 0x80)) {
+        p += 16;
+    }
+    while (p < stop && *p < 0x80) {
+        ++p;
+    }
+    return SkToSizeT(p - src);
+}
+
+/** @returns the number of ASCII code units at the start of [src, stop). */
+static size_t utf16_ascii_prefix(const uint16_t* src, const uint16_t* stop) {
+    const uint16_t* p = src;
+    while (stop - p >= 8 && !any(skvx::ushort8::Load(p) >= 0x80)) {
+        p += 8;
+    }
+    while (p < stop && *p < 0x80) {
+        ++p;
+    }
+    return SkToSizeT(p - src);
+}
+
+static void widen_ascii(uint16_t dst[], const uint8_t src[], size_t count) {
+    for (; count >= 16; count -= 16, src += 16, dst += 16) {
+        skvx::cast<uint16_t>(skvx::byte16::Load(src)).store(dst);
+    }
+    while (count --> 0) {
+        *dst++ = *src++;
+    }
+}
+
+static void narrow_ascii(char dst[], const uint16_t src[], size_t count) {
+    for (; count >= 8; count -= 8, src += 8, dst += 8) {
+        skvx::cast<uint8_t>(skvx::ushort8::Load(src)).store(dst);
+    }
+    while (count --> 0) {
+        *dst++ = (char)*src++;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int SkUTF::CountUTF8(const char* utf8, size_t byteLength) {
@@ -51,6 +100,12 @@ int SkUTF::CountUTF8(const char* utf8, size_t byteLength) {
     int count = 0;
     const char* stop = utf8 + byteLength;
     while (utf8 < stop) {
+        if (*(const uint8_t*)utf8 < 0x80) {
+            size_t ascii = utf8_ascii_prefix((const uint8_t*)utf8, (const uint8_t*)stop);
+            utf8 += ascii;
+            count += SkToInt(ascii);
+            continue;
+        }
         int type = utf8_byte_type(*(const uint8_t*)utf8);
         if (!utf8_type_is_valid_leading_byte(type) || utf8 + type > stop) {
             return -1;  // Sequence extends beyond end.
@@ -75,6 +130,12 @@ int SkUTF::CountUTF16(const uint16_t* utf16, size_t byteLength) {
     const uint16_t* stop = src + (byteLength >> 1);
     int count = 0;
     while (src < stop) {
+        // Skip over runs without surrogates, which are one code point per code unit.
+        if (stop - src >= 8 && !any((skvx::ushort8::Load(src) & 0xF800) == 0xD800)) {
+            src += 8;
+            count += 8;
+            continue;
+        }
         unsigned c = *src++;
         if (utf16_is_low_surrogate(c)) {
             return -1;
@@ -265,6 +326,18 @@ int SkUTF::UTF8ToUTF16(uint16_t dst[], int dstCapacity, const char src[], size_t
     uint16_t* endDst = dst + dstCapacity;
     const char* endSrc = src + srcByteLength;
     while (src < endSrc) {
+        if (*(const uint8_t*)src < 0x80) {
+            size_t ascii = utf8_ascii_prefix((const uint8_t*)src, (const uint8_t*)endSrc);
+            if (dst) {
+                size_t copy = std::min(ascii, SkToSizeT(endDst - dst));
+                widen_ascii(dst, (const uint8_t*)src, copy);
+                dst += copy;
+            }
+            src += ascii;
+            dstLength += SkToInt(ascii);
+            continue;
+        }
+
         SkUnichar uni = NextUTF8(&src, endSrc);
         if (uni < 0) {
             return -1;
@@ -297,9 +370,26 @@ int SkUTF::UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], size_t
     const char* endDst = dst + dstCapacity;
     const uint16_t* endSrc = src + srcLength;
     while (src < endSrc) {
-        SkUnichar uni = NextUTF16(&src, endSrc);
-        if (uni < 0) {
-            return -1;
+        if (*src < 0x80) {
+            size_t ascii = utf16_ascii_prefix(src, endSrc);
+            if (dst) {
+                size_t copy = std::min(ascii, SkToSizeT(endDst - dst));
+                narrow_ascii(dst, src, copy);
+                dst += copy;
+            }
+            src += ascii;
+            dstLength += SkToInt(ascii);
+            continue;
+        }
+
+        SkUnichar uni = *src;
+        if (utf16_is_high_surrogate(uni) || utf16_is_low_surrogate(uni)) {
+            uni = NextUTF16(&src, endSrc);
+            if (uni < 0) {
+                return -1;
+            }
+        } else {
+            ++src;
         }
 
         char utf8[SkUTF::kMaxBytesInUTF8Sequence];
@@ -319,3 +409,50 @@ int SkUTF::UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], size_t
     }
     return dstLength;
 }
+
+int SkUTF::UTF8ToUTF16Indices(const char src[], size_t srcByteLength,
+                              size_t utf8IndexForUTF16Index[],
+                              size_t utf16IndexForUTF8Index[]) {
+    if (!src && srcByteLength) {
+        return -1;
+    }
+    const uint8_t* start = (const uint8_t*)src;
+    const uint8_t* stop = start + srcByteLength;
+    const uint8_t* p = start;
+    size_t utf8Index = 0;
+    size_t utf16Index = 0;
+    while (p < stop) {
+        if (*p < 0x80) {
+            // Both indices advance together
+            size_t ascii = utf8_ascii_prefix(p, stop);
+            for (size_t i = 0; i < ascii; ++i) {
+                utf8IndexForUTF16Index[utf16Index + i] = utf8Index + i;
+                utf16IndexForUTF8Index[utf8Index + i] = utf16Index + i;
+            }
+            p += ascii;
+            utf8Index += ascii;
+            utf16Index += ascii;
+            continue;
+        }
+
+        const char* next = (const char*)p;
+        SkUnichar uni = NextUTF8(&next, (const char*)stop);
+        size_t utf16Count = ToUTF16(uni);
+        if (uni < 0 || utf16Count == 0) {
+            return -1;
+        }
+        const size_t utf8Count = SkToSizeT((const uint8_t*)next - p);
+        for (size_t i = 0; i < utf8Count; ++i) {
+            utf16IndexForUTF8Index[utf8Index + i] = utf16Index;
+        }
+        for (size_t i = 0; i < utf16Count; ++i) {
+            utf8IndexForUTF16Index[utf16Index + i] = utf8Index;
+        }
+        p += utf8Count;
+        utf8Index += utf8Count;
+        utf16Index += utf16Count;
+    }
+    utf8IndexForUTF16Index[utf16Index] = utf8Index;
+    utf16IndexForUTF8Index[utf8Index] = utf16Index;
+    return SkToInt(utf16Index);
+}
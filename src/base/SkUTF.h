@@ -84,6 +84,17 @@ SK_SPI int UTF8ToUTF16(uint16_t dst[], int dstCapacity, const char src[], size_t
  */
 SK_SPI int UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], size_t srcLength);
 
+/** Fills the maps between the indices of the src utf8 sequence and of its UTF-16 conversion,
+ *  including the indices one past the end of each. Every code unit maps to the first code unit
+ *  of its code point in the other encoding. utf16IndexForUTF8Index must have room for
+ *  srcByteLength + 1 values, and so must utf8IndexForUTF16Index, since the UTF-16 conversion is
+ *  never longer than its source. Returns the number of UTF-16 values, or -1 if src is invalid
+ *  UTF-8, in which case the maps are undefined.
+ */
+SK_SPI int UTF8ToUTF16Indices(const char src[], size_t srcByteLength,
+                              size_t utf8IndexForUTF16Index[],
+                              size_t utf16IndexForUTF8Index[]);
+
 /**
  * Given a UTF-16 code point, returns true iff it is a leading surrogate.
  * https://unicode.org/faq/utf_bom.html#utf16-2
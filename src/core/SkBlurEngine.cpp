@@ -0,0 +1,1152 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkBlurEngine.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkTileMode.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/base/SkMathPriv.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE1
+    #include <xmmintrin.h>
+    #define SK_PREFETCH(ptr) _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0)
+#elif defined(__GNUC__)
+    #define SK_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+    #define SK_PREFETCH(ptr)
+#endif
+
+// TODO(b/294575803): Provide a more accurate CPU implementation at s<2, at which point the notion
+// of an identity sigma can be consolidated between the different functions.
+// This is defined by the SVG spec:
+// https://drafts.fxtf.org/filter-effects/#feGaussianBlurElement
+int SkBlurEngine::BoxBlurWindow(double sigma) {
+    auto possibleWindow = static_cast<int>(floor(sigma * 3 * sqrt(2 * SK_DoublePI) / 4 + 0.5));
+    return std::max(1, possibleWindow);
+}
+
+namespace {
+
+// The raster blurs work on 4 channels of 8 bits, with the alpha in the high byte. Only N32 is
+// supported for now.
+static constexpr SkColorType kRasterBlurColorType = kN32_SkColorType;
+
+// Half of an 8-bit step.
+static constexpr float kDefaultTolerance = 0.5f;
+
+// The largest sigma any raster algorithm accepts, which is also SkBlurImageFilter's limit. Larger
+// sigmas must be handled by the caller downscaling, as SkBlurEngine describes.
+static constexpr float kMaxRasterSigma = 532.f;
+
+// Runs 'fn' over [0, count), split into bands that run in parallel on 'executor' if there is one.
+// Items are independent rows or columns of about 'itemSize' pixels; small jobs are not worth the
+// task overhead and run directly.
+void parallel_for(SkExecutor* executor, int count, int64_t itemSize,
+                  const std::function<void(int start, int end)>& fn) {
+    static constexpr int64_t kMinBandPixels = 128 * 128;
+    static constexpr int64_t kMaxBands      = 32;
+
+    const int bandCount = static_cast<int>(std::min({
+            count * itemSize / kMinBandPixels,
+            kMaxBands,
+            static_cast<int64_t>(count)}));
+    if (!executor || bandCount < 2) {
+        fn(0, count);
+        return;
+    }
+
+    const int itemsPerBand = (count + bandCount - 1) / bandCount;
+    SkTaskGroup tg(*executor);
+    tg.batch(bandCount, [&](int i) {
+        const int start = i * itemsPerBand,
+                  end   = std::min(start + itemsPerBand, count);
+        if (start < end) {
+            fn(start, end);
+        }
+    });
+    tg.wait();
+}
+
+// Rounds towards negative infinity; 'd' must be positive.
+int floor_div(int n, int d) {
+    SkASSERT(d > 0);
+    return n >= 0 ? n / d : -((-n + d - 1) / d);
+}
+
+int ceil_div(int n, int d) {
+    return -floor_div(-n, d);
+}
+
+SkBitmap make_transparent(const SkImageInfo& info) {
+    SkBitmap bitmap;
+    if (bitmap.tryAllocPixels(info)) {
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+    }
+    return bitmap;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Triple box blur
+
+class Pass {
+public:
+    explicit Pass(int border) : fBorder(border) {}
+    virtual ~Pass() = default;
+
+    void blur(int srcLeft, int srcRight, int dstRight,
+              const uint32_t* src, int srcStride,
+              uint32_t* dst, int dstStride) {
+        this->startBlur();
+
+        auto srcStart = srcLeft - fBorder,
+                srcEnd   = srcRight - fBorder,
+                dstEnd   = dstRight,
+                srcIdx   = srcStart,
+                dstIdx   = 0;
+
+        const uint32_t* srcCursor = src;
+        uint32_t* dstCursor = dst;
+
+        if (dstIdx < srcIdx) {
+            // The destination pixels are not effected by the src pixels,
+            // change to zero as per the spec.
+            // https://drafts.fxtf.org/filter-effects/#FilterPrimitivesOverviewIntro
+            int commonEnd = std::min(srcIdx, dstEnd);
+            while (dstIdx < commonEnd) {
+                *dstCursor = 0;
+                dstCursor += dstStride;
+                SK_PREFETCH(dstCursor);
+                dstIdx++;
+            }
+        } else if (srcIdx < dstIdx) {
+            // The edge of the source is before the edge of the destination. Calculate the sums for
+            // the pixels before the start of the destination.
+            if (int commonEnd = std::min(dstIdx, srcEnd); srcIdx < commonEnd) {
+                // Preload the blur with values from src before dst is entered.
+                int n = commonEnd - srcIdx;
+                this->blurSegment(n, srcCursor, srcStride, nullptr, 0);
+                srcIdx += n;
+                srcCursor += n * srcStride;
+            }
+            if (srcIdx < dstIdx) {
+                // The weird case where src is out of pixels before dst is even started.
+                int n = dstIdx - srcIdx;
+                this->blurSegment(n, nullptr, 0, nullptr, 0);
+                srcIdx += n;
+            }
+        }
+
+        if (int commonEnd = std::min(dstEnd, srcEnd); dstIdx < commonEnd) {
+            // Both srcIdx and dstIdx are in sync now, and can run in a 1:1 fashion. This is the
+            // normal mode of operation.
+            SkASSERT(srcIdx == dstIdx);
+
+            int n = commonEnd - dstIdx;
+            this->blurSegment(n, srcCursor, srcStride, dstCursor, dstStride);
+            srcCursor += n * srcStride;
+            dstCursor += n * dstStride;
+            dstIdx += n;
+            srcIdx += n;
+        }
+
+        // Drain the remaining blur values into dst assuming 0's for the leading edge.
+        if (dstIdx < dstEnd) {
+            int n = dstEnd - dstIdx;
+            this->blurSegment(n, nullptr, 0, dstCursor, dstStride);
+        }
+    }
+
+protected:
+    virtual void startBlur() = 0;
+    virtual void blurSegment(
+            int n, const uint32_t* src, int srcStride, uint32_t* dst, int dstStride) = 0;
+
+private:
+    const int fBorder;
+};
+
+class PassMaker {
+public:
+    explicit PassMaker(int window) : fWindow{window} {}
+    virtual ~PassMaker() = default;
+    virtual Pass* makePass(void* buffer, SkArenaAlloc* alloc) const = 0;
+    virtual size_t bufferSizeBytes() const = 0;
+    int window() const {return fWindow;}
+
+private:
+    const int fWindow;
+};
+
+// Implement a scanline processor that uses a three-box filter to approximate a Gaussian blur.
+// The GaussPass is limit to processing sigmas < 135.
+class GaussPass final : public Pass {
+public:
+    // NB 136 is the largest sigma that will not cause a buffer full of 255 mask values to overflow
+    // using the Gauss filter. It also limits the size of buffers used hold intermediate values.
+    // Explanation of maximums:
+    //   sum0 = window * 255
+    //   sum1 = window * sum0 -> window * window * 255
+    //   sum2 = window * sum1 -> window * window * window * 255 -> window^3 * 255
+    //
+    //   The value window^3 * 255 must fit in a uint32_t. So,
+    //      window^3 < 2^32. window = 255.
+    //
+    //   window = floor(sigma * 3 * sqrt(2 * kPi) / 4 + 0.5)
+    //   For window <= 255, the largest value for sigma is 136.
+    static PassMaker* MakeMaker(int window, SkArenaAlloc* alloc) {
+        SkASSERT(0 < window);
+        if (255 <= window) {
+            return nullptr;
+        }
+
+        class Maker : public PassMaker {
+        public:
+            explicit Maker(int window) : PassMaker{window} {}
+            Pass* makePass(void* buffer, SkArenaAlloc* alloc) const override {
+                return GaussPass::Make(this->window(), buffer, alloc);
+            }
+
+            size_t bufferSizeBytes() const override {
+                int window = this->window();
+                size_t onePassSize = window - 1;
+                // If the window is odd, then there is an obvious middle element. For even sizes
+                // 2 passes are shifted, and the last pass has an extra element. Like this:
+                //       S
+                //    aaaAaa
+                //     bbBbbb
+                //    cccCccc
+                //       D
+                size_t bufferCount = (window & 1) == 1 ? 3 * onePassSize : 3 * onePassSize + 1;
+                return bufferCount * sizeof(skvx::Vec<4, uint32_t>);
+            }
+        };
+
+        return alloc->make<Maker>(window);
+    }
+
+    static GaussPass* Make(int window, void* buffers, SkArenaAlloc* alloc) {
+        // We don't need to store the trailing edge pixel in the buffer;
+        int passSize = window - 1;
+        skvx::Vec<4, uint32_t>* buffer0 = static_cast<skvx::Vec<4, uint32_t>*>(buffers);
+        skvx::Vec<4, uint32_t>* buffer1 = buffer0 + passSize;
+        skvx::Vec<4, uint32_t>* buffer2 = buffer1 + passSize;
+        // If the window is odd just one buffer is needed, but if it's even, then there is one
+        // more element on that pass.
+        skvx::Vec<4, uint32_t>* buffersEnd = buffer2 + ((window & 1) ? passSize : passSize + 1);
+
+        // Calculating the border is tricky. The border is the distance in pixels between the first
+        // dst pixel and the first src pixel (or the last src pixel and the last dst pixel).
+        // I will go through the odd case which is simpler, and then through the even case. Given a
+        // stack of filters seven wide for the odd case of three passes.
+        //
+        //        S
+        //     aaaAaaa
+        //     bbbBbbb
+        //     cccCccc
+        //        D
+        //
+        // The furthest changed pixel is when the filters are in the following configuration.
+        //
+        //                 S
+        //           aaaAaaa
+        //        bbbBbbb
+        //     cccCccc
+        //        D
+        //
+        // The A pixel is calculated using the value S, the B uses A, and the C uses B, and
+        // finally D is C. So, with a window size of seven the border is nine. In the odd case, the
+        // border is 3*((window - 1)/2).
+        //
+        // For even cases the filter stack is more complicated. The spec specifies two passes
+        // of even filters and a final pass of odd filters. A stack for a width of six looks like
+        // this.
+        //
+        //       S
+        //    aaaAaa
+        //     bbBbbb
+        //    cccCccc
+        //       D
+        //
+        // The furthest pixel looks like this.
+        //
+        //               S
+        //          aaaAaa
+        //        bbBbbb
+        //    cccCccc
+        //       D
+        //
+        // For a window of six, the border value is eight. In the even case the border is 3 *
+        // (window/2) - 1.
+        int border = (window & 1) == 1 ? 3 * ((window - 1) / 2) : 3 * (window / 2) - 1;
+
+        // If the window is odd then the divisor is just window ^ 3 otherwise,
+        // it is window * window * (window + 1) = window ^ 3 + window ^ 2;
+        int window2 = window * window;
+        int window3 = window2 * window;
+        int divisor = (window & 1) == 1 ? window3 : window3 + window2;
+        return alloc->make<GaussPass>(buffer0, buffer1, buffer2, buffersEnd, border, divisor);
+    }
+
+    GaussPass(skvx::Vec<4, uint32_t>* buffer0,
+              skvx::Vec<4, uint32_t>* buffer1,
+              skvx::Vec<4, uint32_t>* buffer2,
+              skvx::Vec<4, uint32_t>* buffersEnd,
+              int border,
+              int divisor)
+        : Pass{border}
+        , fBuffer0{buffer0}
+        , fBuffer1{buffer1}
+        , fBuffer2{buffer2}
+        , fBuffersEnd{buffersEnd}
+        , fDivider(divisor) {}
+
+private:
+    void startBlur() override {
+        skvx::Vec<4, uint32_t> zero = {0u, 0u, 0u, 0u};
+        zero.store(fSum0);
+        zero.store(fSum1);
+        auto half = fDivider.half();
+        skvx::Vec<4, uint32_t>{half, half, half, half}.store(fSum2);
+        sk_bzero(fBuffer0, (fBuffersEnd - fBuffer0) * sizeof(skvx::Vec<4, uint32_t>));
+
+        fBuffer0Cursor = fBuffer0;
+        fBuffer1Cursor = fBuffer1;
+        fBuffer2Cursor = fBuffer2;
+    }
+
+    // GaussPass implements the common three pass box filter approximation of Gaussian blur,
+    // but combines all three passes into a single pass. This approach is facilitated by three
+    // circular buffers the width of the window which track values for trailing edges of each of
+    // the three passes. This allows the algorithm to use more precision in the calculation
+    // because the values are not rounded each pass. And this implementation also avoids a trap
+    // that's easy to fall into resulting in blending in too many zeroes near the edge.
+    //
+    // In general, a window sum has the form:
+    //     sum_n+1 = sum_n + leading_edge - trailing_edge.
+    // If instead we do the subtraction at the end of the previous iteration, we can just
+    // calculate the sums instead of having to do the subtractions too.
+    //
+    //      In previous iteration:
+    //      sum_n+1 = sum_n - trailing_edge.
+    //
+    //      In this iteration:
+    //      sum_n+1 = sum_n + leading_edge.
+    //
+    // Now we can stack all three sums and do them at once. Sum0 gets its leading edge from the
+    // actual data. Sum1's leading edge is just Sum0, and Sum2's leading edge is Sum1. So, doing the
+    // three passes at the same time has the form:
+    //
+    //    sum0_n+1 = sum0_n + leading edge
+    //    sum1_n+1 = sum1_n + sum0_n+1
+    //    sum2_n+1 = sum2_n + sum1_n+1
+    //
+    //    sum2_n+1 / window^3 is the new value of the destination pixel.
+    //
+    // Reduce the sums by the trailing edges which were stored in the circular buffers for the
+    // next go around. This is the case for odd sized windows, even windows the the third
+    // circular buffer is one larger then the first two circular buffers.
+    //
+    //    sum2_n+2 = sum2_n+1 - buffer2[i];
+    //    buffer2[i] = sum1;
+    //    sum1_n+2 = sum1_n+1 - buffer1[i];
+    //    buffer1[i] = sum0;
+    //    sum0_n+2 = sum0_n+1 - buffer0[i];
+    //    buffer0[i] = leading edge
+    void blurSegment(
+            int n, const uint32_t* src, int srcStride, uint32_t* dst, int dstStride) override {
+        skvx::Vec<4, uint32_t>* buffer0Cursor = fBuffer0Cursor;
+        skvx::Vec<4, uint32_t>* buffer1Cursor = fBuffer1Cursor;
+        skvx::Vec<4, uint32_t>* buffer2Cursor = fBuffer2Cursor;
+        skvx::Vec<4, uint32_t> sum0 = skvx::Vec<4, uint32_t>::Load(fSum0);
+        skvx::Vec<4, uint32_t> sum1 = skvx::Vec<4, uint32_t>::Load(fSum1);
+        skvx::Vec<4, uint32_t> sum2 = skvx::Vec<4, uint32_t>::Load(fSum2);
+
+        // Given an expanded input pixel, move the window ahead using the leadingEdge value.
+        auto processValue = [&](const skvx::Vec<4, uint32_t>& leadingEdge) {
+            sum0 += leadingEdge;
+            sum1 += sum0;
+            sum2 += sum1;
+
+            skvx::Vec<4, uint32_t> blurred = fDivider.divide(sum2);
+
+            sum2 -= *buffer2Cursor;
+            *buffer2Cursor = sum1;
+            buffer2Cursor = (buffer2Cursor + 1) < fBuffersEnd ? buffer2Cursor + 1 : fBuffer2;
+            sum1 -= *buffer1Cursor;
+            *buffer1Cursor = sum0;
+            buffer1Cursor = (buffer1Cursor + 1) < fBuffer2 ? buffer1Cursor + 1 : fBuffer1;
+            sum0 -= *buffer0Cursor;
+            *buffer0Cursor = leadingEdge;
+            buffer0Cursor = (buffer0Cursor + 1) < fBuffer1 ? buffer0Cursor + 1 : fBuffer0;
+
+            return skvx::cast<uint8_t>(blurred);
+        };
+
+        auto loadEdge = [&](const uint32_t* srcCursor) {
+            return skvx::cast<uint32_t>(skvx::Vec<4, uint8_t>::Load(srcCursor));
+        };
+
+        if (!src && !dst) {
+            while (n --> 0) {
+                (void)processValue(0);
+            }
+        } else if (src && !dst) {
+            while (n --> 0) {
+                (void)processValue(loadEdge(src));
+                src += srcStride;
+            }
+        } else if (!src && dst) {
+            while (n --> 0) {
+                processValue(0u).store(dst);
+                dst += dstStride;
+            }
+        } else if (src && dst) {
+            while (n --> 0) {
+                processValue(loadEdge(src)).store(dst);
+                src += srcStride;
+                dst += dstStride;
+            }
+        }
+
+        // Store the state
+        fBuffer0Cursor = buffer0Cursor;
+        fBuffer1Cursor = buffer1Cursor;
+        fBuffer2Cursor = buffer2Cursor;
+
+        sum0.store(fSum0);
+        sum1.store(fSum1);
+        sum2.store(fSum2);
+    }
+
+    skvx::Vec<4, uint32_t>* const fBuffer0;
+    skvx::Vec<4, uint32_t>* const fBuffer1;
+    skvx::Vec<4, uint32_t>* const fBuffer2;
+    skvx::Vec<4, uint32_t>* const fBuffersEnd;
+    const skvx::ScaledDividerU32 fDivider;
+
+    // blur state
+    char fSum0[sizeof(skvx::Vec<4, uint32_t>)];
+    char fSum1[sizeof(skvx::Vec<4, uint32_t>)];
+    char fSum2[sizeof(skvx::Vec<4, uint32_t>)];
+    skvx::Vec<4, uint32_t>* fBuffer0Cursor;
+    skvx::Vec<4, uint32_t>* fBuffer1Cursor;
+    skvx::Vec<4, uint32_t>* fBuffer2Cursor;
+};
+
+// Blurs 'src', whose pixels cover 'srcBounds', into a new bitmap covering 'dstBounds' with the
+// triple box filters of the given widths. Both rectangles are in the same coordinate space, and
+// the pixels outside of 'srcBounds' are transparent. Both windows must be under 255.
+SkBitmap box_blur(SkISize window, const SkBitmap& src, SkIRect srcBounds, SkIRect dstBounds,
+                  SkExecutor* executor) {
+    // The input image should fill the srcBounds
+    SkASSERT(src.width() == srcBounds.width() && src.height() == srcBounds.height());
+
+    SkSTArenaAlloc<256> alloc;
+    auto makeMaker = [&](int window) -> PassMaker* {
+        PassMaker* maker = GaussPass::MakeMaker(window, &alloc);
+        SkASSERT(maker);  // should be guaranteed by findAlgorithm()
+        return maker;
+    };
+
+    PassMaker* makerX = makeMaker(window.width());
+    PassMaker* makerY = makeMaker(window.height());
+
+    auto originalDstBounds = dstBounds;
+    if (makerX->window() > 1) {
+        // Inflate the dst by the window required for the Y pass so that the X pass can prepare it.
+        // The Y pass will be offset to only write to the original rows in dstBounds, but its window
+        // will access these extra rows calculated by the X pass. The returned bitmap is then a
+        // subset that matches 'originalDstBounds' tightly. We make one slightly larger image to
+        // hold this extra data instead of two separate images sized exactly to each pass because
+        // the CPU blur can write in place. Three boxes reach at most 3/2 of a window.
+        dstBounds.outset(0, 3 * makerY->window() / 2);
+    }
+
+    SkBitmap dst = make_transparent(src.info().makeWH(dstBounds.width(), dstBounds.height()));
+    if (dst.drawsNothing()) {
+        return {};
+    }
+    const SkIPoint dstOrigin = dstBounds.topLeft();
+
+    if (makerX->window() <= 1 && makerY->window() <= 1) {
+        // Neither axis is visibly blurred, so the result is just the overlapping source pixels.
+        SkIRect overlap = srcBounds;
+        if (overlap.intersect(dstBounds)) {
+            for (int y = overlap.top(); y < overlap.bottom(); ++y) {
+                memcpy(dst.getAddr32(overlap.left() - dstOrigin.x(), y - dstOrigin.y()),
+                       src.getAddr32(overlap.left() - srcBounds.left(), y - srcBounds.top()),
+                       overlap.width() * sizeof(uint32_t));
+            }
+        }
+        return dst;
+    }
+
+    // Each band of rows or columns runs its own Pass, which owns the running sums.
+    auto makePass = [](const PassMaker* maker, SkArenaAlloc* bandAlloc) {
+        void* buffer = bandAlloc->makeBytesAlignedTo(maker->bufferSizeBytes(),
+                                                     alignof(skvx::Vec<4, uint32_t>));
+        return maker->makePass(buffer, bandAlloc);
+    };
+
+    // Basic Plan: The three cases to handle
+    // * Horizontal and Vertical - blur horizontally while copying values from the source to
+    //     the destination. Then, do an in-place vertical blur.
+    // * Horizontal only - blur horizontally copying values from the source to the destination.
+    // * Vertical only - blur vertically copying values from the source to the destination.
+    // Rows (or columns) are independent, so either pass can split them across threads.
+
+    // Initialize these assuming the Y-only case
+    int loopStart  = std::max(srcBounds.left(),  dstBounds.left());
+    int loopEnd    = std::min(srcBounds.right(), dstBounds.right());
+    int dstYOffset = 0;
+    const SkBitmap* ySrc = &src;
+
+    if (makerX->window() > 1) {
+        // First an X-only blur from src into dst, including the extra rows that will become input
+        // for the second Y pass, which will then be performed in place.
+        loopStart = std::max(srcBounds.top(),    dstBounds.top());
+        loopEnd   = std::min(srcBounds.bottom(), dstBounds.bottom());
+
+        // Iterate over each row to calculate 1D blur along X.
+        parallel_for(executor, loopEnd - loopStart, dstBounds.width(), [&](int start, int end) {
+            SkSTArenaAlloc<256> bandAlloc;
+            Pass* pass = makePass(makerX, &bandAlloc);
+
+            auto srcAddr = src.getAddr32(0, loopStart + start - srcBounds.top());
+            auto dstAddr = dst.getAddr32(0, loopStart + start - dstBounds.top());
+            for (int y = start; y < end; ++y) {
+                pass->blur(srcBounds.left()  - dstBounds.left(),
+                           srcBounds.right() - dstBounds.left(),
+                           dstBounds.width(),
+                           srcAddr, 1,
+                           dstAddr, 1);
+                srcAddr += src.rowBytesAsPixels();
+                dstAddr += dst.rowBytesAsPixels();
+            }
+        });
+
+        // Set up the Y pass to blur from the full dst into the non-outset portion of dst
+        ySrc = &dst;
+        loopStart = originalDstBounds.left();
+        loopEnd   = originalDstBounds.right();
+        // The Y pass writes to dst.extractSubset(originalDstBounds.offset(-dstOrigin)), but by
+        // construction only the Y offset has an interesting value so this is a little more
+        // efficient.
+        dstYOffset = originalDstBounds.top() - dstBounds.top();
+
+        srcBounds = dstBounds;
+        dstBounds = originalDstBounds;
+    }
+
+    // Iterate over each column to calculate 1D blur along Y. This is either blurring from src into
+    // dst for a 1D blur; or it's blurring from dst into dst for the second pass of a 2D blur.
+    if (makerY->window() > 1) {
+        parallel_for(executor, loopEnd - loopStart, dstBounds.height(), [&](int start, int end) {
+            SkSTArenaAlloc<256> bandAlloc;
+            Pass* pass = makePass(makerY, &bandAlloc);
+
+            auto srcAddr = ySrc->getAddr32(loopStart + start - srcBounds.left(), 0);
+            auto dstAddr = dst.getAddr32(loopStart + start - dstBounds.left(), dstYOffset);
+            for (int x = start; x < end; ++x) {
+                pass->blur(srcBounds.top()    - dstBounds.top(),
+                           srcBounds.bottom() - dstBounds.top(),
+                           dstBounds.height(),
+                           srcAddr, ySrc->rowBytesAsPixels(),
+                           dstAddr, dst.rowBytesAsPixels());
+                srcAddr += 1;
+                dstAddr += 1;
+            }
+        });
+    }
+
+    originalDstBounds.offset(-dstOrigin); // Make relative to dst's pixels
+    SkBitmap subset;
+    SkAssertResult(dst.extractSubset(&subset, originalDstBounds));
+    return subset;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recursive Gaussian
+
+// A third order recursive approximation of a Gaussian (van Vliet, Young and Verbeek, "Recursive
+// Gaussian derivative filters", ICPR 1998). A causal pass and an anti-causal pass each cost a few
+// multiplies per pixel, regardless of sigma. The state is kept in doubles: for large sigmas the
+// poles approach 1, and floats lose the signal entirely.
+class RecursiveGaussian {
+public:
+    explicit RecursiveGaussian(double sigma) {
+        SkASSERT(sigma >= 0.5);
+        // The poles for sigma = 2. Other sigmas raise them to the power 1/q, with q solved so the
+        // variance of the filter matches sigma^2. (The polynomial fit of q in the 1995 paper comes
+        // out about 20% narrow by sigma = 200.)
+        static constexpr std::complex<double> kPoles[3] = {{1.41650,  1.00829},
+                                                           {1.41650, -1.00829},
+                                                           {1.86543,  0.0}};
+        auto scaledPoles = [](double q, std::complex<double> d[3]) {
+            for (int i = 0; i < 3; ++i) {
+                d[i] = std::pow(kPoles[i], 1 / q);
+            }
+        };
+        auto variance = [&](double q) {
+            std::complex<double> d[3];
+            scaledPoles(q, d);
+            std::complex<double> v = 0;
+            for (int i = 0; i < 3; ++i) {
+                v += 2.0 * d[i] / ((d[i] - 1.0) * (d[i] - 1.0));
+            }
+            return v.real();
+        };
+
+        // The variance grows monotonically with q, which is roughly sigma / 2.
+        double lo = 0.1, hi = sigma + 1;
+        for (int i = 0; i < 64; ++i) {
+            const double mid = (lo + hi) / 2;
+            (variance(mid) < sigma * sigma ? lo : hi) = mid;
+        }
+
+        std::complex<double> d[3];
+        scaledPoles((lo + hi) / 2, d);
+        fB1 =  (1.0 / d[0] + 1.0 / d[1] + 1.0 / d[2]).real();
+        fB2 = -(1.0 / (d[0] * d[1]) + 1.0 / (d[0] * d[2]) + 1.0 / (d[1] * d[2])).real();
+        fB3 =  (1.0 / (d[0] * d[1] * d[2])).real();
+        fB  = 1 - (fB1 + fB2 + fB3);
+
+        // Less than 1e-4 of a Gaussian's weight lies past 4 sigma, so the filters start and stop
+        // there.
+        fPad = sk_double_ceil2int(4 * sigma);
+    }
+
+    int pad() const { return fPad; }
+
+    // The number of doubles blur() needs as a buffer.
+    static int BufferCount(int dstStart, int dstEnd, int pad) {
+        return 4 * (dstEnd - dstStart + 2 * pad);
+    }
+
+    // Blurs a line whose source pixels span [srcStart, srcEnd), with 'src' pointing at srcStart,
+    // into [dstStart, dstEnd), with 'dst' pointing at dstStart. Positions outside of the source
+    // are transparent.
+    void blur(const uint32_t* src, int srcStride, int srcStart, int srcEnd,
+              uint32_t* dst, int dstStride, int dstStart, int dstEnd,
+              double* buffer) const {
+        using D4 = skvx::double4;
+
+        // Source pixels further than 'pad' from the destination don't contribute.
+        const int inStart = std::max(srcStart, dstStart - fPad),
+                  inEnd   = std::min(srcEnd, dstEnd + fPad),
+                  start   = std::min(inStart, dstStart),
+                  end     = dstEnd + fPad;
+        SkASSERT(4 * (end - start) <= BufferCount(dstStart, dstEnd, fPad));
+
+        auto load = [](const uint32_t* p) {
+            return skvx::cast<double>(skvx::byte4::Load(p));
+        };
+
+        // Causal pass, left to right: w[n] = B u[n] + b1 w[n-1] + b2 w[n-2] + b3 w[n-3]
+        D4 w1 = 0, w2 = 0, w3 = 0;
+        const uint32_t* s = src + (inStart - srcStart) * srcStride;
+        for (int n = start; n < end; ++n) {
+            D4 w = fB1 * w1 + fB2 * w2 + fB3 * w3;
+            if (inStart <= n && n < inEnd) {
+                w += fB * load(s);
+                s += srcStride;
+            }
+            w.store(buffer + 4 * (n - start));
+            w3 = w2;
+            w2 = w1;
+            w1 = w;
+        }
+
+        // Anti-causal pass, right to left: y[n] = B w[n] + b1 y[n+1] + b2 y[n+2] + b3 y[n+3]
+        D4 y1 = 0, y2 = 0, y3 = 0;
+        uint32_t* d = dst + (dstEnd - 1 - dstStart) * dstStride;
+        for (int n = end - 1; n >= dstStart; --n) {
+            D4 y = fB * D4::Load(buffer + 4 * (n - start)) + fB1 * y1 + fB2 * y2 + fB3 * y3;
+            y3 = y2;
+            y2 = y1;
+            y1 = y;
+
+            if (n < dstEnd) {
+                // The filter rings a little, so clamp to valid premultiplied values.
+                D4 v = skvx::pin(y + 0.5, D4(0), D4(255));
+                v = skvx::min(v, D4(v[3]));
+                skvx::cast<uint8_t>(skvx::cast<int32_t>(v)).store(d);
+                d -= dstStride;
+            }
+        }
+    }
+
+private:
+    double fB, fB1, fB2, fB3;
+    int fPad;
+};
+
+SkBitmap recursive_blur(SkSize sigma, const SkBitmap& src, SkIRect srcBounds, SkIRect dstBounds,
+                        SkExecutor* executor) {
+    SkASSERT(src.width() == srcBounds.width() && src.height() == srcBounds.height());
+
+    // Sigmas this small are identities for the other raster blurs; match them.
+    const bool blurX = SkBlurEngine::BoxBlurWindow(sigma.width())  > 1,
+               blurY = SkBlurEngine::BoxBlurWindow(sigma.height()) > 1;
+    const RecursiveGaussian gaussX(blurX ? sigma.width()  : 0.5),
+                            gaussY(blurY ? sigma.height() : 0.5);
+
+    // The X pass only computes the columns of 'dstBounds', and the rows that reach it.
+    SkIRect tmpBounds = dstBounds;
+    tmpBounds.outset(0, blurY ? gaussY.pad() : 0);
+    if (!tmpBounds.intersect(SkIRect::MakeLTRB(dstBounds.left(), srcBounds.top(),
+                                               dstBounds.right(), srcBounds.bottom()))) {
+        return make_transparent(src.info().makeWH(dstBounds.width(), dstBounds.height()));
+    }
+
+    SkBitmap tmp = make_transparent(src.info().makeWH(tmpBounds.width(), tmpBounds.height()));
+    SkBitmap dst = make_transparent(src.info().makeWH(dstBounds.width(), dstBounds.height()));
+    if (tmp.drawsNothing() || dst.drawsNothing()) {
+        return {};
+    }
+
+    // X pass, from src into tmp.
+    parallel_for(executor, tmpBounds.height(), tmpBounds.width(), [&](int start, int end) {
+        skia_private::AutoTMalloc<double> buffer(
+                RecursiveGaussian::BufferCount(tmpBounds.left(), tmpBounds.right(), gaussX.pad()));
+        for (int y = tmpBounds.top() + start; y < tmpBounds.top() + end; ++y) {
+            const uint32_t* srcRow = src.getAddr32(0, y - srcBounds.top());
+            uint32_t* tmpRow = tmp.getAddr32(0, y - tmpBounds.top());
+            if (blurX) {
+                gaussX.blur(srcRow, 1, srcBounds.left(), srcBounds.right(),
+                            tmpRow, 1, tmpBounds.left(), tmpBounds.right(),
+                            buffer.get());
+            } else {
+                const int left  = std::max(srcBounds.left(),  tmpBounds.left()),
+                          right = std::min(srcBounds.right(), tmpBounds.right());
+                for (int x = left; x < right; ++x) {
+                    tmpRow[x - tmpBounds.left()] = srcRow[x - srcBounds.left()];
+                }
+            }
+        }
+    });
+
+    // Y pass, from tmp into dst.
+    parallel_for(executor, dstBounds.width(), tmpBounds.height(), [&](int start, int end) {
+        skia_private::AutoTMalloc<double> buffer(
+                RecursiveGaussian::BufferCount(dstBounds.top(), dstBounds.bottom(), gaussY.pad()));
+        for (int x = start; x < end; ++x) {
+            const uint32_t* tmpColumn = tmp.getAddr32(x, 0);
+            uint32_t* dstColumn = dst.getAddr32(x, 0);
+            if (blurY) {
+                gaussY.blur(tmpColumn, tmp.rowBytesAsPixels(), tmpBounds.top(), tmpBounds.bottom(),
+                            dstColumn, dst.rowBytesAsPixels(), dstBounds.top(), dstBounds.bottom(),
+                            buffer.get());
+            } else {
+                const int top    = std::max(tmpBounds.top(),    dstBounds.top()),
+                          bottom = std::min(tmpBounds.bottom(), dstBounds.bottom());
+                for (int y = top; y < bottom; ++y) {
+                    *dst.getAddr32(x, y - dstBounds.top()) =
+                            *tmp.getAddr32(x, y - tmpBounds.top());
+                }
+            }
+        }
+    });
+
+    return dst;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Downsample pyramid
+
+// The pyramid blur averages 'scale' x 'scale' blocks (the levels of a 2x pyramid, collapsed into
+// one pass), box blurs the small image, and bilinearly upscales it. The averaging and the
+// upscaling blur too, so the small image's sigma is reduced to keep the total variance.
+//
+// Besides the box blur's own shape, two things make it differ from a true Gaussian. The small
+// image's box windows are integers, so the total sigma is off by a fraction; and for a hard edge
+// blurred by sigma, whose slope peaks at 255 * 0.242 / sigma and second derivative at
+// 255 * 0.242 / sigma^2, linear interpolation over 'scale' pixels is off by at most scale^2 / 8
+// times the latter.
+static constexpr float kMinPyramidSigma = 8.f;  // Keeps the small image's boxes from degenerating.
+// At kMaxRasterSigma, scaling by 128 already leaves the small image under kMinPyramidSigma.
+static constexpr int kMaxPyramidScale = 128;
+
+struct PyramidAxis {
+    int scale  = 0;  // 0 if no downscaling is within tolerance
+    int window = 0;  // The box window of the small image
+};
+
+// The variance of the three box filters GaussPass runs for 'window'.
+double box_variance(int window) {
+    const double w = window;
+    // Odd windows are three boxes of 'window', even ones have a third box one wider.
+    return (window & 1) ? (w * w - 1) / 4 : (3 * w * w + 2 * w - 2) / 12;
+}
+
+bool in_box_range(float sigma) {
+    // The window limit of GaussPass.
+    return SkBlurEngine::BoxBlurWindow(sigma) < 255;
+}
+
+// The largest sigma in_box_range() accepts: in_box_range(sigma) iff sigma <= max_box_sigma().
+float max_box_sigma() {
+    static const float kMaxSigma = [] {
+        // Start from the window's rounding boundary, then settle on the exact float.
+        float sigma = static_cast<float>(254.5 / (3 * sqrt(2 * SK_DoublePI) / 4));
+        while (!in_box_range(sigma)) {
+            sigma = std::nextafter(sigma, 0.f);
+        }
+        while (in_box_range(std::nextafter(sigma, SK_FloatInfinity))) {
+            sigma = std::nextafter(sigma, SK_FloatInfinity);
+        }
+        return sigma;
+    }();
+    return kMaxSigma;
+}
+
+// Picks the largest power of two to downscale an axis blurred by 'sigma' by, whose estimated
+// error stays within 'tolerance'.
+PyramidAxis pyramid_axis(float sigma, float tolerance) {
+    SkASSERT(sigma <= kMaxRasterSigma);
+    if (in_box_range(sigma)) {
+        // Small enough to blur at full resolution, exactly like BoxAlgorithm does.
+        return {1, SkBlurEngine::BoxBlurWindow(sigma)};
+    }
+
+    PyramidAxis axis;
+    for (int scale = 2; scale <= kMaxPyramidScale; scale *= 2) {
+        // Averaging adds (scale^2 - 1) / 12 to the variance, and the bilinear tent scale^2 / 6.
+        const double s2       = static_cast<double>(scale) * scale,
+                     resample = (s2 - 1) / 12 + s2 / 6,
+                     variance = (static_cast<double>(sigma) * sigma - resample) / s2;
+        if (variance < kMinPyramidSigma * kMinPyramidSigma) {
+            break;
+        }
+
+        // The window whose variance is closest.
+        int window = static_cast<int>(std::sqrt(4 * variance + 1));
+        if (std::abs(box_variance(window + 1) - variance) <
+            std::abs(box_variance(window)     - variance)) {
+            window += 1;
+        }
+        if (window >= 255) {
+            continue;
+        }
+
+        const double actual = std::sqrt(s2 * box_variance(window) + resample),
+                     error  = 255 * 0.242 * (std::abs(actual - sigma) / sigma +
+                                             s2 / (8 * sigma * sigma));
+        if (error <= tolerance) {
+            axis = {scale, window};
+        }
+    }
+    return axis;
+}
+
+// Averages the 'scaleX' x 'scaleY' blocks of 'src' (covering 'srcBounds') into a bitmap covering
+// 'lowBounds', in the scaled down coordinate space.
+SkBitmap downscale(const SkBitmap& src, SkIRect srcBounds, SkIRect lowBounds,
+                   int scaleX, int scaleY, SkExecutor* executor) {
+    SkBitmap low;
+    if (!low.tryAllocPixels(src.info().makeWH(lowBounds.width(), lowBounds.height()))) {
+        return {};
+    }
+
+    // Both scales are powers of two, and small enough for the block sums to fit in 32 bits.
+    SkASSERT(scaleX <= kMaxPyramidScale && scaleY <= kMaxPyramidScale);
+    const int shift = SkPrevLog2(scaleX * scaleY);
+    const uint32_t half = (scaleX * scaleY) >> 1;
+
+    const int64_t blockPixels = static_cast<int64_t>(lowBounds.width()) * scaleX * scaleY;
+    parallel_for(executor, lowBounds.height(), blockPixels, [&](int start, int end) {
+        using U32 = skvx::Vec<4, uint32_t>;
+        skia_private::AutoTMalloc<uint32_t> sums(4 * lowBounds.width());
+
+        for (int j = start; j < end; ++j) {
+            sk_bzero(sums.get(), 4 * lowBounds.width() * sizeof(uint32_t));
+
+            const int top    = std::max((lowBounds.top() + j) * scaleY, srcBounds.top()),
+                      bottom = std::min((lowBounds.top() + j + 1) * scaleY, srcBounds.bottom());
+            for (int y = top; y < bottom; ++y) {
+                const uint32_t* row = src.getAddr32(0, y - srcBounds.top());
+                for (int i = 0; i < lowBounds.width(); ++i) {
+                    const int left  = std::max((lowBounds.left() + i) * scaleX, srcBounds.left()),
+                              right = std::min((lowBounds.left() + i + 1) * scaleX,
+                                               srcBounds.right());
+                    U32 sum = U32::Load(sums.get() + 4 * i);
+                    for (int x = left; x < right; ++x) {
+                        sum += skvx::cast<uint32_t>(skvx::byte4::Load(row + x - srcBounds.left()));
+                    }
+                    sum.store(sums.get() + 4 * i);
+                }
+            }
+
+            uint32_t* lowRow = low.getAddr32(0, j);
+            for (int i = 0; i < lowBounds.width(); ++i) {
+                U32 sum = U32::Load(sums.get() + 4 * i);
+                skvx::cast<uint8_t>((sum + half) >> shift).store(lowRow + i);
+            }
+        }
+    });
+
+    return low;
+}
+
+// Bilinearly upscales 'low' (covering 'lowBounds') into a bitmap covering 'dstBounds'. Pixel
+// centers line up: low pixel i covers [i * scale, (i + 1) * scale).
+SkBitmap upscale(const SkBitmap& low, SkIRect lowBounds, SkIRect dstBounds,
+                 int scaleX, int scaleY, SkExecutor* executor) {
+    SkBitmap dst;
+    if (!dst.tryAllocPixels(low.info().makeWH(dstBounds.width(), dstBounds.height()))) {
+        return {};
+    }
+
+    // Output pixel x samples the low image at (x + 0.5) / scale - 0.5. Returns the low pixel at or
+    // to the left of that, relative to 'lowStart', and the fraction past it.
+    auto sample = [](int x, int scale, int lowStart) -> std::pair<int, float> {
+        const int twice = 2 * x + 1 - scale,
+                  i     = floor_div(twice, 2 * scale);
+        return {i - lowStart, (twice - 2 * scale * i) / (2.f * scale)};
+    };
+
+    skia_private::AutoTMalloc<int>   xIndex(dstBounds.width());
+    skia_private::AutoTMalloc<float> xFrac(dstBounds.width());
+    for (int x = 0; x < dstBounds.width(); ++x) {
+        std::tie(xIndex[x], xFrac[x]) = sample(dstBounds.left() + x, scaleX, lowBounds.left());
+        SkASSERT(0 <= xIndex[x] && xIndex[x] + 1 < lowBounds.width());
+    }
+
+    parallel_for(executor, dstBounds.height(), dstBounds.width(), [&](int start, int end) {
+        using F4 = skvx::float4;
+        skia_private::AutoTMalloc<float> row(4 * lowBounds.width());
+
+        auto load = [](const uint32_t* p) {
+            return skvx::cast<float>(skvx::byte4::Load(p));
+        };
+
+        for (int y = start; y < end; ++y) {
+            auto [j, fy] = sample(dstBounds.top() + y, scaleY, lowBounds.top());
+            SkASSERT(0 <= j && j + 1 < lowBounds.height());
+
+            // Interpolate the two rows first; they are the narrow ones.
+            const uint32_t* row0 = low.getAddr32(0, j);
+            const uint32_t* row1 = low.getAddr32(0, j + 1);
+            for (int i = 0; i < lowBounds.width(); ++i) {
+                const F4 p0 = load(row0 + i);
+                (p0 + fy * (load(row1 + i) - p0)).store(row.get() + 4 * i);
+            }
+
+            uint32_t* dstRow = dst.getAddr32(0, y);
+            for (int x = 0; x < dstBounds.width(); ++x) {
+                const F4 p0 = F4::Load(row.get() + 4 * xIndex[x]),
+                         p1 = F4::Load(row.get() + 4 * xIndex[x] + 4);
+                F4 v = skvx::pin(p0 + xFrac[x] * (p1 - p0) + 0.5f, F4(0), F4(255));
+                v = skvx::min(v, F4(v[3]));
+                skvx::cast<uint8_t>(skvx::cast<int32_t>(v)).store(dstRow + x);
+            }
+        }
+    });
+
+    return dst;
+}
+
+SkBitmap pyramid_blur(SkSize sigma, float tolerance,
+                      const SkBitmap& src, SkIRect srcBounds, SkIRect dstBounds,
+                      SkExecutor* executor) {
+    const PyramidAxis x = pyramid_axis(sigma.width(),  tolerance),
+                      y = pyramid_axis(sigma.height(), tolerance);
+    SkASSERT(x.scale > 0 && y.scale > 0);
+    const int scaleX = x.scale,
+              scaleY = y.scale;
+
+    // Only the source pixels within reach of 'dstBounds' are averaged: the boxes reach 3/2 of a
+    // window, and the averaging and the interpolation one more low pixel each.
+    SkIRect needed = dstBounds;
+    needed.outset((3 * x.window / 2 + 2) * scaleX, (3 * y.window / 2 + 2) * scaleY);
+    if (!needed.intersect(srcBounds)) {
+        return make_transparent(src.info().makeWH(dstBounds.width(), dstBounds.height()));
+    }
+
+    const SkIRect lowSrcBounds = SkIRect::MakeLTRB(floor_div(needed.left(),   scaleX),
+                                                   floor_div(needed.top(),    scaleY),
+                                                   ceil_div (needed.right(),  scaleX),
+                                                   ceil_div (needed.bottom(), scaleY));
+    // The low pixels on either side of every dst pixel's sample point.
+    const SkIRect lowDstBounds = SkIRect::MakeLTRB(
+            floor_div(2 * dstBounds.left()         + 1 - scaleX, 2 * scaleX),
+            floor_div(2 * dstBounds.top()          + 1 - scaleY, 2 * scaleY),
+            floor_div(2 * (dstBounds.right()  - 1) + 1 - scaleX, 2 * scaleX) + 2,
+            floor_div(2 * (dstBounds.bottom() - 1) + 1 - scaleY, 2 * scaleY) + 2);
+
+    SkBitmap low = downscale(src, srcBounds, lowSrcBounds, scaleX, scaleY, executor);
+    if (low.drawsNothing()) {
+        return {};
+    }
+    low = box_blur({x.window, y.window}, low, lowSrcBounds, lowDstBounds, executor);
+    if (low.drawsNothing()) {
+        return {};
+    }
+    return upscale(low, lowDstBounds, dstBounds, scaleX, scaleY, executor);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class RasterAlgorithm : public SkBlurEngine::Algorithm {
+public:
+    explicit RasterAlgorithm(SkExecutor* executor) : fExecutor(executor) {}
+
+    bool supportsOnlyDecalTiling() const override { return true; }
+
+    sk_sp<SkSpecialImage> blur(SkSize sigma,
+                               sk_sp<SkSpecialImage> src,
+                               const SkIRect& srcRect,
+                               SkTileMode tileMode,
+                               const SkIRect& dstRect) const override {
+        SkASSERT(tileMode == SkTileMode::kDecal);
+        SkASSERT(sigma.width() <= this->maxSigma() && sigma.height() <= this->maxSigma());
+        sigma = {SkTPin(sigma.width(),  0.f, this->maxSigma()),
+                 SkTPin(sigma.height(), 0.f, this->maxSigma())};
+
+        SkBitmap srcBitmap, srcSubset;
+        if (!SkSpecialImages::AsBitmap(src.get(), &srcBitmap) ||
+            srcBitmap.colorType() != kRasterBlurColorType ||
+            !srcBitmap.extractSubset(&srcSubset, srcRect)) {
+            return nullptr;
+        }
+
+        SkBitmap dst = this->blurBitmap(sigma, srcSubset, srcRect, dstRect, fExecutor);
+        if (dst.drawsNothing()) {
+            return nullptr;
+        }
+        return SkSpecialImages::MakeFromRaster(SkIRect::MakeSize(dst.dimensions()),
+                                               dst,
+                                               src->props());
+    }
+
+private:
+    // 'src' covers 'srcBounds', and the result must cover 'dstBounds'. Bands of rows and columns
+    // may run on 'executor', if it isn't null.
+    virtual SkBitmap blurBitmap(SkSize sigma,
+                                const SkBitmap& src,
+                                SkIRect srcBounds,
+                                SkIRect dstBounds,
+                                SkExecutor* executor) const = 0;
+
+    SkExecutor* const fExecutor;
+};
+
+// The historical raster blur, unchanged.
+class BoxAlgorithm final : public RasterAlgorithm {
+public:
+    using RasterAlgorithm::RasterAlgorithm;
+
+    // The largest sigma that keeps the GaussPass window under 255 (about 135.38).
+    float maxSigma() const override { return max_box_sigma(); }
+
+private:
+    SkBitmap blurBitmap(SkSize sigma, const SkBitmap& src,
+                        SkIRect srcBounds, SkIRect dstBounds,
+                        SkExecutor* executor) const override {
+        return box_blur({SkBlurEngine::BoxBlurWindow(sigma.width()),
+                         SkBlurEngine::BoxBlurWindow(sigma.height())},
+                        src, srcBounds, dstBounds, executor);
+    }
+};
+
+class PyramidAlgorithm final : public RasterAlgorithm {
+public:
+    PyramidAlgorithm(float tolerance, SkExecutor* executor)
+            : RasterAlgorithm(executor), fTolerance(tolerance) {}
+
+    float maxSigma() const override { return kMaxRasterSigma; }
+
+    bool supports(SkSize sigma) const {
+        return pyramid_axis(sigma.width(),  fTolerance).scale > 0 &&
+               pyramid_axis(sigma.height(), fTolerance).scale > 0;
+    }
+
+private:
+    SkBitmap blurBitmap(SkSize sigma, const SkBitmap& src,
+                        SkIRect srcBounds, SkIRect dstBounds,
+                        SkExecutor* executor) const override {
+        return pyramid_blur(sigma, fTolerance, src, srcBounds, dstBounds, executor);
+    }
+
+    const float fTolerance;
+};
+
+class RecursiveAlgorithm final : public RasterAlgorithm {
+public:
+    using RasterAlgorithm::RasterAlgorithm;
+
+    float maxSigma() const override { return kMaxRasterSigma; }
+
+private:
+    SkBitmap blurBitmap(SkSize sigma, const SkBitmap& src,
+                        SkIRect srcBounds, SkIRect dstBounds,
+                        SkExecutor* executor) const override {
+        return recursive_blur(sigma, src, srcBounds, dstBounds, executor);
+    }
+};
+
+class RasterBlurEngine final : public SkBlurEngine {
+public:
+    RasterBlurEngine(float tolerance, SkExecutor* executor)
+            : fBox(executor), fPyramid(tolerance, executor), fRecursive(executor) {}
+
+    const Algorithm* findAlgorithm(SkSize sigma, SkColorType colorType) const override {
+        if (colorType != kRasterBlurColorType) {
+            return nullptr;
+        }
+        // Larger sigmas are the caller's to downscale; pick the algorithm that covers the limit.
+        sigma = {SkTPin(sigma.width(),  0.f, kMaxRasterSigma),
+                 SkTPin(sigma.height(), 0.f, kMaxRasterSigma)};
+        if (in_box_range(sigma.width()) && in_box_range(sigma.height())) {
+            return &fBox;
+        }
+        if (fPyramid.supports(sigma)) {
+            return &fPyramid;
+        }
+        return &fRecursive;
+    }
+
+private:
+    BoxAlgorithm       fBox;
+    PyramidAlgorithm   fPyramid;
+    RecursiveAlgorithm fRecursive;
+};
+
+}  // namespace
+
+const SkBlurEngine* SkBlurEngine::GetRasterBlurEngine() {
+    static const RasterBlurEngine gEngine{kDefaultTolerance, /*executor=*/nullptr};
+    return &gEngine;
+}
+
+std::unique_ptr<SkBlurEngine> SkBlurEngine::MakeRasterBlurEngine(float tolerance,
+                                                                 SkExecutor* executor) {
+    return std::make_unique<RasterBlurEngine>(std::max(tolerance, 0.f), executor);
+}
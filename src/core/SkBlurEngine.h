@@ -10,6 +10,9 @@
 
 #include "include/core/SkRefCnt.h"
 
+#include <memory>
+
+class SkExecutor;
 class SkSpecialImage;
 struct SkIRect;
 struct SkSize;
@@ -37,6 +40,24 @@ public:
 
     virtual ~SkBlurEngine() = default;
 
+    // The raster blur engine, for N32 SkSpecialImages backed by SkBitmaps. Sigmas within reach of
+    // its triple box blur use that; larger sigmas blur a downscaled image when the estimated
+    // resampling error stays under half of an 8-bit step, and use a recursive (IIR) Gaussian
+    // otherwise. None of them blur sigmas over 532, SkBlurImageFilter's limit. It blurs on the
+    // calling thread.
+    static const SkBlurEngine* GetRasterBlurEngine();
+
+    // A raster blur engine that may trade up to 'tolerance' 8-bit steps of resampling error for
+    // speed on large sigmas. A tolerance of 0 never resamples. If 'executor' is not null, large
+    // blurs split their rows and columns into bands that run on it while the caller waits, so it
+    // must not be given to callers that hold locks its other tasks may need.
+    static std::unique_ptr<SkBlurEngine> MakeRasterBlurEngine(float tolerance,
+                                                              SkExecutor* executor = nullptr);
+
+    // The width of the box filters the raster blur uses to approximate 'sigma'. A window of 1
+    // means there is no visible blur.
+    static int BoxBlurWindow(double sigma);
+
     // Returns an Algorithm ideal for the requested 'sigma' that will support sampling an image of
     // the given 'colorType'. If the engine does not support the requested configuration, it returns
     // null. The engine maintains the lifetime of its algorithms, so the returned non-null
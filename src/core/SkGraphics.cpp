@@ -12,9 +12,11 @@
 #include "src/core/SkBlitRow.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkMaskBlurFilter.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkRuntimeEffectCache.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "src/core/SkTypefaceCache.h"
@@ -26,6 +28,7 @@ void SkGraphics::Init() {
     SkOpts::Init_BitmapProcState();
     SkOpts::Init_BlitMask();
     SkOpts::Init_BlitRow();
+    SkOpts::Init_MaskBlurFilter();
     SkOpts::Init_Memset();
     SkOpts::Init_Swizzler();
 }
@@ -35,16 +38,36 @@ void SkGraphics::Init() {
 void SkGraphics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
   SkResourceCache::DumpMemoryStatistics(dump);
   SkStrikeCache::DumpMemoryStatistics(dump);
+  SkRuntimeEffectCache::DumpMemoryStatistics(dump);
 }
 
 void SkGraphics::PurgeAllCaches() {
     SkGraphics::PurgeFontCache();
     SkGraphics::PurgeResourceCache();
+    SkGraphics::PurgeRuntimeEffectCache();
     SkImageFilter_Base::PurgeCache();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+size_t SkGraphics::GetRuntimeEffectCacheLimit() {
+    return SkRuntimeEffectCache::GetByteLimit();
+}
+
+size_t SkGraphics::SetRuntimeEffectCacheLimit(size_t newLimit) {
+    return SkRuntimeEffectCache::SetByteLimit(newLimit);
+}
+
+size_t SkGraphics::GetRuntimeEffectCacheUsed() {
+    return SkRuntimeEffectCache::GetBytesUsed();
+}
+
+void SkGraphics::PurgeRuntimeEffectCache() {
+    SkRuntimeEffectCache::PurgeAll();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 size_t SkGraphics::GetFontCacheLimit() {
     return SkStrikeCache::GlobalStrikeCache()->getCacheSizeLimit();
 }
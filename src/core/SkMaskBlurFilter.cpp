@@ -15,9 +15,11 @@
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkGaussFilter.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <cmath>
 #include <climits>
+#include <functional>
 
 namespace {
 static const double kPi = 3.14159265358979323846264338327950288;
@@ -90,6 +92,23 @@ public:
 
     int    border()     const { return fBorder; }
 
+    // Blurs A8 lines several at a time, using SkOpts::box_blur_lines. This gives the same results
+    // as a Scan per line. Returns the number of lines blurred, starting with the first; the
+    // remaining lines must be blurred with a Scan.
+    int blurLines(const uint8_t* src, size_t srcLineStride, int srcLen,
+                  uint8_t* dst, size_t dstPixelStride, int dstLen, int lineCount) const {
+        if (fPass0Size == 0) {
+            // A window of one: leave this degenerate case to Scan.
+            return 0;
+        }
+        SkASSERT(fPass1Size > 0 && fPass2Size > 0);
+
+        return SkOpts::box_blur_lines(fWeight, fPass0Size, fPass1Size, fPass2Size,
+                                      this->noChangeCount(srcLen),
+                                      src, srcLineStride, srcLen,
+                                      dst, dstPixelStride, dstLen, lineCount);
+    }
+
 public:
     class Scan {
     public:
@@ -218,15 +237,17 @@ public:
         buffer0End = buffer1 = buffer0 + fPass0Size;
         buffer1End = buffer2 = buffer1 + fPass1Size;
         buffer2End = buffer2 + fPass2Size;
-        int noChangeCount = fSlidingWindow > width ? fSlidingWindow - width : 0;
-
         return Scan(
-            fWeight, noChangeCount,
+            fWeight, this->noChangeCount(width),
             buffer0, buffer0End,
             buffer1, buffer1End,
             buffer2, buffer2End);
     }
 
+    int noChangeCount(int width) const {
+        return fSlidingWindow > width ? fSlidingWindow - width : 0;
+    }
+
     uint64_t fWeight;
     int      fBorder;
     int      fSlidingWindow;
@@ -251,9 +272,10 @@ public:
 //
 //   window = floor(sigma * 3 * sqrt(2 * kPi) / 4)
 //   For window <= 255, the largest value for sigma is 135.
-SkMaskBlurFilter::SkMaskBlurFilter(double sigmaW, double sigmaH)
+SkMaskBlurFilter::SkMaskBlurFilter(double sigmaW, double sigmaH, SkExecutor* executor)
     : fSigmaW{SkTPin(sigmaW, 0.0, 135.0)}
     , fSigmaH{SkTPin(sigmaH, 0.0, 135.0)}
+    , fExecutor{executor}
 {
     SkASSERT(sigmaW >= 0);
     SkASSERT(sigmaH >= 0);
@@ -950,9 +972,39 @@ static SkIPoint small_blur(double sigmaX, double sigmaY, const SkMask& src, SkMa
     return {radiusX, radiusY};
 }
 
+// Splits large blur passes into bands of lines, which are blurred in parallel on 'executor' (if
+// there is one). Each line of a pass is independent, so this doesn't change the results.
+static void for_each_band(SkExecutor* executor, int lineCount, int lineLength,
+                          const std::function<void(int, int)>& fn) {
+    // Smaller passes are not worth the task overhead.
+    static constexpr int kMinParallelPixels = 256 * 256;
+    static constexpr int kMinLinesPerBand   = 64;
+    static constexpr int kMaxBands          = 32;
+
+    const int bandCount = std::min(lineCount / kMinLinesPerBand, kMaxBands);
+    if (!executor || bandCount < 2 ||
+        static_cast<int64_t>(lineCount) * lineLength < kMinParallelPixels) {
+        fn(0, lineCount);
+        return;
+    }
+
+    // Round to the widest SkOpts::box_blur_lines group, so only the last band has a Scan tail.
+    const int linesPerBand = ((lineCount + bandCount - 1) / bandCount + 15) & ~15;
+
+    SkTaskGroup tg(*executor);
+    tg.batch(bandCount, [&](int i) {
+        const int y0 = i * linesPerBand,
+                  y1 = std::min(y0 + linesPerBand, lineCount);
+        if (y0 < y1) {
+            fn(y0, y1);
+        }
+    });
+    tg.wait();
+}
+
 // TODO: assuming sigmaW = sigmaH. Allow different sigmas. Right now the
 // API forces the sigmas to be the same.
-SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMaskBuilder* dst) const {
+SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMaskBuilder* dst, bool useLineKernel) const {
 
     if (fSigmaW < 2.0 && fSigmaH < 2.0) {
         return small_blur(fSigmaW, fSigmaH, src, dst);
@@ -983,9 +1035,6 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMaskBuilder* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
-    auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
-
     // Blur both directions.
     int tmpW = srcH,
         tmpH = dstW;
@@ -997,58 +1046,77 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMaskBuilder* dst) const {
     auto tmp = alloc.makeArrayDefault<uint8_t>(tmpW * tmpH);
 
     // Blur horizontally, and transpose.
-    const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
-    switch (src.fFormat) {
-        case SkMask::kBW_Format: {
-            const uint8_t* bwStart = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
-            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kA8_Format: {
-            const uint8_t* a8Start = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
-            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kARGB32_Format: {
-            const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
-            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kLCD16_Format: {
-            const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
-            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+    for_each_band(fExecutor, srcH, srcW, [&](int y0, int y1) {
+        skia_private::AutoSTMalloc<256, uint32_t> buffer(planW.bufferSize());
+        const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer.get());
+
+        auto scanRows = [&](auto start, auto end, int y) {
+            for (; y < y1; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
                 auto tmpStart = &tmp[y];
                 scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
             }
-        } break;
-        default:
-            SK_ABORT("Unhandled format.");
-    }
+        };
+
+        int y = y0;
+        switch (src.fFormat) {
+            case SkMask::kBW_Format: {
+                const uint8_t* bwStart = src.fImage + y * src.fRowBytes;
+                scanRows(SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0),
+                         SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8),
+                         y);
+            } break;
+            case SkMask::kA8_Format: {
+                if (useLineKernel) {
+                    y += planW.blurLines(src.fImage + y * src.fRowBytes, src.fRowBytes, srcW,
+                                         &tmp[y], tmpW, tmpH, y1 - y);
+                }
+
+                const uint8_t* a8Start = src.fImage + y * src.fRowBytes;
+                scanRows(SkMask::AlphaIter<SkMask::kA8_Format>(a8Start),
+                         SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW),
+                         y);
+            } break;
+            case SkMask::kARGB32_Format: {
+                const uint32_t* argbStart =
+                        reinterpret_cast<const uint32_t*>(src.fImage + y * src.fRowBytes);
+                scanRows(SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart),
+                         SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW),
+                         y);
+            } break;
+            case SkMask::kLCD16_Format: {
+                const uint16_t* lcdStart =
+                        reinterpret_cast<const uint16_t*>(src.fImage + y * src.fRowBytes);
+                scanRows(SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart),
+                         SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW),
+                         y);
+            } break;
+            default:
+                SK_ABORT("Unhandled format.");
+        }
+    });
 
     // Blur vertically (scan in memory order because of the transposition),
     // and transpose back to the original orientation.
-    const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
-        auto tmpStart = &tmp[y * tmpW];
-        auto dstStart = &dst->image()[y];
+    for_each_band(fExecutor, tmpH, tmpW, [&](int y0, int y1) {
+        int y = y0;
+        if (useLineKernel) {
+            y += planH.blurLines(&tmp[y0 * tmpW], tmpW, tmpW,
+                                 &dst->image()[y0], dst->fRowBytes, dstH, y1 - y0);
+        }
+        if (y == y1) {
+            return;
+        }
 
-        scanH.blur(tmpStart, tmpStart + tmpW,
-                   dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
-    }
+        skia_private::AutoSTMalloc<256, uint32_t> buffer(planH.bufferSize());
+        const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer.get());
+        for (; y < y1; y++) {
+            auto tmpStart = &tmp[y * tmpW];
+            auto dstStart = &dst->image()[y];
+
+            scanH.blur(tmpStart, tmpStart + tmpW,
+                       dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
+        }
+    });
 
     return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
 }
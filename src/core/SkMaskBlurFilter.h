@@ -9,29 +9,59 @@
 #define SkMaskBlurFilter_DEFINED
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <tuple>
 
 #include "include/core/SkTypes.h"
 #include "src/core/SkMask.h"
 
+class SkExecutor;
+
 // Implement a single channel Gaussian blur. The specifics for implementation are taken from:
 // https://drafts.fxtf.org/filters/#feGaussianBlurElement
 class SkMaskBlurFilter {
 public:
     // Create an object suitable for filtering an SkMask using a filter with width sigmaW and
-    // height sigmaH.
-    SkMaskBlurFilter(double sigmaW, double sigmaH);
+    // height sigmaH. If an executor is given, large blurs are split into bands of lines that are
+    // blurred on it while the caller waits; otherwise everything runs on the calling thread. Only
+    // pass one when the caller doesn't hold locks that the executor's other tasks may need.
+    SkMaskBlurFilter(double sigmaW, double sigmaH, SkExecutor* executor = nullptr);
 
     // returns true iff the sigmas will result in an identity mask (no blurring)
     bool hasNoBlur() const;
 
     // Given a src SkMask, generate dst SkMask returning the border width and height.
-    SkIPoint blur(const SkMask& src, SkMaskBuilder* dst) const;
+    SkIPoint blur(const SkMask& src, SkMaskBuilder* dst) const {
+        return this->blur(src, dst, /*useLineKernel=*/true);
+    }
+
+    // Same as blur(), but A8 lines are never handed to SkOpts::box_blur_lines: every line goes
+    // through the scalar scan. Both must give the same results.
+    SkIPoint blurWithoutLineKernelForTesting(const SkMask& src, SkMaskBuilder* dst) const {
+        return this->blur(src, dst, /*useLineKernel=*/false);
+    }
 
 private:
+    SkIPoint blur(const SkMask& src, SkMaskBuilder* dst, bool useLineKernel) const;
+
     const double fSigmaW;
     const double fSigmaH;
+    SkExecutor* const fExecutor;
 };
 
+namespace SkOpts {
+    // Runs the three pass box blur used for larger sigmas over several contiguous A8 lines at
+    // once, storing the results transposed. Returns the number of lines blurred; the remaining
+    // lines must be blurred by the caller.
+    extern int (*box_blur_lines)(uint64_t weight, int pass0Size, int pass1Size, int pass2Size,
+                                 int noChangeCount,
+                                 const uint8_t* src, size_t srcLineStride, int srcLen,
+                                 uint8_t* dst, size_t dstPixelStride, int dstLen,
+                                 int lineCount);
+
+    void Init_MaskBlurFilter();
+}  // namespace SkOpts
+
 #endif  // SkBlurMaskFilter_DEFINED
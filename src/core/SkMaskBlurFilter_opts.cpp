@@ -0,0 +1,44 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/base/SkFeatures.h"
+#include "src/core/SkCpu.h"
+#include "src/core/SkMaskBlurFilter.h"
+#include "src/core/SkOptsTargets.h"
+
+#define SK_OPTS_TARGET SK_OPTS_TARGET_DEFAULT
+#include "src/opts/SkOpts_SetTarget.h"
+
+#include "src/opts/SkMaskBlurFilter_opts.h"  // IWYU pragma: keep
+
+#include "src/opts/SkOpts_RestoreTarget.h"
+
+namespace SkOpts {
+    DEFINE_DEFAULT(box_blur_lines);
+
+    void Init_MaskBlurFilter_hsw();
+    void Init_MaskBlurFilter_skx();  // Defined in src/opts/SkOpts_skx.cpp.
+
+    static bool init() {
+    #if defined(SK_ENABLE_OPTIMIZE_SIZE)
+        // All Init_foo functions are omitted when optimizing for size
+    #elif defined(SK_CPU_X86)
+        #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX2
+            if (SkCpu::Supports(SkCpu::HSW)) { Init_MaskBlurFilter_hsw(); }
+        #endif
+
+        #if (SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_SKX) && defined(SK_ENABLE_AVX512_OPTS)
+            if (SkCpu::Supports(SkCpu::SKX)) { Init_MaskBlurFilter_skx(); }
+        #endif
+    #endif
+      return true;
+    }
+
+    void Init_MaskBlurFilter() {
+        [[maybe_unused]] static bool gInitialized = init();
+    }
+}  // namespace SkOpts
@@ -31,6 +31,7 @@
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRuntimeBlender.h"
+#include "src/core/SkRuntimeEffectCache.h"
 #include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkStreamPriv.h"
 #include "src/core/SkWriteBuffer.h"
@@ -467,16 +468,31 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
 SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
                                                         const Options& options,
                                                         SkSL::ProgramKind kind) {
+    // Effects are immutable, so identical source compiled with identical options can be shared.
+    SkRuntimeEffectCache::Key key{std::move(sksl),
+                                  kind,
+                                  options.forceUnoptimized,
+                                  options.allowPrivateAccess,
+                                  options.fStableKey,
+                                  options.maxVersionAllowed};
+    if (sk_sp<SkRuntimeEffect> cached = SkRuntimeEffectCache::Find(key)) {
+        return Result{std::move(cached), SkString()};
+    }
+
     SkSL::Compiler compiler;
     SkSL::ProgramSettings settings = MakeSettings(options);
-    std::unique_ptr<SkSL::Program> program =
-            compiler.convertProgram(kind, std::string(sksl.c_str(), sksl.size()), settings);
+    std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+            kind, std::string(key.fSource.c_str(), key.fSource.size()), settings);
 
     if (!program) {
         RETURN_FAILURE("%s", compiler.errorText().c_str());
     }
 
-    return MakeInternal(std::move(program), options, kind);
+    Result result = MakeInternal(std::move(program), options, kind);
+    if (result.effect) {
+        result.effect = SkRuntimeEffectCache::Add(std::move(key), std::move(result.effect));
+    }
+    return result;
 }
 
 SkRuntimeEffect::Result SkRuntimeEffect::MakeInternal(std::unique_ptr<SkSL::Program> program,
@@ -753,7 +769,7 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
     // Everything from SkRuntimeEffect::Options which could influence the compiled result needs to
     // be accounted for in `fHash`. If you've added a new field to Options and caused the static-
     // assert below to trigger, please incorporate your field into `fHash` and update KnownOptions
-    // to match the layout of Options.
+    // to match the layout of Options. It also needs to be part of SkRuntimeEffectCache::Key.
     struct KnownOptions {
         bool forceUnoptimized, allowPrivateAccess;
         uint32_t fStableKey;
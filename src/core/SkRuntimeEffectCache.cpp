@@ -0,0 +1,188 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkRuntimeEffectCache.h"
+
+#include "include/core/SkTraceMemoryDump.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/private/base/SkMutex.h"
+#include "src/base/SkNoDestructor.h"
+#include "src/base/SkTInternalLList.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkTHash.h"
+
+#include <utility>
+
+uint32_t SkRuntimeEffectCache::Key::hash() const {
+    uint32_t hash = SkChecksum::Hash32(fSource.c_str(), fSource.size());
+    hash = SkChecksum::Hash32(&fKind, sizeof(fKind), hash);
+    hash = SkChecksum::Hash32(&fForceUnoptimized, sizeof(fForceUnoptimized), hash);
+    hash = SkChecksum::Hash32(&fAllowPrivateAccess, sizeof(fAllowPrivateAccess), hash);
+    hash = SkChecksum::Hash32(&fStableKey, sizeof(fStableKey), hash);
+    return SkChecksum::Hash32(&fMaxVersionAllowed, sizeof(fMaxVersionAllowed), hash);
+}
+
+namespace {
+
+// The IR for a program is typically an order of magnitude larger than its source. This doesn't
+// account for the Raster Pipeline program, which isn't built until the effect is drawn.
+constexpr size_t kIRBytesPerSourceByte = 16;
+
+size_t approximate_size(const SkRuntimeEffectCache::Key& key, const SkRuntimeEffect& effect) {
+    // The source is held by both the key and the program.
+    return sizeof(SkRuntimeEffect) +
+           key.fSource.size() * (2 + kIRBytesPerSourceByte) +
+           effect.uniforms().size() * sizeof(SkRuntimeEffect::Uniform) +
+           effect.children().size() * sizeof(SkRuntimeEffect::Child);
+}
+
+class Cache {
+public:
+    sk_sp<SkRuntimeEffect> find(const SkRuntimeEffectCache::Key& key) {
+        SkAutoMutexExclusive lock(fMutex);
+        Entry** found = fMap.find(key);
+        if (!found) {
+            ++fMisses;
+            return nullptr;
+        }
+        ++fHits;
+        this->makeMRU(*found);
+        return (*found)->fEffect;
+    }
+
+    sk_sp<SkRuntimeEffect> add(SkRuntimeEffectCache::Key key, sk_sp<SkRuntimeEffect> effect) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (Entry** found = fMap.find(key)) {
+            // Another thread compiled the same effect first.
+            this->makeMRU(*found);
+            return (*found)->fEffect;
+        }
+
+        size_t size = approximate_size(key, *effect);
+        if (size > fByteLimit) {
+            return effect;
+        }
+        Entry* entry = new Entry{std::move(key), effect, size};
+        fMap.set(entry);
+        fLRU.addToHead(entry);
+        fBytesUsed += size;
+        this->purgeAsNeeded(fByteLimit);
+        return effect;
+    }
+
+    size_t setByteLimit(size_t bytes) {
+        SkAutoMutexExclusive lock(fMutex);
+        size_t prevLimit = fByteLimit;
+        fByteLimit = bytes;
+        this->purgeAsNeeded(fByteLimit);
+        return prevLimit;
+    }
+
+    size_t getByteLimit() {
+        SkAutoMutexExclusive lock(fMutex);
+        return fByteLimit;
+    }
+
+    void purgeAll() {
+        SkAutoMutexExclusive lock(fMutex);
+        this->purgeAsNeeded(0);
+    }
+
+    SkRuntimeEffectCache::Stats stats() {
+        SkAutoMutexExclusive lock(fMutex);
+        return {fHits, fMisses, fEvictions, fMap.count(), fBytesUsed};
+    }
+
+private:
+    struct Entry {
+        SkRuntimeEffectCache::Key fKey;
+        sk_sp<SkRuntimeEffect>    fEffect;
+        size_t                    fSize;
+
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+    };
+
+    struct Traits {
+        static const SkRuntimeEffectCache::Key& GetKey(const Entry* e) { return e->fKey; }
+        static uint32_t Hash(const SkRuntimeEffectCache::Key& key) { return key.hash(); }
+    };
+
+    void makeMRU(Entry* entry) SK_REQUIRES(fMutex) {
+        if (entry != fLRU.head()) {
+            fLRU.remove(entry);
+            fLRU.addToHead(entry);
+        }
+    }
+
+    void purgeAsNeeded(size_t byteLimit) SK_REQUIRES(fMutex) {
+        while (fBytesUsed > byteLimit) {
+            Entry* entry = fLRU.tail();
+            SkASSERT(entry);
+            fLRU.remove(entry);
+            fMap.remove(entry->fKey);
+            fBytesUsed -= entry->fSize;
+            ++fEvictions;
+            delete entry;
+        }
+    }
+
+    SkMutex fMutex;
+    skia_private::THashTable<Entry*, SkRuntimeEffectCache::Key, Traits> fMap SK_GUARDED_BY(fMutex);
+    SkTInternalLList<Entry> fLRU SK_GUARDED_BY(fMutex);
+    size_t fByteLimit SK_GUARDED_BY(fMutex) = SkRuntimeEffectCache::kDefaultByteLimit;
+    size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fHits SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fMisses SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fEvictions SK_GUARDED_BY(fMutex) = 0;
+};
+
+Cache* global_cache() {
+    static SkNoDestructor<Cache> gCache;
+    return gCache.get();
+}
+
+}  // anonymous namespace
+
+sk_sp<SkRuntimeEffect> SkRuntimeEffectCache::Find(const Key& key) {
+    return global_cache()->find(key);
+}
+
+sk_sp<SkRuntimeEffect> SkRuntimeEffectCache::Add(Key key, sk_sp<SkRuntimeEffect> effect) {
+    SkASSERT(effect);
+    return global_cache()->add(std::move(key), std::move(effect));
+}
+
+size_t SkRuntimeEffectCache::SetByteLimit(size_t bytes) {
+    return global_cache()->setByteLimit(bytes);
+}
+
+size_t SkRuntimeEffectCache::GetByteLimit() {
+    return global_cache()->getByteLimit();
+}
+
+size_t SkRuntimeEffectCache::GetBytesUsed() {
+    return global_cache()->stats().fBytesUsed;
+}
+
+void SkRuntimeEffectCache::PurgeAll() {
+    global_cache()->purgeAll();
+}
+
+SkRuntimeEffectCache::Stats SkRuntimeEffectCache::GetStats() {
+    return global_cache()->stats();
+}
+
+void SkRuntimeEffectCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    static constexpr char kDumpName[] = "skia/sk_runtime_effect_cache";
+    Stats stats = GetStats();
+    dump->dumpNumericValue(kDumpName, "size", "bytes", stats.fBytesUsed);
+    dump->dumpNumericValue(kDumpName, "count", "objects", stats.fCount);
+    dump->dumpNumericValue(kDumpName, "hits", "objects", stats.fHits);
+    dump->dumpNumericValue(kDumpName, "misses", "objects", stats.fMisses);
+    dump->dumpNumericValue(kDumpName, "evictions", "objects", stats.fEvictions);
+    dump->setMemoryBacking(kDumpName, "malloc", nullptr);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRuntimeEffectCache_DEFINED
+#define SkRuntimeEffectCache_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/sksl/SkSLVersion.h"
+#include "src/sksl/SkSLProgramKind.h"
+
+#include <cstddef>
+#include <cstdint>
+
+class SkRuntimeEffect;
+class SkTraceMemoryDump;
+
+/**
+ * Process-wide cache of compiled SkRuntimeEffects, shared by every SkRuntimeEffect::Make*() call.
+ * Effects are immutable once made, so identical SkSL compiled with identical options can share a
+ * single effect: its parsed and optimized program, and the Raster Pipeline program that is built
+ * lazily from it the first time it is drawn on the CPU.
+ *
+ * The cache is LRU and bounded by an (approximate) number of bytes. It is thread-safe; compilation
+ * happens outside of the lock, so two threads may compile the same source at once, in which case
+ * both get the effect that was added first.
+ */
+class SkRuntimeEffectCache {
+public:
+    static constexpr size_t kDefaultByteLimit = 4 * 1024 * 1024;
+
+    // Everything that influences the compiled effect.
+    struct Key {
+        SkString          fSource;
+        SkSL::ProgramKind fKind;
+        bool              fForceUnoptimized;
+        bool              fAllowPrivateAccess;
+        uint32_t          fStableKey;
+        SkSL::Version     fMaxVersionAllowed;
+
+        bool operator==(const Key& that) const {
+            return fKind == that.fKind &&
+                   fForceUnoptimized == that.fForceUnoptimized &&
+                   fAllowPrivateAccess == that.fAllowPrivateAccess &&
+                   fStableKey == that.fStableKey &&
+                   fMaxVersionAllowed == that.fMaxVersionAllowed &&
+                   fSource == that.fSource;
+        }
+        uint32_t hash() const;
+    };
+
+    // Returns the cached effect for 'key', or nullptr (counted as a miss).
+    static sk_sp<SkRuntimeEffect> Find(const Key& key);
+
+    // Adds 'effect' and returns it, or returns the effect that is already cached for 'key'.
+    static sk_sp<SkRuntimeEffect> Add(Key key, sk_sp<SkRuntimeEffect> effect);
+
+    // Setting the limit to 0 disables the cache. Returns the previous limit.
+    static size_t SetByteLimit(size_t bytes);
+    static size_t GetByteLimit();
+    static size_t GetBytesUsed();
+
+    static void PurgeAll();
+
+    struct Stats {
+        uint64_t fHits;
+        uint64_t fMisses;
+        uint64_t fEvictions;
+        int      fCount;
+        size_t   fBytesUsed;
+    };
+    static Stats GetStats();
+
+    static void DumpMemoryStatistics(SkTraceMemoryDump*);
+};
+
+#endif
@@ -157,6 +157,26 @@ std::pair<const void*, SkIRect> Plot::prepareForUpload() {
     return { dataPtr, offsetRect };
 }
 
+bool Plot::copyFrom(const Plot& src) {
+    SkASSERT(fWidth == src.fWidth && fHeight == src.fHeight);
+    SkASSERT(fColorType == src.fColorType && fBytesPerPixel == src.fBytesPerPixel);
+    if (!src.fData) {
+        return false;
+    }
+
+    size_t size = fBytesPerPixel * fWidth * fHeight;
+    if (!fData) {
+        fData = reinterpret_cast<unsigned char*>(sk_malloc_throw(size));
+    }
+    memcpy(fData, src.fData, size);
+    fRectanizer.copyFrom(src.fRectanizer);
+
+    fDirtyRect = SkIRect::MakeWH(fWidth, fHeight);
+    fIsFull = false;
+    SkDEBUGCODE(fDirty = true;)
+    return true;
+}
+
 void Plot::resetRects() {
     fRectanizer.reset();
     fGenID = fGenerationCounter->next();
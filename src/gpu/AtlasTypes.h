@@ -490,6 +490,14 @@ public:
 
     void markFullIfUsed() { fIsFull = !fDirtyRect.isEmpty(); }
 
+    /**
+     * Replace the contents of this plot (which must have the same dimensions and format) with
+     * those of 'src', including its subimage placement, and mark the whole plot as needing
+     * upload. Subimages in 'src' at an offset from its origin are at the same offset from this
+     * plot's origin. Returns false, leaving this plot unchanged, if 'src' has no backing data.
+     */
+    bool copyFrom(const Plot& src);
+
     /**
      * Create a clone of this plot. The cloned plot will take the place of the current plot in
      * the atlas
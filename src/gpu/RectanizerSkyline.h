@@ -37,6 +37,13 @@ public:
 
     bool addRect(int w, int h, SkIPoint16* loc) final;
 
+    // Takes on the packing state of a rectanizer with the same dimensions.
+    void copyFrom(const RectanizerSkyline& other) {
+        SkASSERT(this->width() == other.width() && this->height() == other.height());
+        fSkyline = other.fSkyline;
+        fAreaSoFar = other.fAreaSoFar;
+    }
+
     float percentFull() const final {
         return fAreaSoFar / ((float)this->width() * this->height());
     }
@@ -46,6 +46,7 @@
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrSemaphore.h"  // IWYU pragma: keep
 #include "src/gpu/ganesh/GrShaderCaps.h"
+#include "src/gpu/ganesh/GrSizeClassAllocator.h"
 #include "src/gpu/ganesh/GrSurfaceProxy.h"
 #include "src/gpu/ganesh/GrSurfaceProxyView.h"
 #include "src/gpu/ganesh/GrThreadSafePipelineBuilder.h" // IWYU pragma: keep
@@ -57,6 +58,8 @@
 #include "src/gpu/ganesh/text/GrAtlasManager.h"
 #include "src/image/SkImage_Base.h"
 #include "src/image/SkSurface_Base.h"
+#include "src/sksl/SkSLModuleLoader.h"
+#include "src/sksl/SkSLProgramKind.h"
 #include "src/text/gpu/StrikeCache.h"
 #include "src/text/gpu/TextBlobRedrawCoordinator.h"
 
@@ -113,6 +116,8 @@ GrDirectContext::~GrDirectContext() {
     // This has to be after GrResourceCache::releaseAll so that other threads that are holding
     // async pixel result don't try to destroy buffers off thread.
     fMappedBufferManager.reset();
+
+    GrSizeClassAllocator::StopDumpingMemoryStatistics(this->contextID());
 }
 
 sk_sp<GrContextThreadSafeProxy> GrDirectContext::threadSafeProxy() {
@@ -239,6 +244,8 @@ void GrDirectContext::freeGpuResources() {
     this->drawingManager()->freeGpuResources();
 
     fResourceCache->purgeUnlockedResources(GrPurgeResourceOptions::kAllResources);
+
+    GrSizeClassAllocator::ReleaseThreadCache();
 }
 
 bool GrDirectContext::init() {
@@ -276,6 +283,20 @@ bool GrDirectContext::init() {
     // get passed on to/shared between all the DDLRecorders created with this context.
     if (this->options().fExecutor) {
         fTaskGroup = std::make_unique<SkTaskGroup>(*this->options().fExecutor);
+
+        // Every program Ganesh builds needs the fragment and vertex modules. Start loading them
+        // in the background, so the modules that don't depend on each other are compiled
+        // concurrently, and usually before the first program is built; building one sooner just
+        // loads what it needs on demand. This is a no-op once they've been loaded.
+        if (this->backend() != GrBackendApi::kMock) {
+            fTaskGroup->add([executor = this->options().fExecutor] {
+                static constexpr SkSL::ProgramKind kGaneshProgramKinds[] = {
+                        SkSL::ProgramKind::kFragment,
+                        SkSL::ProgramKind::kVertex,
+                };
+                SkSL::ModuleLoader::LoadModulesInParallel(kGaneshProgramKinds, *executor);
+            });
+        }
     }
 
     fPersistentCache = this->options().fPersistentCache;
@@ -381,6 +402,48 @@ void GrDirectContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed
     this->getTextBlobRedrawCoordinator()->purgeStaleBlobs();
 }
 
+bool GrDirectContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed,
+                                             std::chrono::microseconds timeBudget,
+                                             GrPurgeResourceOptions opts) {
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+
+    ASSERT_SINGLE_OWNER
+
+    if (this->abandoned()) {
+        return true;
+    }
+
+    auto now = skgpu::StdSteadyClock::now();
+    auto deadline = now + timeBudget;
+
+    this->checkAsyncWorkCompletion();
+    fMappedBufferManager->process();
+    auto purgeTime = now - msNotUsed;
+
+    // Getting back under budget takes priority over purging resources that are merely old.
+    if (!fResourceCache->purgeAsNeeded(deadline) ||
+        !fResourceCache->purgeResourcesNotUsedSince(purgeTime, opts, deadline)) {
+        return false;
+    }
+
+    // The textBlob Cache doesn't actually hold any GPU resource but this is a convenient
+    // place to purge stale blobs
+    this->getTextBlobRedrawCoordinator()->purgeStaleBlobs();
+    return true;
+}
+
+void GrDirectContext::getResourceCachePurgeStats(int* purgedResourceCount,
+                                                 size_t* purgedBytes) const {
+    ASSERT_SINGLE_OWNER
+
+    if (purgedResourceCount) {
+        *purgedResourceCount = fResourceCache->getPurgedResourceCount();
+    }
+    if (purgedBytes) {
+        *purgedBytes = fResourceCache->getPurgedBytes();
+    }
+}
+
 void GrDirectContext::purgeUnlockedResources(size_t bytesToPurge, bool preferScratchResources) {
     ASSERT_SINGLE_OWNER
 
@@ -562,6 +625,10 @@ void GrDirectContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) c
     fResourceCache->dumpMemoryStatistics(traceMemoryDump);
     traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "size", "bytes",
                                       this->getTextBlobRedrawCoordinator()->usedBytes());
+    GrSizeClassAllocator::DumpMemoryStatistics(traceMemoryDump, this->contextID());
+    if (fAtlasManager) {
+        fAtlasManager->dumpMemoryStatistics(traceMemoryDump);
+    }
 }
 
 GrBackendTexture GrDirectContext::createBackendTexture(int width,
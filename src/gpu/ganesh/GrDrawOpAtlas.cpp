@@ -74,7 +74,8 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
                                                    GenerationCounter* generationCounter,
                                                    AllowMultitexturing allowMultitexturing,
                                                    EvictionCallback* evictor,
-                                                   std::string_view label) {
+                                                   std::string_view label,
+                                                   CompactionMode compactionMode) {
     if (!format.isValid()) {
         return nullptr;
     }
@@ -82,7 +83,8 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
     std::unique_ptr<GrDrawOpAtlas> atlas(new GrDrawOpAtlas(proxyProvider, format, colorType, bpp,
                                                            width, height, plotWidth, plotHeight,
                                                            generationCounter,
-                                                           allowMultitexturing, label));
+                                                           allowMultitexturing, label,
+                                                           compactionMode));
     if (!atlas->createPages(proxyProvider, generationCounter) || !atlas->getViews()[0].proxy()) {
         return nullptr;
     }
@@ -98,7 +100,8 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
 GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendFormat& format,
                              SkColorType colorType, size_t bpp, int width, int height,
                              int plotWidth, int plotHeight, GenerationCounter* generationCounter,
-                             AllowMultitexturing allowMultitexturing, std::string_view label)
+                             AllowMultitexturing allowMultitexturing, std::string_view label,
+                             CompactionMode compactionMode)
         : fFormat(format)
         , fColorType(colorType)
         , fBytesPerPixel(bpp)
@@ -111,6 +114,7 @@ GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendForm
         , fAtlasGeneration(fGenerationCounter->next())
         , fPrevFlushToken(AtlasToken::InvalidToken())
         , fFlushesSinceLastUse(0)
+        , fCompactionMode(compactionMode)
         , fMaxPages(AllowMultitexturing::kYes == allowMultitexturing ?
                             PlotLocator::kMaxMultitexturePages : 1)
         , fNumActivePages(0) {
@@ -140,6 +144,7 @@ void GrDrawOpAtlas::uploadPlotToTexture(GrDeferredTextureUploadWritePixelsFn& wr
     const void* dataPtr;
     SkIRect rect;
     std::tie(dataPtr, rect) = plot->prepareForUpload();
+    fStats.fUploadBytes += fBytesPerPixel * rect.width() * rect.height();
 
     writePixels(proxy,
                 rect,
@@ -177,6 +182,77 @@ inline bool GrDrawOpAtlas::updatePlot(GrDeferredUploadTarget* target,
     return true;
 }
 
+bool GrDrawOpAtlas::lookup(GrDeferredUploadTarget* target, AtlasLocator* atlasLocator) {
+    PlotLocator plotLocator = atlasLocator->plotLocator();
+    if (this->hasID(plotLocator)) {
+        ++fStats.fHits;
+        return true;
+    }
+
+    // Follow the plot through any relocations (it may have been moved more than once).
+    SkIPoint offset = {0, 0};
+    bool relocated = false;
+    while (plotLocator.isValid() && !this->hasID(plotLocator)) {
+        const Relocation* relocation = fRelocations.find(plotLocator.genID());
+        if (!relocation) {
+            break;
+        }
+        plotLocator = relocation->fPlotLocator;
+        offset += relocation->fOffset;
+        relocated = true;
+    }
+    if (!relocated || !this->hasID(plotLocator)) {
+        ++fStats.fMisses;
+        return false;
+    }
+
+    SkIPoint topLeft = atlasLocator->topLeft() + offset;
+    atlasLocator->updateRect(skgpu::IRect16::MakeXYWH(SkToS16(topLeft.x()),
+                                                      SkToS16(topLeft.y()),
+                                                      atlasLocator->width(),
+                                                      atlasLocator->height()));
+    atlasLocator->updatePlotLocator(plotLocator);
+    SkDEBUGCODE(this->validate(*atlasLocator);)
+
+    // The relocated data is uploaded the first time any of it is needed.
+    Plot* plot = fPages[plotLocator.pageIndex()].fPlotArray[plotLocator.plotIndex()].get();
+    if (plot->needsUpload() && !this->updatePlot(target, atlasLocator, plot)) {
+        ++fStats.fMisses;
+        return false;
+    }
+
+    ++fStats.fHits;
+    ++fStats.fRelocatedHits;
+    return true;
+}
+
+SkIPoint GrDrawOpAtlas::plotOffset(uint32_t plotIndex) const {
+    // This matches the plot layout set up in createPages()
+    int numPlotsX = fTextureWidth / fPlotWidth;
+    int numPlotsY = fTextureHeight / fPlotHeight;
+    int x = numPlotsX - 1 - plotIndex % numPlotsX;
+    int y = numPlotsY - 1 - plotIndex / numPlotsX;
+    return {x * fPlotWidth, y * fPlotHeight};
+}
+
+void GrDrawOpAtlas::relocatePlot(Plot* src, Plot* dst) {
+    // The destination's own contents have aged out, so they are evicted as usual.
+    this->processEvictionAndResetRects(dst);
+
+    if (dst->copyFrom(*src)) {
+        fRelocations.set(src->genID(),
+                         {dst->plotLocator(),
+                          this->plotOffset(dst->plotIndex()) - this->plotOffset(src->plotIndex())});
+        dst->setLastUseToken(src->lastUseToken());
+        this->makeMRU(dst, dst->pageIndex());
+        ++fStats.fRelocatedPlots;
+    }
+
+    // Eviction callbacks are still notified; clients that don't use lookup() will re-add their
+    // data as if the plot had been evicted.
+    this->processEvictionAndResetRects(src);
+}
+
 bool GrDrawOpAtlas::uploadToPage(unsigned int pageIdx, GrDeferredUploadTarget* target, int width,
                                  int height, const void* image, AtlasLocator* atlasLocator) {
     SkASSERT(fViews[pageIdx].proxy() && fViews[pageIdx].proxy()->isInstantiated());
@@ -432,8 +508,12 @@ void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
                     // We need to be somewhat harsh here so that a handful of plots that are
                     // consistently in use don't end up locking the page in memory.
                     if (!availablePlots.empty()) {
-                        this->processEvictionAndResetRects(plot);
-                        this->processEvictionAndResetRects(availablePlots.back());
+                        if (fCompactionMode == CompactionMode::kRelocate) {
+                            this->relocatePlot(plot, availablePlots.back());
+                        } else {
+                            this->processEvictionAndResetRects(plot);
+                            this->processEvictionAndResetRects(availablePlots.back());
+                        }
                         availablePlots.pop_back();
                         --usedPlots;
                     }
@@ -456,6 +536,20 @@ void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
         }
     }
 
+    // Forget relocations whose destination has since been evicted (unless it was relocated again)
+    if (!fRelocations.empty()) {
+        TArray<uint64_t> staleRelocations;
+        fRelocations.foreach([&](uint64_t genID, const Relocation& relocation) {
+            if (!this->hasID(relocation.fPlotLocator) &&
+                !fRelocations.find(relocation.fPlotLocator.genID())) {
+                staleRelocations.push_back(genID);
+            }
+        });
+        for (uint64_t genID : staleRelocations) {
+            fRelocations.remove(genID);
+        }
+    }
+
     fPrevFlushToken = startTokenForNextFlush;
 }
 
@@ -13,6 +13,7 @@
 
 #include "include/gpu/GrBackendSurface.h"
 #include "src/core/SkIPoint16.h"
+#include "src/core/SkTHash.h"
 #include "src/gpu/AtlasTypes.h"
 #include "src/gpu/RectanizerSkyline.h"
 #include "src/gpu/ganesh/GrDeferredUpload.h"
@@ -43,7 +44,10 @@ class GrTextureProxy;
  * is checked to see whether it was used in that flush. If less than a quarter of the plots have
  * been used recently (within kPlotRecentlyUsedCount iterations) and there are available
  * plots in lower index pages, the higher index page will be deactivated, and its glyphs will
- * gradually migrate to other pages via the usual upload system.
+ * gradually migrate to other pages via the usual upload system. With CompactionMode::kRelocate
+ * the recently used plots are instead copied into the available plots of the lower pages, and
+ * clients that look up their subimages with lookup() are redirected to the new location without
+ * having to re-add them.
  *
  * Garbage collection is initiated by the GrDrawOpAtlas's client via the compact() method. One
  * solution is to make the client a subclass of GrOnFlushCallbackObject, register it with the
@@ -55,6 +59,12 @@ public:
     /** Is the atlas allowed to use more than one texture? */
     enum class AllowMultitexturing : bool { kNo, kYes };
 
+    /**
+     * How compact() empties the last page. kEvict evicts its recently used plots so their
+     * contents are re-added by clients; kRelocate moves the plots' contents to earlier pages.
+     */
+    enum class CompactionMode : bool { kEvict, kRelocate };
+
     /**
      * Returns a GrDrawOpAtlas. This function can be called anywhere, but the returned atlas
      * should only be used inside of GrMeshDrawOp::onPrepareDraws.
@@ -71,6 +81,7 @@ public:
      *  @param allowMultitexturing Can the atlas use more than one texture.
      *  @param evictor             A pointer to an eviction callback class.
      *  @param label               A label for the atlas texture.
+     *  @param compactionMode      How compact() frees the last page.
      *
      *  @return                    An initialized DrawAtlas, or nullptr if creation fails.
      */
@@ -82,7 +93,9 @@ public:
                                                skgpu::AtlasGenerationCounter* generationCounter,
                                                AllowMultitexturing allowMultitexturing,
                                                skgpu::PlotEvictionCallback* evictor,
-                                               std::string_view label);
+                                               std::string_view label,
+                                               CompactionMode compactionMode =
+                                                       CompactionMode::kEvict);
 
     /**
      * Adds a width x height subimage to the atlas. Upon success it returns 'kSucceeded' and returns
@@ -125,6 +138,26 @@ public:
         return plot < fNumPlots && page < fNumActivePages && plotGeneration == locatorGeneration;
     }
 
+    /**
+     * Returns true if the subimage at 'atlasLocator' is still in the atlas. If its plot has been
+     * relocated by compact(), 'atlasLocator' is updated to the new location (scheduling an upload
+     * of the plot if necessary). Unlike hasID(), this is counted in stats().
+     */
+    bool lookup(GrDeferredUploadTarget*, skgpu::AtlasLocator*);
+
+    struct Stats {
+        // Calls to lookup() that found the subimage, including those that were redirected
+        uint64_t fHits = 0;
+        uint64_t fRelocatedHits = 0;
+        // Calls to lookup() where the subimage had been evicted and has to be added again
+        uint64_t fMisses = 0;
+        // Plots moved to an earlier page by compact() instead of being evicted
+        uint64_t fRelocatedPlots = 0;
+        // Bytes of plot data uploaded to the atlas textures
+        uint64_t fUploadBytes = 0;
+    };
+    const Stats& stats() const { return fStats; }
+
     /** To ensure the atlas does not evict a given entry, the client must set the last use token. */
     void setLastUseToken(const skgpu::AtlasLocator& atlasLocator, skgpu::AtlasToken token) {
         SkASSERT(this->hasID(atlasLocator.plotLocator()));
@@ -168,7 +201,8 @@ private:
     GrDrawOpAtlas(GrProxyProvider*, const GrBackendFormat& format, SkColorType, size_t bpp,
                   int width, int height, int plotWidth, int plotHeight,
                   skgpu::AtlasGenerationCounter* generationCounter,
-                  AllowMultitexturing allowMultitexturing, std::string_view label);
+                  AllowMultitexturing allowMultitexturing, std::string_view label,
+                  CompactionMode compactionMode);
 
     inline bool updatePlot(GrDeferredUploadTarget*, skgpu::AtlasLocator*, skgpu::Plot*);
 
@@ -201,6 +235,11 @@ private:
         plot->resetRects();
     }
 
+    // Moves the contents of 'src' into the aged-out plot 'dst' and evicts 'src'.
+    void relocatePlot(skgpu::Plot* src, skgpu::Plot* dst);
+    // Offset of the plot with the given index from the origin of its page
+    SkIPoint plotOffset(uint32_t plotIndex) const;
+
     GrBackendFormat       fFormat;
     SkColorType           fColorType;
     size_t                fBytesPerPixel;
@@ -227,6 +266,18 @@ private:
 
     std::vector<skgpu::PlotEvictionCallback*> fEvictionCallbacks;
 
+    CompactionMode fCompactionMode;
+
+    // Where the contents of relocated plots went, keyed by the generation of the source plot.
+    // The offset is added to the subimage coordinates.
+    struct Relocation {
+        skgpu::PlotLocator fPlotLocator;
+        SkIPoint fOffset;
+    };
+    skia_private::THashMap<uint64_t, Relocation> fRelocations;
+
+    Stats fStats;
+
     struct Page {
         // allocated array of Plots
         std::unique_ptr<sk_sp<skgpu::Plot>[]> fPlotArray;
@@ -23,6 +23,7 @@
 #include "src/gpu/ganesh/GrDrawingManager.h"
 #include "src/gpu/ganesh/GrProgramDesc.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
+#include "src/gpu/ganesh/GrSizeClassAllocator.h"
 #include "src/gpu/ganesh/PathRendererChain.h"
 #include "src/gpu/ganesh/ops/AtlasTextOp.h"
 #include "src/text/gpu/SubRunAllocator.h"
@@ -56,6 +57,7 @@ GrRecordingContext::GrRecordingContext(sk_sp<GrContextThreadSafeProxy> proxy, bo
 
 GrRecordingContext::~GrRecordingContext() {
     skgpu::ganesh::AtlasTextOp::ClearCache();
+    GrSizeClassAllocator::ReleaseThreadCache();
 }
 
 bool GrRecordingContext::init() {
@@ -438,7 +438,19 @@ void GrResourceCache::didChangeBudgetStatus(GrGpuResource* resource) {
     this->validate();
 }
 
-void GrResourceCache::purgeAsNeeded() {
+static bool deadline_passed(const skgpu::StdSteadyClock::time_point* deadline) {
+    return deadline && skgpu::StdSteadyClock::now() >= *deadline;
+}
+
+void GrResourceCache::purgeResource(GrGpuResource* resource) {
+    SkASSERT(resource->resourcePriv().isPurgeable());
+    fPurgedResourceCount++;
+    fPurgedBytes += resource->gpuMemorySize();
+    resource->cacheAccess().release();
+    TRACE_COUNTER1("skia.gpu.cache", "skia purged bytes", fPurgedBytes);
+}
+
+bool GrResourceCache::purgeAsNeeded(const skgpu::StdSteadyClock::time_point* deadline) {
     TArray<skgpu::UniqueKeyInvalidatedMessage> invalidKeyMsgs;
     fInvalidUniqueKeyInbox.poll(&invalidKeyMsgs);
     if (!invalidKeyMsgs.empty()) {
@@ -459,12 +471,16 @@ void GrResourceCache::purgeAsNeeded() {
 
     this->processFreedGpuResources();
 
+    // At least one resource is released per call, even if the deadline has already passed, so
+    // that repeated time-sliced calls always make progress.
     bool stillOverbudget = this->overBudget();
     while (stillOverbudget && fPurgeableQueue.count()) {
-        GrGpuResource* resource = fPurgeableQueue.peek();
-        SkASSERT(resource->resourcePriv().isPurgeable());
-        resource->cacheAccess().release();
+        this->purgeResource(fPurgeableQueue.peek());
         stillOverbudget = this->overBudget();
+        if (stillOverbudget && deadline_passed(deadline)) {
+            this->validate();
+            return false;
+        }
     }
 
     if (stillOverbudget) {
@@ -472,18 +488,22 @@ void GrResourceCache::purgeAsNeeded() {
 
         stillOverbudget = this->overBudget();
         while (stillOverbudget && fPurgeableQueue.count()) {
-            GrGpuResource* resource = fPurgeableQueue.peek();
-            SkASSERT(resource->resourcePriv().isPurgeable());
-            resource->cacheAccess().release();
+            this->purgeResource(fPurgeableQueue.peek());
             stillOverbudget = this->overBudget();
+            if (stillOverbudget && deadline_passed(deadline)) {
+                this->validate();
+                return false;
+            }
         }
     }
 
     this->validate();
+    return true;
 }
 
-void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_point* purgeTime,
-                                             GrPurgeResourceOptions opts) {
+bool GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_point* purgeTime,
+                                             GrPurgeResourceOptions opts,
+                                             const skgpu::StdSteadyClock::time_point* deadline) {
     if (opts == GrPurgeResourceOptions::kAllResources) {
         if (purgeTime) {
             fThreadSafeCache->dropUniqueRefsOlderThan(*purgeTime);
@@ -493,6 +513,7 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
 
         // We could disable maintaining the heap property here, but it would add a lot of
         // complexity. Moreover, this is rarely called.
+        bool purgedAny = false;
         while (fPurgeableQueue.count()) {
             GrGpuResource* resource = fPurgeableQueue.peek();
 
@@ -506,9 +527,14 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
                 // one.
                 break;
             }
+            // Always make progress, even if the deadline passed before the call.
+            if (purgedAny && deadline_passed(deadline)) {
+                this->validate();
+                return false;
+            }
 
-            SkASSERT(resource->resourcePriv().isPurgeable());
-            resource->cacheAccess().release();
+            this->purgeResource(resource);
+            purgedAny = true;
         }
     } else {
         SkASSERT(opts == GrPurgeResourceOptions::kScratchResourcesOnly);
@@ -516,7 +542,7 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
         // nothing will be deleted.
         if (purgeTime && fPurgeableQueue.count() &&
             fPurgeableQueue.peek()->cacheAccess().timeWhenResourceBecamePurgeable() >= *purgeTime) {
-            return;
+            return true;
         }
 
         // Sort the queue
@@ -540,13 +566,19 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
         }
 
         // Delete the scratch resources. This must be done as a separate pass
-        // to avoid messing up the sorted order of the queue
+        // to avoid messing up the sorted order of the queue. If the deadline passes, the
+        // remaining resources stay in the queue and are found again by the next call.
         for (int i = 0; i < scratchResources.size(); i++) {
-            scratchResources[i]->cacheAccess().release();
+            this->purgeResource(scratchResources[i]);
+            if (i + 1 < scratchResources.size() && deadline_passed(deadline)) {
+                this->validate();
+                return false;
+            }
         }
     }
 
     this->validate();
+    return true;
 }
 
 bool GrResourceCache::purgeToMakeHeadroom(size_t desiredHeadroomBytes) {
@@ -583,7 +615,7 @@ bool GrResourceCache::purgeToMakeHeadroom(size_t desiredHeadroomBytes) {
         resources.push_back(fPurgeableQueue.at(i));
     }
     for (GrGpuResource* resource : resources) {
-        resource->cacheAccess().release();
+        this->purgeResource(resource);
     }
     return true;
 }
@@ -613,7 +645,7 @@ void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScr
         // Delete the scratch resources. This must be done as a separate pass
         // to avoid messing up the sorted order of the queue
         for (int i = 0; i < scratchResources.size(); i++) {
-            scratchResources[i]->cacheAccess().release();
+            this->purgeResource(scratchResources[i]);
         }
         stillOverbudget = tmpByteBudget < fBytes;
 
@@ -165,13 +165,22 @@ public:
 
     /** Purges resources to become under budget and processes resources with invalidated unique
         keys. */
-    void purgeAsNeeded();
+    void purgeAsNeeded() { this->purgeAsNeeded(/*deadline=*/nullptr); }
+
+    /** Time-sliced version of purgeAsNeeded(). Resources are released in the same LRU order but
+        no more are released once 'deadline' has passed, so that a large purge (e.g. after the
+        budget shrinks) can be spread across several frames. Since the purgeable queue is LRU
+        ordered, the next call resumes with the oldest resource that is left. Returns false if the
+        deadline passed before the purge completed. */
+    bool purgeAsNeeded(skgpu::StdSteadyClock::time_point deadline) {
+        return this->purgeAsNeeded(&deadline);
+    }
 
     // Purge unlocked resources. If 'opts' is kScratchResourcesOnly, the purgeable resources
     // containing persistent data are spared. If it is kAllResources then all purgeable resources
     // will be deleted.
     void purgeUnlockedResources(GrPurgeResourceOptions opts) {
-        this->purgeUnlockedResources(/*purgeTime=*/nullptr, opts);
+        this->purgeUnlockedResources(/*purgeTime=*/nullptr, opts, /*deadline=*/nullptr);
     }
 
     // Purge unlocked resources not used since the passed point in time. If 'opts' is
@@ -179,7 +188,16 @@ public:
     // If it is kAllResources then all purgeable resources older than 'purgeTime' will be deleted.
     void purgeResourcesNotUsedSince(skgpu::StdSteadyClock::time_point purgeTime,
                                     GrPurgeResourceOptions opts) {
-        this->purgeUnlockedResources(&purgeTime, opts);
+        this->purgeUnlockedResources(&purgeTime, opts, /*deadline=*/nullptr);
+    }
+
+    // Time-sliced version of purgeResourcesNotUsedSince() that stops releasing resources once
+    // 'deadline' has passed. Returns true if every resource older than 'purgeTime' was purged,
+    // or false if the call should be repeated later to finish the work.
+    bool purgeResourcesNotUsedSince(skgpu::StdSteadyClock::time_point purgeTime,
+                                    GrPurgeResourceOptions opts,
+                                    skgpu::StdSteadyClock::time_point deadline) {
+        return this->purgeUnlockedResources(&purgeTime, opts, &deadline);
     }
 
     /** If it's possible to purge enough resources to get the provided amount of budget
@@ -189,6 +207,12 @@ public:
 
     bool overBudget() const { return fBudgetedBytes > fMaxBytes; }
 
+    /** Running totals of the resources released by the purge methods above, i.e. not counting
+        resources released by abandonAll() or releaseAll(). Sampling these once per frame gives
+        the number of bytes purged per frame. */
+    int getPurgedResourceCount() const { return fPurgedResourceCount; }
+    size_t getPurgedBytes() const { return fPurgedBytes; }
+
     /**
      * Purge unlocked resources from the cache until the the provided byte count has been reached
      * or we have purged all unlocked resources. The default policy is to purge in LRU order, but
@@ -316,8 +340,15 @@ private:
 
     uint32_t getNextTimestamp();
 
-    void purgeUnlockedResources(const skgpu::StdSteadyClock::time_point* purgeTime,
-                                GrPurgeResourceOptions opts);
+    // A null 'deadline' means the purge is not time-limited. These return true if the purge
+    // completed, or false if it stopped early because the deadline passed.
+    bool purgeAsNeeded(const skgpu::StdSteadyClock::time_point* deadline);
+    bool purgeUnlockedResources(const skgpu::StdSteadyClock::time_point* purgeTime,
+                                GrPurgeResourceOptions opts,
+                                const skgpu::StdSteadyClock::time_point* deadline);
+
+    // Releases a purgeable resource and adds it to the purge telemetry.
+    void purgeResource(GrGpuResource*);
 
 #ifdef SK_DEBUG
     bool isInCache(const GrGpuResource* r) const;
@@ -392,6 +423,10 @@ private:
     size_t                              fPurgeableBytes = 0;
     int                                 fNumBudgetedResourcesFlushWillMakePurgeable = 0;
 
+    // purge telemetry
+    int                                 fPurgedResourceCount = 0;
+    size_t                              fPurgedBytes = 0;
+
     InvalidUniqueKeyInbox               fInvalidUniqueKeyInbox;
     UnrefResourceMessage::Bus::Inbox    fUnrefResourceInbox;
 
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/GrSizeClassAllocator.h"
+
+#include "include/core/SkTraceMemoryDump.h"
+#include "include/private/base/SkASAN.h"
+#include "include/private/base/SkAssert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace {
+
+// Every allocation is preceded by a header that records its size class, padded so that the
+// user-facing pointer keeps the allocator's alignment.
+constexpr size_t kHeaderSize = GrSizeClassAllocator::kAlignment;
+constexpr int kNumSizeClasses =
+        GrSizeClassAllocator::kMaxSizeClassSize / GrSizeClassAllocator::kAlignment;
+constexpr uint32_t kLargeAllocation = kNumSizeClasses;
+
+struct Header {
+    uint32_t fSizeClass;
+#if defined(SK_DEBUG)
+    uint32_t fSentinel;
+#endif
+};
+static_assert(sizeof(Header) <= kHeaderSize);
+
+#if defined(SK_DEBUG)
+constexpr uint32_t kAllocatedSentinel = 0xA110CA7E;
+constexpr uint32_t kFreedSentinel = 0xF4EEF4EE;
+#endif
+
+// Free blocks are linked through the (no longer used) memory after their header.
+struct FreeBlock {
+    FreeBlock* fNext;
+};
+
+// Anything left on the free lists when a thread exits is returned to the system by the destructor.
+// Blocks released on the thread after that (by later thread_local destructors) are not cached.
+struct ThreadCache {
+    ~ThreadCache();
+
+    void releaseFreeLists();
+
+    FreeBlock* fFreeLists[kNumSizeClasses];
+    size_t fCachedBytes;
+    bool fExited;
+
+    // Stats that haven't been added to the global counters yet
+    uint32_t fPendingAllocations;
+    uint32_t fPendingRecycledAllocations;
+    int64_t fPendingCachedBytes;
+};
+static thread_local ThreadCache gThreadCache;
+
+constexpr uint32_t kPublishInterval = 256;
+
+std::atomic<uint64_t> gAllocations{0};
+std::atomic<uint64_t> gRecycledAllocations{0};
+std::atomic<int64_t> gCachedBytes{0};
+
+// The context that reports the counters in memory dumps, or 0 if none has yet.
+std::atomic<uint32_t> gDumpingContextID{0};
+
+void publish_stats(ThreadCache* cache) {
+    gAllocations.fetch_add(cache->fPendingAllocations, std::memory_order_relaxed);
+    gRecycledAllocations.fetch_add(cache->fPendingRecycledAllocations, std::memory_order_relaxed);
+    gCachedBytes.fetch_add(cache->fPendingCachedBytes, std::memory_order_relaxed);
+    cache->fPendingAllocations = 0;
+    cache->fPendingRecycledAllocations = 0;
+    cache->fPendingCachedBytes = 0;
+}
+
+// The number of bytes allocated from the system for a size class, including the header.
+constexpr size_t block_size(uint32_t sizeClass) {
+    return kHeaderSize + (sizeClass + 1) * GrSizeClassAllocator::kAlignment;
+}
+
+Header* header_for(void* p) {
+    return reinterpret_cast<Header*>(static_cast<char*>(p) - kHeaderSize);
+}
+
+void* user_ptr(Header* header) {
+    return reinterpret_cast<char*>(header) + kHeaderSize;
+}
+
+void ThreadCache::releaseFreeLists() {
+    for (uint32_t sizeClass = 0; sizeClass < kNumSizeClasses; ++sizeClass) {
+        FreeBlock* block = fFreeLists[sizeClass];
+        while (block) {
+            sk_asan_unpoison_memory_region(block, block_size(sizeClass) - kHeaderSize);
+            FreeBlock* next = block->fNext;
+            ::operator delete(header_for(block));
+            block = next;
+        }
+        fFreeLists[sizeClass] = nullptr;
+    }
+    fPendingCachedBytes -= fCachedBytes;
+    fCachedBytes = 0;
+    publish_stats(this);
+}
+
+ThreadCache::~ThreadCache() {
+    this->releaseFreeLists();
+    fExited = true;
+}
+
+}  // anonymous namespace
+
+void* GrSizeClassAllocator::Allocate(size_t size) {
+    ThreadCache* cache = &gThreadCache;
+
+    Header* header;
+    if (size <= kMaxSizeClassSize) {
+        uint32_t sizeClass = (std::max<size_t>(size, 1) - 1) / kAlignment;
+        if (FreeBlock* block = cache->fFreeLists[sizeClass]) {
+            sk_asan_unpoison_memory_region(block, block_size(sizeClass) - kHeaderSize);
+            cache->fFreeLists[sizeClass] = block->fNext;
+            cache->fCachedBytes -= block_size(sizeClass);
+            cache->fPendingCachedBytes -= block_size(sizeClass);
+            cache->fPendingRecycledAllocations++;
+            header = header_for(block);
+            SkASSERT(header->fSentinel == kFreedSentinel);
+        } else {
+            header = static_cast<Header*>(::operator new(block_size(sizeClass)));
+        }
+        header->fSizeClass = sizeClass;
+    } else {
+        header = static_cast<Header*>(::operator new(kHeaderSize + size));
+        header->fSizeClass = kLargeAllocation;
+    }
+    SkDEBUGCODE(header->fSentinel = kAllocatedSentinel;)
+
+    if (++cache->fPendingAllocations == kPublishInterval) {
+        publish_stats(cache);
+    }
+    return user_ptr(header);
+}
+
+void GrSizeClassAllocator::Release(void* p) {
+    if (!p) {
+        return;
+    }
+    Header* header = header_for(p);
+    SkASSERT(header->fSentinel == kAllocatedSentinel);
+    SkDEBUGCODE(header->fSentinel = kFreedSentinel;)
+
+    uint32_t sizeClass = header->fSizeClass;
+    ThreadCache* cache = &gThreadCache;
+    if (sizeClass != kLargeAllocation && !cache->fExited &&
+        cache->fCachedBytes + block_size(sizeClass) <= kMaxCachedBytesPerThread) {
+#if defined(SK_DEBUG)
+        // Scrub the contents to catch use-after-free errors.
+        memset(p, 0xDD, block_size(sizeClass) - kHeaderSize);
+#endif
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->fNext = cache->fFreeLists[sizeClass];
+        cache->fFreeLists[sizeClass] = block;
+        cache->fCachedBytes += block_size(sizeClass);
+        cache->fPendingCachedBytes += block_size(sizeClass);
+        sk_asan_poison_memory_region(block, block_size(sizeClass) - kHeaderSize);
+        return;
+    }
+    ::operator delete(header);
+}
+
+void GrSizeClassAllocator::ReleaseThreadCache() {
+    gThreadCache.releaseFreeLists();
+}
+
+size_t GrSizeClassAllocator::ThreadCachedBytes() {
+    return gThreadCache.fCachedBytes;
+}
+
+GrSizeClassAllocator::Stats GrSizeClassAllocator::GetStats() {
+    // Include the calling thread's unpublished counts; other threads' may lag behind.
+    const ThreadCache& cache = gThreadCache;
+    Stats stats;
+    stats.fAllocations = gAllocations.load(std::memory_order_relaxed) + cache.fPendingAllocations;
+    stats.fRecycledAllocations = gRecycledAllocations.load(std::memory_order_relaxed) +
+                                 cache.fPendingRecycledAllocations;
+    int64_t cachedBytes = gCachedBytes.load(std::memory_order_relaxed) + cache.fPendingCachedBytes;
+    stats.fCachedBytes = static_cast<uint64_t>(std::max<int64_t>(cachedBytes, 0));
+    return stats;
+}
+
+void GrSizeClassAllocator::DumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump,
+                                                uint32_t contextID) {
+    // The counters are process-wide, so only one context reports them; the first one to dump
+    // claims that until it stops.
+    uint32_t reporter = 0;
+    if (!gDumpingContextID.compare_exchange_strong(reporter, contextID) && reporter != contextID) {
+        return;
+    }
+
+    static constexpr char kDumpName[] = "skia/gr_size_class_allocator";
+    Stats stats = GetStats();
+    traceMemoryDump->dumpNumericValue(kDumpName, "size", "bytes", stats.fCachedBytes);
+    traceMemoryDump->dumpNumericValue(kDumpName, "allocations", "objects", stats.fAllocations);
+    traceMemoryDump->dumpNumericValue(kDumpName, "recycled_allocations", "objects",
+                                      stats.fRecycledAllocations);
+}
+
+void GrSizeClassAllocator::StopDumpingMemoryStatistics(uint32_t contextID) {
+    gDumpingContextID.compare_exchange_strong(contextID, 0);
+}
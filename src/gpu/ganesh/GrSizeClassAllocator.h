@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrSizeClassAllocator_DEFINED
+#define GrSizeClassAllocator_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+
+class SkTraceMemoryDump;
+
+/**
+ * Allocator for the short-lived, small objects that are created while recording draws (GrOps and
+ * GrProcessors). Allocations are rounded up to a size class and, when released, are kept on a
+ * per-thread free list for that size class so that the next frame can reuse them without going
+ * through the system allocator.
+ *
+ * Unlike GrMemoryPool there is no owner that has to outlive the allocations: memory may be
+ * released on a different thread than it was allocated on, in which case it is recycled by the
+ * releasing thread. Each thread keeps at most kMaxCachedBytesPerThread on its free lists; anything
+ * beyond that, and any allocation larger than kMaxSizeClassSize, goes back to the system allocator.
+ * Allocations are aligned to kAlignment.
+ */
+class GrSizeClassAllocator {
+public:
+#ifdef SK_FORCE_8_BYTE_ALIGNMENT
+    static constexpr size_t kAlignment = 8;
+#else
+    static constexpr size_t kAlignment = alignof(std::max_align_t);
+#endif
+    static constexpr size_t kMaxSizeClassSize = 1024;
+    static constexpr size_t kMaxCachedBytesPerThread = 256 * 1024;
+
+    static void* Allocate(size_t size);
+    // 'p' must have been returned by Allocate(), on any thread.
+    static void Release(void* p);
+
+    // Returns the memory cached by the calling thread to the system allocator. This also happens
+    // when the thread exits.
+    static void ReleaseThreadCache();
+
+    // Bytes currently held on the calling thread's free lists.
+    static size_t ThreadCachedBytes();
+
+    struct Stats {
+        // Total number of calls to Allocate().
+        uint64_t fAllocations;
+        // Number of those calls that were satisfied from a free list.
+        uint64_t fRecycledAllocations;
+        // Bytes currently held on the free lists of all threads.
+        uint64_t fCachedBytes;
+    };
+    // The counters are published by each thread periodically, so they may lag slightly behind.
+    static Stats GetStats();
+
+    // The counters are process-wide, so they are only dumped for one context at a time: the
+    // first to dump them, until it calls StopDumpingMemoryStatistics() with the same ID.
+    static void DumpMemoryStatistics(SkTraceMemoryDump*, uint32_t contextID);
+    static void StopDumpingMemoryStatistics(uint32_t contextID);
+};
+
+#endif
@@ -258,6 +258,7 @@ private:
             tessellator.append(iter.deviceQuad(), iter.localQuad(),
                                info.fColor, kEmptyDomain, info.fAAFlags);
         }
+        tessellator.flush();
     }
 
     void onPrepareDraws(GrMeshDrawTarget* target) override {
@@ -13,6 +13,7 @@
 #include "include/core/SkString.h"
 #include "src/gpu/ganesh/GrGpuResource.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
+#include "src/gpu/ganesh/GrSizeClassAllocator.h"
 #include "src/gpu/ganesh/GrTracing.h"
 #include "src/gpu/ganesh/GrXferProcessor.h"
 #include <atomic>
@@ -84,7 +85,7 @@ public:
     template<typename Op, typename... Args>
     static Owner MakeWithExtraMemory(
             GrRecordingContext* context, size_t extraSize, Args&&... args) {
-        void* bytes = ::operator new(sizeof(Op) + extraSize);
+        void* bytes = GrOp::operator new(sizeof(Op) + extraSize);
         return Owner{new (bytes) Op(std::forward<Args>(args)...)};
     }
 
@@ -140,7 +141,17 @@ public:
         return SkToBool(fBoundsFlags & kZeroArea_BoundsFlag);
     }
 
-    void operator delete(void* p) { ::operator delete(p); }
+    // Ops are short-lived and allocated every frame, so they are recycled by GrSizeClassAllocator
+    // rather than going through the system allocator each time.
+    void* operator new(size_t size) { return GrSizeClassAllocator::Allocate(size); }
+    void operator delete(void* p) { GrSizeClassAllocator::Release(p); }
+
+    void* operator new(size_t size, void* placement) {
+        return ::operator new(size, placement);
+    }
+    void operator delete(void* target, void* placement) {
+        ::operator delete(target, placement);
+    }
 
     /**
      * Helper for safely down-casting to a GrOp subclass
@@ -365,6 +365,9 @@ Tessellator::Tessellator(const VertexSpec& spec, char* vertices)
         , fVertexWriter{vertices}
         , fWriteProc(Tessellator::GetWriteQuadProc(spec)) {}
 
+static const float kFullCoverage[4] = {1.f, 1.f, 1.f, 1.f};
+static const float kZeroCoverage[4] = {0.f, 0.f, 0.f, 0.f};
+
 void Tessellator::append(GrQuad* deviceQuad, GrQuad* localQuad,
                          const SkPMColor4f& color, const SkRect& uvSubset, GrQuadAAFlags aaFlags) {
     // We allow Tessellator to be created with a null vertices pointer for convenience, but it is
@@ -374,8 +377,147 @@ void Tessellator::append(GrQuad* deviceQuad, GrQuad* localQuad,
     SkASSERT(localQuad || !fVertexSpec.hasLocalCoords());
     SkASSERT(!fVertexSpec.hasLocalCoords() || localQuad->quadType() <= fVertexSpec.localQuadType());
 
-    static const float kFullCoverage[4] = {1.f, 1.f, 1.f, 1.f};
-    static const float kZeroCoverage[4] = {0.f, 0.f, 0.f, 0.f};
+    // Fully anti-aliased rectangles (tiles, sprites, solid rects) are the most common input to
+    // coverage AA ops. Their insets and outsets don't need the general edge equations, so they are
+    // buffered and tessellated several at a time. Local coords must be an affine function of the
+    // device coords for the batched path to map the corner offsets back into local space.
+    if (fVertexSpec.usesCoverageAA() &&
+        aaFlags == GrQuadAAFlags::kAll &&
+        deviceQuad->quadType() == GrQuad::Type::kAxisAligned &&
+        (!fVertexSpec.hasLocalCoords() ||
+         localQuad->quadType() <= GrQuad::Type::kRectilinear)) {
+        PendingQuad& pending = fPending[fPendingCount++];
+        pending.fDevice = *deviceQuad;
+        if (fVertexSpec.hasLocalCoords()) {
+            pending.fLocal = *localQuad;
+        }
+        pending.fColor = color;
+        pending.fUVSubset = uvSubset;
+        if (fPendingCount == kBatchSize) {
+            this->flushAxisAlignedBatch();
+        }
+        return;
+    }
+
+    // Preserve the order of the vertices relative to any quads that are still buffered
+    this->flush();
+    this->appendQuad(deviceQuad, localQuad, color, uvSubset, aaFlags);
+}
+
+void Tessellator::flush() {
+    if (fPendingCount > 0) {
+        this->flushAxisAlignedBatch();
+    }
+}
+
+void Tessellator::flushAxisAlignedBatch() {
+    using float4 = skvx::float4;
+
+    SkASSERT(fPendingCount > 0 && fPendingCount <= kBatchSize);
+    const bool hasLocals = fVertexSpec.hasLocalCoords();
+
+    // Transpose the batch so that each SIMD lane holds one quad and x[i] holds the i-th corner of
+    // every quad. Unused lanes replicate the first quad so they never produce NaNs.
+    static_assert(kBatchSize == 4);
+    const PendingQuad& q0 = fPending[0];
+    const PendingQuad& q1 = fPending[fPendingCount > 1 ? 1 : 0];
+    const PendingQuad& q2 = fPending[fPendingCount > 2 ? 2 : 0];
+    const PendingQuad& q3 = fPending[fPendingCount > 3 ? 3 : 0];
+
+    float4 x[4], y[4], u[4], v[4];
+    for (int i = 0; i < 4; ++i) {
+        x[i] = {q0.fDevice.x(i), q1.fDevice.x(i), q2.fDevice.x(i), q3.fDevice.x(i)};
+        y[i] = {q0.fDevice.y(i), q1.fDevice.y(i), q2.fDevice.y(i), q3.fDevice.y(i)};
+        if (hasLocals) {
+            u[i] = {q0.fLocal.x(i), q1.fLocal.x(i), q2.fLocal.x(i), q3.fLocal.x(i)};
+            v[i] = {q0.fLocal.y(i), q1.fLocal.y(i), q2.fLocal.y(i), q3.fLocal.y(i)};
+        }
+    }
+
+    float4 minX = min(min(x[0], x[1]), min(x[2], x[3]));
+    float4 maxX = max(max(x[0], x[1]), max(x[2], x[3]));
+    float4 minY = min(min(y[0], y[1]), min(y[2], y[3]));
+    float4 maxY = max(max(y[0], y[1]), max(y[2], y[3]));
+    float4 cx = 0.5f * (minX + maxX);
+    float4 cy = 0.5f * (minY + maxY);
+
+    // Insetting by a half pixel collapses quads that are 1px or narrower, which requires the
+    // coverage estimation done by the TessellationHelper, so those lanes take the general path.
+    skvx::int4 batched = (maxX - minX > 1.f) & (maxY - minY > 1.f);
+
+    // Every edge of an axis-aligned rectangle is moved by 0.5px, so each corner moves half a pixel
+    // towards (inset) or away from (outset) the center along both axes, regardless of any 90
+    // degree rotation or mirroring in the corner order.
+    float4 dx[4], dy[4];
+    for (int i = 0; i < 4; ++i) {
+        dx[i] = if_then_else(x[i] < cx, float4(0.5f), float4(-0.5f));
+        dy[i] = if_then_else(y[i] < cy, float4(0.5f), float4(-0.5f));
+    }
+
+    // Rectilinear local coords are an affine function of the device coords, so the corner offset
+    // (dx, dy) = a*(p1 - p0) + b*(p2 - p0) maps to a*(l1 - l0) + b*(l2 - l0) in local space.
+    float4 du[4], dv[4];
+    if (hasLocals) {
+        float4 e1x = x[1] - x[0], e1y = y[1] - y[0];
+        float4 e2x = x[2] - x[0], e2y = y[2] - y[0];
+        float4 invDet = 1.f / (e1x * e2y - e1y * e2x);
+        float4 l1u = u[1] - u[0], l1v = v[1] - v[0];
+        float4 l2u = u[2] - u[0], l2v = v[2] - v[0];
+        for (int i = 0; i < 4; ++i) {
+            float4 a = (dx[i] * e2y - dy[i] * e2x) * invDet;
+            float4 b = (e1x * dy[i] - e1y * dx[i]) * invDet;
+            du[i] = a * l1u + b * l2u;
+            dv[i] = a * l1v + b * l2v;
+        }
+    }
+
+    for (int q = 0; q < fPendingCount; ++q) {
+        PendingQuad& pending = fPending[q];
+        GrQuad* localQuad = hasLocals ? &pending.fLocal : nullptr;
+        if (!batched[q]) {
+            this->appendQuad(&pending.fDevice, localQuad, pending.fColor, pending.fUVSubset,
+                             GrQuadAAFlags::kAll);
+            continue;
+        }
+
+        SkRect geomSubset;
+        if (fVertexSpec.requiresGeometrySubset()) {
+            geomSubset = pending.fDevice.bounds().makeOutset(0.5f, 0.5f);
+        }
+
+        // Inner vertices first, with full coverage
+        float* devX = pending.fDevice.xs();
+        float* devY = pending.fDevice.ys();
+        for (int i = 0; i < 4; ++i) {
+            devX[i] = x[i][q] + dx[i][q];
+            devY[i] = y[i][q] + dy[i][q];
+            if (hasLocals) {
+                localQuad->xs()[i] = u[i][q] + du[i][q];
+                localQuad->ys()[i] = v[i][q] + dv[i][q];
+            }
+        }
+        fWriteProc(&fVertexWriter, fVertexSpec, &pending.fDevice, localQuad, kFullCoverage,
+                   pending.fColor, geomSubset, pending.fUVSubset);
+
+        // Then the outer vertices with zero coverage
+        for (int i = 0; i < 4; ++i) {
+            devX[i] = x[i][q] - dx[i][q];
+            devY[i] = y[i][q] - dy[i][q];
+            if (hasLocals) {
+                localQuad->xs()[i] = u[i][q] - du[i][q];
+                localQuad->ys()[i] = v[i][q] - dv[i][q];
+            }
+        }
+        fWriteProc(&fVertexWriter, fVertexSpec, &pending.fDevice, localQuad, kZeroCoverage,
+                   pending.fColor, geomSubset, pending.fUVSubset);
+    }
+
+    fPendingCount = 0;
+}
+
+void Tessellator::appendQuad(GrQuad* deviceQuad, GrQuad* localQuad,
+                             const SkPMColor4f& color, const SkRect& uvSubset,
+                             GrQuadAAFlags aaFlags) {
     static const SkRect kIgnoredSubset = SkRect::MakeEmpty();
 
     if (fVertexSpec.usesCoverageAA()) {
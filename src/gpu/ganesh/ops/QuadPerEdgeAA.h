@@ -146,18 +146,43 @@ private:
     class Tessellator {
     public:
         explicit Tessellator(const VertexSpec& spec, char* vertices);
+        ~Tessellator() { SkASSERT(fPendingCount == 0); }
 
         // Calculates (as needed) inset and outset geometry for anti-aliasing, and appends all
         // necessary position and vertex attributes required by this Tessellator's VertexSpec into
         // the 'vertices' the Tessellator was called with. The insetting and outsetting may
         // damage the provided GrQuads (as this is intended to work with GrQuadBuffer::Iter).
         // 'localQuad' can be null if the VertexSpec does not use local coords.
+        //
+        // Anti-aliased, axis-aligned quads are buffered and tessellated kBatchSize at a time, so
+        // their vertices may not be written until a later append() or flush(). Vertex order always
+        // matches the order of append() calls.
         void append(GrQuad* deviceQuad, GrQuad* localQuad,
                     const SkPMColor4f& color, const SkRect& uvSubset, GrQuadAAFlags aaFlags);
 
+        // Writes the vertices of any buffered quads. This must be called after the last append().
+        void flush();
+
         SkDEBUGCODE(skgpu::BufferWriter::Mark vertexMark() const { return fVertexWriter.mark(); })
 
     private:
+        static constexpr int kBatchSize = 4;
+
+        struct PendingQuad {
+            GrQuad      fDevice;
+            GrQuad      fLocal;
+            SkPMColor4f fColor;
+            SkRect      fUVSubset;
+        };
+
+        // The general path that handles any quad with the TessellationHelper.
+        void appendQuad(GrQuad* deviceQuad, GrQuad* localQuad,
+                        const SkPMColor4f& color, const SkRect& uvSubset, GrQuadAAFlags aaFlags);
+
+        // Insets and outsets the buffered axis-aligned quads in parallel, one quad per SIMD lane,
+        // falling back to appendQuad() for quads that are too small to inset by a half pixel.
+        void flushAxisAlignedBatch();
+
         // VertexSpec defines many unique ways to write vertex attributes, which can be handled
         // generically by branching per-quad based on the VertexSpec. However, there are several
         // specs that appear in the wild far more frequently, so they use explicit WriteQuadProcs
@@ -172,6 +197,9 @@ private:
         VertexSpec                      fVertexSpec;
         VertexWriter                    fVertexWriter;
         WriteQuadProc                   fWriteProc;
+
+        PendingQuad                     fPending[kBatchSize];
+        int                             fPendingCount = 0;
     };
 
     GrGeometryProcessor* MakeProcessor(SkArenaAlloc*, const VertexSpec&);
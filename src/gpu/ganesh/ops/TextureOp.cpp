@@ -716,6 +716,9 @@ private:
                     tessellator.append(iter.deviceQuad(), iter.localQuad(), info.fColor,
                                        info.fSubsetRect, info.aaFlags());
                 }
+                // Write any batched quads so the vertex mark below covers all of this proxy's
+                // quads.
+                tessellator.flush();
 
                 SkASSERT((totVerticesSeen + meshVertexCnt) * vertexSize
                          == (size_t)(tessellator.vertexMark() - startMark));
@@ -9,6 +9,7 @@
 
 #include "include/core/SkSize.h"
 #include "include/core/SkSpan.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTLogic.h"
 #include "src/base/SkAutoMalloc.h"
@@ -50,9 +51,29 @@ void GrAtlasManager::freeAll() {
     }
 }
 
-bool GrAtlasManager::hasGlyph(MaskFormat format, Glyph* glyph) {
+bool GrAtlasManager::hasGlyph(MaskFormat format, Glyph* glyph, GrDeferredUploadTarget* target) {
     SkASSERT(glyph);
-    return this->getAtlas(format)->hasID(glyph->fAtlasLocator.plotLocator());
+    return this->getAtlas(format)->lookup(target, &glyph->fAtlasLocator);
+}
+
+void GrAtlasManager::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
+    static constexpr const char* kFormatNames[] = {"a8", "a565", "argb"};
+    static_assert(std::size(kFormatNames) == skgpu::kMaskFormatCount);
+    for (int i = 0; i < skgpu::kMaskFormatCount; ++i) {
+        if (!fAtlases[i]) {
+            continue;
+        }
+        const GrDrawOpAtlas::Stats& stats = fAtlases[i]->stats();
+        SkString dumpName = SkStringPrintf("skia/gr_text_atlas/%s", kFormatNames[i]);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "hits", "objects", stats.fHits);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "relocated_hits", "objects",
+                                          stats.fRelocatedHits);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "misses", "objects", stats.fMisses);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "relocated_plots", "objects",
+                                          stats.fRelocatedPlots);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "upload_size", "bytes",
+                                          stats.fUploadBytes);
+    }
 }
 
 template <typename INT_TYPE>
@@ -270,7 +291,8 @@ bool GrAtlasManager::initAtlas(MaskFormat format) {
                                               this,
                                               fAllowMultitexturing,
                                               nullptr,
-                                              /*label=*/"TextAtlas");
+                                              /*label=*/"TextAtlas",
+                                              GrDrawOpAtlas::CompactionMode::kRelocate);
         if (!fAtlases[index]) {
             return false;
         }
@@ -307,7 +329,7 @@ std::tuple<bool, int> GlyphVector::regenerateAtlasForGanesh(
             Glyph* gpuGlyph = variant.glyph;
             SkASSERT(gpuGlyph != nullptr);
 
-            if (!atlasManager->hasGlyph(maskFormat, gpuGlyph)) {
+            if (!atlasManager->hasGlyph(maskFormat, gpuGlyph, uploadTarget)) {
                 const SkGlyph& skGlyph = *metricsAndImages.glyph(gpuGlyph->fPackedID);
                 auto code = atlasManager->addGlyphToAtlas(
                         skGlyph, gpuGlyph, srcPadding, target->resourceProvider(), uploadTarget);
@@ -25,6 +25,7 @@
 #include <memory>
 
 class GrDeferredUploadTarget;
+class SkTraceMemoryDump;
 class GrResourceProvider;
 class GrSurfaceProxyView;
 class SkGlyph;
@@ -64,7 +65,9 @@ public:
 
     void freeAll();
 
-    bool hasGlyph(skgpu::MaskFormat, sktext::gpu::Glyph*);
+    // Returns true if the glyph's image is still in the atlas. If the atlas relocated the glyph's
+    // plot during compaction, the glyph's locator is updated to point at its new location.
+    bool hasGlyph(skgpu::MaskFormat, sktext::gpu::Glyph*, GrDeferredUploadTarget*);
 
     GrDrawOpAtlas::ErrorCode addGlyphToAtlas(const SkGlyph&,
                                              sktext::gpu::Glyph*,
@@ -98,6 +101,16 @@ public:
         return this->getAtlas(format)->atlasGeneration();
     }
 
+    // Reports the counters of each atlas below "skia/gr_text_atlas/<format>".
+    void dumpMemoryStatistics(SkTraceMemoryDump*) const;
+
+    // Hit, miss and upload counters of the atlas for the given format, or nullptr if that atlas
+    // hasn't been created.
+    const GrDrawOpAtlas::Stats* atlasStats(skgpu::MaskFormat format) const {
+        int atlasIndex = MaskFormatToAtlasIndex(this->resolveMaskFormat(format));
+        return fAtlases[atlasIndex] ? &fAtlases[atlasIndex]->stats() : nullptr;
+    }
+
     // GrOnFlushCallbackObject overrides
 
     bool preFlush(GrOnFlushResourceProvider* onFlushRP) override {
@@ -13,6 +13,7 @@
 #include "src/base/SkSpinlock.h"
 #include "src/core/SkLRUCache.h"
 #include "src/gpu/ResourceKey.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
 
 #include <functional>
 
@@ -69,6 +70,10 @@ public:
     // or reference tracking.
     void addStaticResource(sk_sp<Resource>) SK_EXCLUDES(fSpinLock);
 
+    // Records the GraphicsPipelines created by every Recorder while usage recording is enabled.
+    // PipelineUsageLog has its own synchronization and does not take fSpinLock.
+    PipelineUsageLog* pipelineUsageLog() { return &fPipelineUsageLog; }
+
 private:
     struct KeyHash {
         uint32_t operator()(const UniqueKey& key) const { return key.hash(); }
@@ -87,6 +92,8 @@ private:
     ComputePipelineCache  fComputePipelineCache  SK_GUARDED_BY(fSpinLock);
 
     skia_private::TArray<sk_sp<Resource>> fStaticResource SK_GUARDED_BY(fSpinLock);
+
+    PipelineUsageLog fPipelineUsageLog;
 };
 
 }  // namespace skgpu::graphite
@@ -62,6 +62,9 @@ public:
     // Converts the key to a structured list of snippet names for debugging or labeling purposes.
     SkString toString(const ShaderCodeDictionary* dict) const;
 
+    // The raw key data, e.g. for serializing the key outside of the lifetime of its dictionary.
+    SkSpan<const int32_t> data() const { return fData; }
+
 #ifdef SK_DEBUG
     void dump(const ShaderCodeDictionary*, UniquePaintParamsID) const;
 #endif
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/PipelineUsageLog.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "src/base/SkBuffer.h"
+#include "src/core/SkChecksum.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/GraphicsPipelineDesc.h"
+#include "src/gpu/graphite/PaintParamsKey.h"
+#include "src/gpu/graphite/RenderPassDesc.h"
+#include "src/gpu/graphite/Renderer.h"
+#include "src/gpu/graphite/RendererProvider.h"
+#include "src/gpu/graphite/ShaderCodeDictionary.h"
+
+namespace skgpu::graphite {
+
+namespace {
+
+// Bump kVersion whenever the serialized layout, the set of RenderSteps, or the meaning of
+// built-in code snippet IDs changes in an incompatible way. Logs with a different version are
+// rejected rather than producing mismatched pipelines.
+static constexpr uint32_t kMagic = SkSetFourByteTag('g', 'p', 'u', 'l');
+static constexpr uint32_t kVersion = 1;
+
+// Upper bounds used to reject corrupt data before allocating
+static constexpr uint32_t kMaxNameLength = 1024;
+static constexpr uint32_t kMaxKeyLength = 1 << 16;
+
+uint8_t to_bits(SkEnumBitMask<DepthStencilFlags> flags) {
+    return SkTo<uint8_t>(flags.value());
+}
+
+SkEnumBitMask<DepthStencilFlags> from_bits(uint8_t bits) {
+    SkEnumBitMask<DepthStencilFlags> flags = DepthStencilFlags::kNone;
+    if (bits & static_cast<int>(DepthStencilFlags::kDepth)) {
+        flags |= DepthStencilFlags::kDepth;
+    }
+    if (bits & static_cast<int>(DepthStencilFlags::kStencil)) {
+        flags |= DepthStencilFlags::kStencil;
+    }
+    return flags;
+}
+
+// Find the color type whose default renderable TextureInfo matches 'target'. Returns
+// kUnknown_SkColorType if no color type matches (e.g. wrapped client textures with custom usage).
+SkColorType find_color_type(const Caps* caps, const TextureInfo& target) {
+    for (int i = 1; i < kSkColorTypeCnt; ++i) {
+        SkColorType ct = static_cast<SkColorType>(i);
+        TextureInfo info = caps->getDefaultSampledTextureInfo(ct,
+                                                              Mipmapped::kNo,
+                                                              target.isProtected(),
+                                                              Renderable::kYes);
+        if (info.isValid() && info == target) {
+            return ct;
+        }
+    }
+    return kUnknown_SkColorType;
+}
+
+bool find_depth_stencil_flags(const Caps* caps,
+                              const RenderPassDesc& desc,
+                              SkEnumBitMask<DepthStencilFlags>* flags) {
+    const TextureInfo& dsInfo = desc.fDepthStencilAttachment.fTextureInfo;
+    if (!dsInfo.isValid()) {
+        *flags = DepthStencilFlags::kNone;
+        return true;
+    }
+    for (DepthStencilFlags f : { DepthStencilFlags::kDepth,
+                                 DepthStencilFlags::kStencil,
+                                 DepthStencilFlags::kDepthStencil }) {
+        if (caps->getDefaultDepthStencilTextureInfo(f,
+                                                    dsInfo.numSamples(),
+                                                    dsInfo.isProtected()) == dsInfo) {
+            *flags = f;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+bool PipelineUsageLog::Entry::operator==(const Entry& that) const {
+    return fRenderStepName == that.fRenderStepName &&
+           fPaintKey == that.fPaintKey &&
+           fColorType == that.fColorType &&
+           fDepthStencilFlags == that.fDepthStencilFlags &&
+           fRequiresMSAA == that.fRequiresMSAA &&
+           fProtected == that.fProtected;
+}
+
+uint32_t PipelineUsageLog::Entry::hash() const {
+    uint32_t hash = SkChecksum::Hash32(fRenderStepName.c_str(), fRenderStepName.size());
+    hash = SkChecksum::Hash32(fPaintKey.data(), fPaintKey.size_bytes(), hash);
+    const uint32_t state[] = { SkTo<uint32_t>(fColorType),
+                               SkTo<uint32_t>(fDepthStencilFlags.value()),
+                               fRequiresMSAA,
+                               fProtected };
+    return SkChecksum::Hash32(state, sizeof(state), hash);
+}
+
+void PipelineUsageLog::startRecording() {
+    SkAutoSpinlock lock{fSpinLock};
+
+    fEntries.reset();
+    fRecording.store(true, std::memory_order_relaxed);
+}
+
+sk_sp<SkData> PipelineUsageLog::finishRecording() {
+    skia_private::TArray<Entry> entries;
+    {
+        SkAutoSpinlock lock{fSpinLock};
+
+        fRecording.store(false, std::memory_order_relaxed);
+        entries.reserve(fEntries.count());
+        fEntries.foreach([&entries](const Entry& e) { entries.push_back(e); });
+        fEntries.reset();
+    }
+    return Serialize(entries);
+}
+
+int PipelineUsageLog::count() const {
+    SkAutoSpinlock lock{fSpinLock};
+
+    return fEntries.count();
+}
+
+void PipelineUsageLog::record(const Caps* caps,
+                              const ShaderCodeDictionary* dict,
+                              const RendererProvider* rendererProvider,
+                              const GraphicsPipelineDesc& pipelineDesc,
+                              const RenderPassDesc& renderPassDesc) {
+    if (!this->isRecording()) {
+        return;
+    }
+
+    const RenderStep* step = rendererProvider->lookup(pipelineDesc.renderStepID());
+    if (!step) {
+        return;
+    }
+
+    // When MSAA is resolved into a single-sampled target, the resolve attachment is the texture
+    // that was passed to RenderPassDesc::Make(). Otherwise it's the color attachment itself.
+    const TextureInfo& target = renderPassDesc.fColorResolveAttachment.fTextureInfo.isValid()
+                                        ? renderPassDesc.fColorResolveAttachment.fTextureInfo
+                                        : renderPassDesc.fColorAttachment.fTextureInfo;
+
+    Entry entry;
+    entry.fColorType = find_color_type(caps, target);
+    if (entry.fColorType == kUnknown_SkColorType ||
+        !find_depth_stencil_flags(caps, renderPassDesc, &entry.fDepthStencilFlags)) {
+        return;
+    }
+    entry.fRenderStepName = SkString(step->name());
+    entry.fRequiresMSAA = renderPassDesc.fSampleCount > 1;
+    entry.fProtected = target.isProtected() == Protected::kYes;
+
+    if (pipelineDesc.paintParamsID().isValid()) {
+        PaintParamsKey key = dict->lookup(pipelineDesc.paintParamsID());
+        SkSpan<const int32_t> data = key.data();
+        entry.fPaintKey.push_back_n(SkToInt(data.size()), data.data());
+    }
+
+    SkAutoSpinlock lock{fSpinLock};
+    fEntries.add(std::move(entry));
+}
+
+sk_sp<SkData> PipelineUsageLog::Serialize(SkSpan<const Entry> entries) {
+    SkDynamicMemoryWStream stream;
+    stream.write32(kMagic);
+    stream.write32(kVersion);
+    stream.write32(SkToU32(entries.size()));
+
+    for (const Entry& e : entries) {
+        stream.write32(SkToU32(e.fRenderStepName.size()));
+        stream.write(e.fRenderStepName.c_str(), e.fRenderStepName.size());
+        stream.write32(SkToU32(e.fPaintKey.size()));
+        stream.write(e.fPaintKey.data(), e.fPaintKey.size_bytes());
+        stream.write8(SkTo<uint8_t>(e.fColorType));
+        stream.write8(to_bits(e.fDepthStencilFlags));
+        stream.write8(e.fRequiresMSAA);
+        stream.write8(e.fProtected);
+    }
+
+    return stream.detachAsData();
+}
+
+bool PipelineUsageLog::Deserialize(const SkData* data,
+                                   const std::function<void(const Entry&)>& fn) {
+    if (!data) {
+        return false;
+    }
+
+    SkRBuffer buffer(data->data(), data->size());
+
+    uint32_t magic, version, count;
+    if (!buffer.readU32(&magic) || magic != kMagic ||
+        !buffer.readU32(&version) || version != kVersion ||
+        !buffer.readU32(&count)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        Entry entry;
+
+        uint32_t nameLength;
+        if (!buffer.readU32(&nameLength) || nameLength > kMaxNameLength) {
+            return false;
+        }
+        const char* name = buffer.skipCount<char>(nameLength);
+        if (!name) {
+            return false;
+        }
+        entry.fRenderStepName.set(name, nameLength);
+
+        uint32_t keyLength;
+        if (!buffer.readU32(&keyLength) || keyLength > kMaxKeyLength) {
+            return false;
+        }
+        entry.fPaintKey.resize(SkToInt(keyLength));
+        if (!buffer.read(entry.fPaintKey.data(), entry.fPaintKey.size_bytes())) {
+            return false;
+        }
+
+        uint8_t colorType, dsFlags, requiresMSAA, isProtected;
+        if (!buffer.readU8(&colorType) || !buffer.readU8(&dsFlags) ||
+            !buffer.readU8(&requiresMSAA) || !buffer.readU8(&isProtected) ||
+            colorType == kUnknown_SkColorType || colorType >= kSkColorTypeCnt) {
+            return false;
+        }
+        entry.fColorType = static_cast<SkColorType>(colorType);
+        entry.fDepthStencilFlags = from_bits(dsFlags);
+        entry.fRequiresMSAA = requiresMSAA;
+        entry.fProtected = isProtected;
+
+        fn(entry);
+    }
+
+    return buffer.eof();
+}
+
+} // namespace skgpu::graphite
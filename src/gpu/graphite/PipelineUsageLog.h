@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_PipelineUsageLog_DEFINED
+#define skgpu_graphite_PipelineUsageLog_DEFINED
+
+#include "include/core/SkColorType.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkSpinlock.h"
+#include "src/base/SkEnumBitMask.h"
+#include "src/core/SkTHash.h"
+#include "src/gpu/graphite/ResourceTypes.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+class SkData;
+
+namespace skgpu::graphite {
+
+class Caps;
+class GraphicsPipelineDesc;
+struct RenderPassDesc;
+class RendererProvider;
+class ShaderCodeDictionary;
+
+/**
+ * PipelineUsageLog records a backend-agnostic description of every GraphicsPipeline that is
+ * created while recording is enabled. The log can be serialized and, in a later session, replayed
+ * to create the same pipelines ahead of time (see PrecompileFromUsageLog in PublicPrecompile.h).
+ *
+ * Since UniquePaintParamsIDs and RenderStep IDs are only meaningful for the lifetime of a Context,
+ * each entry stores the RenderStep's name, the full PaintParamsKey data, and the arguments that
+ * were used to build the RenderPassDesc (rather than the backend-specific TextureInfos).
+ *
+ * PipelineUsageLog is owned by the GlobalCache and is thread safe. When recording is disabled,
+ * the only cost on the pipeline creation path is a relaxed atomic load.
+ */
+class PipelineUsageLog {
+public:
+    struct Entry {
+        SkString fRenderStepName;
+        // The raw PaintParamsKey data; empty for RenderSteps that don't perform shading.
+        skia_private::TArray<int32_t> fPaintKey;
+        SkColorType fColorType = kUnknown_SkColorType;
+        SkEnumBitMask<DepthStencilFlags> fDepthStencilFlags = DepthStencilFlags::kNone;
+        bool fRequiresMSAA = false;
+        bool fProtected = false;
+
+        bool operator==(const Entry&) const;
+        uint32_t hash() const;
+    };
+
+    PipelineUsageLog() = default;
+
+    void startRecording() SK_EXCLUDES(fSpinLock);
+    // Stops recording and returns the serialized log of all unique pipelines that were created
+    // since the last call to startRecording().
+    sk_sp<SkData> finishRecording() SK_EXCLUDES(fSpinLock);
+
+    bool isRecording() const { return fRecording.load(std::memory_order_relaxed); }
+
+    // Records the pipeline described by 'pipelineDesc' and 'renderPassDesc'. This is a no-op if
+    // recording is disabled or if the RenderPassDesc cannot be expressed in terms of a default
+    // TextureInfo for a color type (e.g. targets wrapping client-created textures).
+    void record(const Caps*,
+                const ShaderCodeDictionary*,
+                const RendererProvider*,
+                const GraphicsPipelineDesc& pipelineDesc,
+                const RenderPassDesc& renderPassDesc) SK_EXCLUDES(fSpinLock);
+
+    int count() const SK_EXCLUDES(fSpinLock);
+
+    static sk_sp<SkData> Serialize(SkSpan<const Entry>);
+    // Calls 'fn' for every entry in the serialized log. Returns false if the data is malformed or
+    // was written by an incompatible version of Skia, in which case 'fn' may have been called for
+    // a prefix of the entries.
+    static bool Deserialize(const SkData*, const std::function<void(const Entry&)>& fn);
+
+private:
+    struct EntryHash {
+        uint32_t operator()(const Entry& e) const { return e.hash(); }
+    };
+
+    std::atomic<bool> fRecording = false;
+
+    mutable SkSpinlock fSpinLock;
+    skia_private::THashSet<Entry, EntryHash> fEntries SK_GUARDED_BY(fSpinLock);
+};
+
+} // namespace skgpu::graphite
+
+#endif // skgpu_graphite_PipelineUsageLog_DEFINED
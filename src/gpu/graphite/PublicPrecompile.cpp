@@ -9,19 +9,28 @@
 
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "src/core/SkKnownRuntimeEffects.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/ContextPriv.h"
 #include "src/gpu/graphite/ContextUtils.h"
+#include "src/gpu/graphite/GlobalCache.h"
 #include "src/gpu/graphite/GraphicsPipeline.h"
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/KeyContext.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/PaintOptionsPriv.h"
+#include "src/gpu/graphite/PaintParamsKey.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
+#include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/RenderPassDesc.h"
 #include "src/gpu/graphite/Renderer.h"
 #include "src/gpu/graphite/RendererProvider.h"
 #include "src/gpu/graphite/ResourceProvider.h"
 #include "src/gpu/graphite/RuntimeEffectDictionary.h"
+#include "src/gpu/graphite/ShaderCodeDictionary.h"
 #include "src/gpu/graphite/UniquePaintParamsID.h"
 
 namespace {
@@ -74,10 +83,129 @@ void compile(const RendererProvider* rendererProvider,
     }
 }
 
+// Re-adds the serialized PaintParamsKey node starting at data[*index] (and all of its children)
+// to 'builder'. Returns false if the node references a code snippet that isn't available in this
+// Context, in which case 'builder' must be discarded.
+bool append_serialized_node(ShaderCodeDictionary* dict,
+                            RuntimeEffectDictionary* rtEffectDict,
+                            SkSpan<const int32_t> data,
+                            int* index,
+                            PaintParamsKeyBuilder* builder) {
+    using namespace SkKnownRuntimeEffects;
+
+    if (*index >= SkToInt(data.size())) {
+        return false;
+    }
+    int32_t snippetID = data[(*index)++];
+
+    if (snippetID > kSkiaKnownRuntimeEffectsStart &&
+        snippetID < kSkiaKnownRuntimeEffectsStart + kStableKeyCnt) {
+        // Known runtime effects have stable IDs but are only registered with the dictionary once
+        // they've been used.
+        const SkRuntimeEffect* effect = GetKnownRuntimeEffect(static_cast<StableKey>(snippetID));
+        if (!effect) {
+            return false;
+        }
+        dict->findOrCreateRuntimeEffectSnippet(effect);
+        rtEffectDict->set(snippetID, sk_ref_sp(effect));
+    } else if (snippetID >= kBuiltInCodeSnippetIDCount) {
+        // Client-defined runtime effects are assigned IDs on a first-come, first-served basis so
+        // they can't be matched across processes.
+        return false;
+    }
+
+    const ShaderSnippet* entry = dict->getEntry(snippetID);
+    if (!entry) {
+        return false;
+    }
+
+    builder->beginBlock(snippetID);
+    for (int i = 0; i < entry->fNumChildren; ++i) {
+        if (!append_serialized_node(dict, rtEffectDict, data, index, builder)) {
+            return false;
+        }
+    }
+    builder->endBlock();
+    return true;
+}
+
 } // anonymous namespace
 
 namespace skgpu::graphite {
 
+void StartPipelineUsageRecording(Context* context) {
+    context->priv().globalCache()->pipelineUsageLog()->startRecording();
+}
+
+sk_sp<SkData> FinishPipelineUsageRecording(Context* context) {
+    return context->priv().globalCache()->pipelineUsageLog()->finishRecording();
+}
+
+int PrecompileFromUsageLog(Recorder* recorder, const SkData* usageLog) {
+    ShaderCodeDictionary* dict = recorder->priv().shaderCodeDictionary();
+    const RendererProvider* rendererProvider = recorder->priv().rendererProvider();
+    ResourceProvider* resourceProvider = recorder->priv().resourceProvider();
+    const Caps* caps = recorder->priv().caps();
+
+    RuntimeEffectDictionary rtEffectDict;
+
+    int numPipelines = 0;
+    bool valid = PipelineUsageLog::Deserialize(usageLog, [&](const PipelineUsageLog::Entry& e) {
+        const RenderStep* step = rendererProvider->lookupByName(e.fRenderStepName.c_str());
+        if (!step) {
+            return;
+        }
+
+        UniquePaintParamsID paintID = UniquePaintParamsID::InvalidID();
+        if (!e.fPaintKey.empty()) {
+            SkSpan<const int32_t> data(e.fPaintKey.data(), e.fPaintKey.size());
+            PaintParamsKeyBuilder builder(dict);
+            int index = 0;
+            while (index < SkToInt(data.size())) {
+                if (!append_serialized_node(dict, &rtEffectDict, data, &index, &builder)) {
+                    return;
+                }
+            }
+            paintID = dict->findOrCreate(&builder);
+        }
+        if (step->performsShading() != paintID.isValid()) {
+            return;
+        }
+
+        Protected isProtected = e.fProtected ? Protected::kYes : Protected::kNo;
+        TextureInfo info = caps->getDefaultSampledTextureInfo(e.fColorType,
+                                                              Mipmapped::kNo,
+                                                              isProtected,
+                                                              Renderable::kYes);
+        if (!info.isValid()) {
+            return;
+        }
+
+        // As in PrecompileCombinations(), the load op and clear color don't affect the pipeline.
+        Swizzle writeSwizzle = caps->getWriteSwizzle(e.fColorType, info);
+        RenderPassDesc renderPassDesc = RenderPassDesc::Make(caps,
+                                                             info,
+                                                             LoadOp::kClear,
+                                                             StoreOp::kStore,
+                                                             e.fDepthStencilFlags,
+                                                             /* clearColor= */ { 0, 0, 0, 0 },
+                                                             e.fRequiresMSAA,
+                                                             writeSwizzle);
+
+        sk_sp<GraphicsPipeline> pipeline = resourceProvider->findOrCreateGraphicsPipeline(
+                &rtEffectDict,
+                GraphicsPipelineDesc(step, paintID),
+                renderPassDesc);
+        if (!pipeline) {
+            SKGPU_LOG_W("Failed to create GraphicsPipeline from usage log!");
+            return;
+        }
+        ++numPipelines;
+    });
+
+    return valid ? numPipelines : -1;
+}
+
 bool Precompile(Context* context,
                 RuntimeEffectDictionary* rteDict,
                 const GraphicsPipelineDesc& pipelineDesc,
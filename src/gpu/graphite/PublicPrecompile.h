@@ -8,8 +8,11 @@
 #ifndef skgpu_graphite_PublicPrecompile_DEFINED
 #define skgpu_graphite_PublicPrecompile_DEFINED
 
+#include "include/core/SkRefCnt.h"
 #include "include/gpu/graphite/GraphiteTypes.h"
 
+class SkData;
+
 // TODO: this header should be moved to include/gpu/graphite once the precompilation API
 // is made public
 namespace skgpu::graphite {
@@ -17,6 +20,7 @@ namespace skgpu::graphite {
 class Context;
 class GraphicsPipelineDesc;
 class PaintOptions;
+class Recorder;
 struct RenderPassDesc;
 class RuntimeEffectDictionary;
 
@@ -41,6 +45,37 @@ bool Precompile(Context*,
                 const GraphicsPipelineDesc& pipelineDesc,
                 const RenderPassDesc& renderPassDesc);
 
+/**
+ * Usage-driven precompilation. Rather than enumerating PaintOptions by hand, a client can record
+ * the pipelines that are actually created during a representative session and replay that log on
+ * subsequent launches.
+ *
+ * StartPipelineUsageRecording() begins logging every GraphicsPipeline created by any Recorder of
+ * the Context. FinishPipelineUsageRecording() stops logging and returns a serialized, deduplicated
+ * description of those pipelines that is suitable for storing on disk. The log only references
+ * state that is stable across processes; it must be replayed with the same version of Skia and a
+ * Context for the same backend and device.
+ */
+void StartPipelineUsageRecording(Context*);
+sk_sp<SkData> FinishPipelineUsageRecording(Context*);
+
+/**
+ * Creates every pipeline described by a log returned from FinishPipelineUsageRecording(). The
+ * pipelines are added to the Context's global pipeline cache so that later draws from any
+ * Recorder find them.
+ *
+ * This only uses the Recorder's ResourceProvider and the Context's thread safe caches, so it can
+ * be called on a background thread with a Recorder dedicated to that thread while the main
+ * thread keeps recording. Entries that reference state which isn't available in the current
+ * Context (e.g. client-defined runtime effects or unsupported color types) are skipped.
+ *
+ *   @param recorder   a Recorder that is only used by the calling thread
+ *   @param usageLog   data returned by FinishPipelineUsageRecording()
+ *   @return           the number of pipelines that were found or created, or -1 if the log is
+ *                     malformed or was written by an incompatible version
+ */
+int PrecompileFromUsageLog(Recorder*, const SkData* usageLog);
+
 } // namespace skgpu::graphite
 
 #endif // skgpu_graphite_PublicPrecompile_DEFINED
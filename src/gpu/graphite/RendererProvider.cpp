@@ -163,4 +163,13 @@ const RenderStep* RendererProvider::lookup(uint32_t uniqueID) const {
     return nullptr;
 }
 
+const RenderStep* RendererProvider::lookupByName(std::string_view name) const {
+    for (auto&& rs : fRenderSteps) {
+        if (name == rs->name()) {
+            return rs.get();
+        }
+    }
+    return nullptr;
+}
+
 } // namespace skgpu::graphite
@@ -83,6 +83,9 @@ public:
     }
 
     const RenderStep* lookup(uint32_t uniqueID) const;
+    // RenderStep IDs are not stable across Contexts, but their names are. This is used to map
+    // serialized pipeline descriptions back onto the current Context's RenderSteps.
+    const RenderStep* lookupByName(std::string_view name) const;
 
 #ifdef SK_ENABLE_VELLO_SHADERS
     // Compute shader-based path renderer and compositor.
@@ -21,6 +21,7 @@
 #include "src/gpu/graphite/GraphicsPipeline.h"
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
 #include "src/gpu/graphite/RenderPassDesc.h"
 #include "src/gpu/graphite/RendererProvider.h"
 #include "src/gpu/graphite/ResourceCache.h"
@@ -74,6 +75,15 @@ sk_sp<GraphicsPipeline> ResourceProvider::findOrCreateGraphicsPipeline(
             // TODO: Should we store a null pipeline if we failed to create one so that subsequent
             // usage immediately sees that the pipeline cannot be created, vs. retrying every time?
             pipeline = globalCache->addGraphicsPipeline(pipelineKey, std::move(pipeline));
+
+            PipelineUsageLog* usageLog = globalCache->pipelineUsageLog();
+            if (usageLog->isRecording()) {
+                usageLog->record(fSharedContext->caps(),
+                                 fSharedContext->shaderCodeDictionary(),
+                                 fSharedContext->rendererProvider(),
+                                 pipelineDesc,
+                                 renderPassDesc);
+            }
         }
     }
     return pipeline;
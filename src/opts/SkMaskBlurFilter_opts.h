@@ -0,0 +1,191 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMaskBlurFilter_opts_DEFINED
+#define SkMaskBlurFilter_opts_DEFINED
+
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkAttributes.h"
+#include "include/private/base/SkFeatures.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkUtils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace SK_OPTS_NS {
+
+// The three pass box filter of SkMaskBlurFilter (see PlanGauss::Scan), run on one register's
+// worth of lines at once: each 32-bit lane carries the sums of one line. The math is exactly the
+// scalar math, lane-wise.
+//
+// Source lines are contiguous A8, spaced by srcLineStride. The results are stored transposed:
+// pixel x of line i goes to dst[x * dstPixelStride + i], so the lines of a group are written
+// with one store.
+//
+// Below AVX2 (no 32-bit vector multiply, narrow registers) this loses to the scalar code on x86, so
+// those targets leave every line to Scan.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2 || defined(SK_ARM_HAS_NEON))
+    #define SK_BOX_BLUR_LINES_SIMD
+
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+        static constexpr int kBoxBlurLanes = 16;
+    #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        static constexpr int kBoxBlurLanes = 8;
+    #else
+        static constexpr int kBoxBlurLanes = 4;
+    #endif
+
+    // skvx::Vec would do, but GCC spills its split halves to the stack on every operation.
+    typedef uint32_t BoxBlurU32 __attribute__((vector_size(kBoxBlurLanes * sizeof(uint32_t))));
+
+    SK_ALWAYS_INLINE static BoxBlurU32 box_blur_gather(const uint8_t* src, size_t stride) {
+        BoxBlurU32 v;
+        for (int i = 0; i < kBoxBlurLanes; ++i) {
+            v[i] = src[i * stride];
+        }
+        return v;
+    }
+
+    // Stores the low byte of each lane; every lane is known to be < 256, so the signed
+    // saturating packs are harmless.
+    SK_ALWAYS_INLINE static void box_blur_store(const BoxBlurU32& v, uint8_t* dst) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+        _mm_storeu_si128((__m128i*)dst, _mm512_cvtepi32_epi8((__m512i)v));
+    #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        __m128i p = _mm_packs_epi32(_mm256_castsi256_si128((__m256i)v),
+                                    _mm256_extracti128_si256((__m256i)v, 1));
+        _mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(p, p));
+    #else
+        for (int i = 0; i < kBoxBlurLanes; ++i) {
+            dst[i] = static_cast<uint8_t>(v[i]);
+        }
+    #endif
+    }
+
+    // Blurs one group of kBoxBlurLanes lines. The buffer holds
+    // kBoxBlurLanes * (pass0Size + pass1Size + pass2Size) values.
+    static void box_blur_group(uint32_t weightLo, uint32_t weightHi,
+                               int pass0Size, int pass1Size, int pass2Size, uint32_t* buffer,
+                               int noChangeCount,
+                               const uint8_t* src, size_t srcLineStride, int srcLen,
+                               uint8_t* dst, size_t dstPixelStride, int dstLen) {
+        constexpr int N = kBoxBlurLanes;
+        using U32 = BoxBlurU32;
+
+        uint32_t* const buffer0   = buffer;
+        uint32_t* const buffer1   = buffer0 + N * pass0Size;
+        uint32_t* const buffer2   = buffer1 + N * pass1Size;
+        uint32_t* const bufferEnd = buffer2 + N * pass2Size;
+
+        U32 sum0, sum1, sum2;
+        uint32_t *cursor0, *cursor1, *cursor2;
+        auto reset = [&] {
+            std::fill(buffer0, bufferEnd, 0);
+            sum0 = sum1 = sum2 = U32{};
+            cursor0 = buffer0;
+            cursor1 = buffer1;
+            cursor2 = buffer2;
+        };
+
+        // The scalar finalScale(), (weight * sum + 2^31) >> 32, without 64-bit lanes: the weight
+        // (< 2^32) and sum are split into 16-bit halves, and the partial products summed exactly.
+        auto finalScale = [&](const U32& sum) {
+            const U32 sl = sum & 0xffff,
+                      sh = sum >> 16;
+            const U32 a  = sl * weightLo,
+                      b1 = sl * weightHi,
+                      b2 = sh * weightLo;
+            return sh * weightHi + (b1 >> 16) + (b2 >> 16)
+                 + (((b1 & 0xffff) + (b2 & 0xffff) + (a >> 16) + 0x8000) >> 16);
+        };
+
+        auto step = [&](const U32& leadingEdge, uint8_t* d) {
+            sum0 += leadingEdge;
+            sum1 += sum0;
+            sum2 += sum1;
+
+            box_blur_store(finalScale(sum2), d);
+
+            sum2 -= sk_unaligned_load<U32>(cursor2);
+            sk_unaligned_store(cursor2, sum1);
+            cursor2 = cursor2 + N < bufferEnd ? cursor2 + N : buffer2;
+
+            sum1 -= sk_unaligned_load<U32>(cursor1);
+            sk_unaligned_store(cursor1, sum0);
+            cursor1 = cursor1 + N < buffer2 ? cursor1 + N : buffer1;
+
+            sum0 -= sk_unaligned_load<U32>(cursor0);
+            sk_unaligned_store(cursor0, leadingEdge);
+            cursor0 = cursor0 + N < buffer1 ? cursor0 + N : buffer0;
+        };
+
+        reset();
+
+        // Consume the source generating pixels.
+        const uint8_t* s = src;
+        uint8_t* d = dst;
+        for (int x = 0; x < srcLen; ++x, ++s, d += dstPixelStride) {
+            step(box_blur_gather(s, srcLineStride), d);
+        }
+
+        // The leading edge is off the right side of the mask.
+        for (int i = 0; i < noChangeCount; ++i, d += dstPixelStride) {
+            step(U32{}, d);
+        }
+
+        // Starting from the right, fill in the rest of the destination.
+        reset();
+
+        uint8_t* dstCursor = dst + dstLen * dstPixelStride;
+        s = src + srcLen;
+        while (dstCursor > d) {
+            dstCursor -= dstPixelStride;
+            step(box_blur_gather(--s, srcLineStride), dstCursor);
+        }
+    }
+#endif
+
+// Blurs the largest multiple of kBoxBlurLanes of the given lines, and returns that count. The
+// remaining lines are left to the caller. All ring buffers must be non-empty.
+static int box_blur_lines(uint64_t weight, int pass0Size, int pass1Size, int pass2Size,
+                          int noChangeCount,
+                          const uint8_t* src, size_t srcLineStride, int srcLen,
+                          uint8_t* dst, size_t dstPixelStride, int dstLen,
+                          int lineCount) {
+#if defined(SK_BOX_BLUR_LINES_SIMD)
+    constexpr int N = kBoxBlurLanes;
+    SkASSERT(pass0Size > 0 && pass1Size > 0 && pass2Size > 0);
+
+    const int groups = lineCount / N;
+    if (groups == 0) {
+        return 0;
+    }
+
+    skia_private::AutoSTMalloc<1024, uint32_t> buffer(N * (pass0Size + pass1Size + pass2Size));
+    for (int g = 0; g < groups; ++g) {
+        box_blur_group(weight & 0xffff, weight >> 16, pass0Size, pass1Size, pass2Size,
+                       buffer.get(), noChangeCount,
+                       src + g * N * srcLineStride, srcLineStride, srcLen,
+                       dst + g * N, dstPixelStride, dstLen);
+    }
+
+    return groups * N;
+#else
+    return 0;
+#endif
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkMaskBlurFilter_opts_DEFINED
@@ -5,11 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "src/core/SkMaskBlurFilter.h"
 #include "src/core/SkOpts.h"
 
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 
 #define SK_OPTS_NS skx
+#include "src/opts/SkMaskBlurFilter_opts.h"
 #include "src/opts/SkRasterPipeline_opts.h"
 
 namespace SkOpts {
@@ -29,6 +31,11 @@ namespace SkOpts {
         start_pipeline_lowp = SK_OPTS_NS::lowp::start_pipeline;
     #undef M
     }
+
+    // Called by Init_MaskBlurFilter(), in src/core/SkMaskBlurFilter_opts.cpp.
+    void Init_MaskBlurFilter_skx() {
+        box_blur_lines = SK_OPTS_NS::box_blur_lines;
+    }
 }  // namespace SkOpts
 
 #endif // SK_ENABLE_OPTIMIZE_SIZE
@@ -58,6 +58,7 @@
 #include "src/sksl/ir/SkSLVariableReference.h"
 #include "src/sksl/transform/SkSLProgramWriter.h"
 
+#include <algorithm>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -497,6 +498,10 @@ bool Analysis::DetectVarDeclarationWithoutScope(const Statement& stmt, ErrorRepo
 }
 
 int Analysis::NodeCountUpToLimit(const FunctionDefinition& function, int limit) {
+    if (function.hasCachedAnalysis()) {
+        // The visitor always counts the function body itself, even when the limit is zero.
+        return std::min(function.cachedNodeCount(), std::max(limit, 1));
+    }
     return NodeCountVisitor{limit}.visit(*function.body());
 }
 
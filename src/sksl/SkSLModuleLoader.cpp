@@ -6,13 +6,16 @@
  */
 #include "src/sksl/SkSLModuleLoader.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSemaphore.h"
 #include "src/base/SkNoDestructor.h"
 #include "src/sksl/SkSLBuiltinTypes.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLPosition.h"
 #include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
 #include "src/sksl/ir/SkSLIRNode.h"
 #include "src/sksl/ir/SkSLLayout.h"
 #include "src/sksl/ir/SkSLModifierFlags.h"
@@ -22,6 +25,10 @@
 #include "src/sksl/ir/SkSLVariable.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -49,7 +56,7 @@
         return moduleSource;
     }
 
-    #define MODULE_DATA(name) #name, load_module_file(#name ".sksl")
+    #define MODULE_SOURCE(name) load_module_file(#name ".sksl")
 
 #else
 
@@ -84,7 +91,7 @@
         #endif
     #endif
 
-    #define MODULE_DATA(name) #name, std::string(SKSL_MINIFIED_##name)
+    #define MODULE_SOURCE(name) std::string(SKSL_MINIFIED_##name)
 
 #endif
 
@@ -145,6 +152,143 @@ static constexpr BuiltinTypePtr kPrivateTypes[] = {
 
 #undef TYPE
 
+// Every module that can be loaded. Graphite modules only exist in Graphite builds.
+enum class ModuleType : int {
+    kShared,                // [Root] + Public intrinsics
+    kGPU,                   // [Shared] + Non-public intrinsics/helper functions
+    kVertex,                // [GPU] + Vertex stage decls
+    kFragment,              // [GPU] + Fragment stage decls
+    kCompute,               // [GPU] + Compute stage decls
+    kGraphiteVertex,        // [Vert] + Graphite vertex helpers
+    kGraphiteFragment,      // [Frag] + Graphite fragment helpers
+    kGraphiteVertexES2,     // [Vert] + Graphite vertex ES2 helpers
+    kGraphiteFragmentES2,   // [Frag] + Graphite fragment ES2 helpers
+    kPublic,                // [Shared] minus Private types + Runtime effect intrinsics
+    kRuntimeShader,         // [Public] + Runtime shader decls
+
+    kLast = kRuntimeShader,
+};
+static constexpr int kModuleTypeCount = static_cast<int>(ModuleType::kLast) + 1;
+
+// Used as the parent of modules that inherit directly from the root module.
+static constexpr int kRootParent = -1;
+
+struct ModuleInfo {
+    const char* fName;
+    ProgramKind fKind;
+    int fParent;
+};
+
+#define PARENT(type) static_cast<int>(ModuleType::type)
+
+static constexpr ModuleInfo kModuleInfo[kModuleTypeCount] = {
+    {"sksl_shared",            ProgramKind::kFragment,            kRootParent},
+    {"sksl_gpu",               ProgramKind::kFragment,            PARENT(kShared)},
+    {"sksl_vert",              ProgramKind::kVertex,              PARENT(kGPU)},
+    {"sksl_frag",              ProgramKind::kFragment,            PARENT(kGPU)},
+    {"sksl_compute",           ProgramKind::kCompute,             PARENT(kGPU)},
+    {"sksl_graphite_vert",     ProgramKind::kGraphiteVertex,      PARENT(kVertex)},
+    {"sksl_graphite_frag",     ProgramKind::kGraphiteFragment,    PARENT(kFragment)},
+    {"sksl_graphite_vert_es2", ProgramKind::kGraphiteVertexES2,   PARENT(kVertex)},
+    {"sksl_graphite_frag_es2", ProgramKind::kGraphiteFragmentES2, PARENT(kFragment)},
+    {"sksl_public",            ProgramKind::kFragment,            PARENT(kShared)},
+    {"sksl_rt_shader",         ProgramKind::kFragment,            PARENT(kPublic)},
+};
+
+#undef PARENT
+
+static const ModuleInfo& info(ModuleType type) {
+    return kModuleInfo[static_cast<int>(type)];
+}
+
+// Without Graphite, requests for the Graphite modules are satisfied by their parent modules.
+static ModuleType resolve(ModuleType type) {
+#if !defined(SK_GRAPHITE)
+    switch (type) {
+        case ModuleType::kGraphiteVertex:
+        case ModuleType::kGraphiteVertexES2:   return ModuleType::kVertex;
+        case ModuleType::kGraphiteFragment:
+        case ModuleType::kGraphiteFragmentES2: return ModuleType::kFragment;
+        default:                               break;
+    }
+#endif
+    return type;
+}
+
+static ModuleType module_type_for_program_kind(ProgramKind kind) {
+    switch (kind) {
+        case ProgramKind::kFragment:              return ModuleType::kFragment;
+        case ProgramKind::kVertex:                return ModuleType::kVertex;
+        case ProgramKind::kCompute:               return ModuleType::kCompute;
+        case ProgramKind::kGraphiteFragment:      return ModuleType::kGraphiteFragment;
+        case ProgramKind::kGraphiteVertex:        return ModuleType::kGraphiteVertex;
+        case ProgramKind::kGraphiteFragmentES2:   return ModuleType::kGraphiteFragmentES2;
+        case ProgramKind::kGraphiteVertexES2:     return ModuleType::kGraphiteVertexES2;
+        case ProgramKind::kPrivateRuntimeShader:  return ModuleType::kRuntimeShader;
+        case ProgramKind::kRuntimeColorFilter:
+        case ProgramKind::kRuntimeShader:
+        case ProgramKind::kRuntimeBlender:
+        case ProgramKind::kPrivateRuntimeColorFilter:
+        case ProgramKind::kPrivateRuntimeBlender:
+        case ProgramKind::kMeshVertex:
+        case ProgramKind::kMeshFragment:          return ModuleType::kPublic;
+    }
+    SkUNREACHABLE;
+}
+
+static std::string module_source(ModuleType type) {
+    switch (type) {
+        case ModuleType::kShared:              return MODULE_SOURCE(sksl_shared);
+        case ModuleType::kGPU:                 return MODULE_SOURCE(sksl_gpu);
+        case ModuleType::kVertex:              return MODULE_SOURCE(sksl_vert);
+        case ModuleType::kFragment:            return MODULE_SOURCE(sksl_frag);
+        case ModuleType::kCompute:             return MODULE_SOURCE(sksl_compute);
+#if defined(SK_GRAPHITE)
+        case ModuleType::kGraphiteVertex:      return MODULE_SOURCE(sksl_graphite_vert);
+        case ModuleType::kGraphiteFragment:    return MODULE_SOURCE(sksl_graphite_frag);
+        case ModuleType::kGraphiteVertexES2:   return MODULE_SOURCE(sksl_graphite_vert_es2);
+        case ModuleType::kGraphiteFragmentES2: return MODULE_SOURCE(sksl_graphite_frag_es2);
+#else
+        case ModuleType::kGraphiteVertex:
+        case ModuleType::kGraphiteFragment:
+        case ModuleType::kGraphiteVertexES2:
+        case ModuleType::kGraphiteFragmentES2: break;
+#endif
+        case ModuleType::kPublic:              return MODULE_SOURCE(sksl_public);
+        case ModuleType::kRuntimeShader:       return MODULE_SOURCE(sksl_rt_shader);
+    }
+    SkUNREACHABLE;
+}
+
+// Runs fn(0) ... fn(count - 1) on the calling thread and on 'executor'. The calling thread takes
+// part, so this completes even if the executor never gets around to running the tasks; the state
+// they share is reference counted for that reason.
+static void run_in_parallel(int count, SkExecutor& executor, const std::function<void(int)>& fn) {
+    if (count == 0) {
+        return;
+    }
+    struct SharedState {
+        std::atomic<int> fNext{0};
+        std::atomic<int> fDone{0};
+        SkSemaphore fFinished;
+    };
+    auto state = std::make_shared<SharedState>();
+    auto work = [state, count, fnPtr = &fn] {
+        // 'fn' is only used while a job is unfinished, so the caller is still waiting on it.
+        for (int i; (i = state->fNext.fetch_add(1)) < count;) {
+            (*fnPtr)(i);
+            if (state->fDone.fetch_add(1) + 1 == count) {
+                state->fFinished.signal();
+            }
+        }
+    };
+    for (int i = 1; i < count; ++i) {
+        executor.add(work);
+    }
+    work();
+    state->fFinished.wait();
+}
+
 struct ModuleLoader::Impl {
     Impl();
 
@@ -157,20 +301,8 @@ struct ModuleLoader::Impl {
 
     std::unique_ptr<const Module> fRootModule;
 
-    std::unique_ptr<const Module> fSharedModule;            // [Root] + Public intrinsics
-    std::unique_ptr<const Module> fGPUModule;               // [Shared] + Non-public intrinsics/
-                                                            //     helper functions
-    std::unique_ptr<const Module> fVertexModule;            // [GPU] + Vertex stage decls
-    std::unique_ptr<const Module> fFragmentModule;          // [GPU] + Fragment stage decls
-    std::unique_ptr<const Module> fComputeModule;           // [GPU] + Compute stage decls
-    std::unique_ptr<const Module> fGraphiteVertexModule;    // [Vert] + Graphite vertex helpers
-    std::unique_ptr<const Module> fGraphiteFragmentModule;  // [Frag] + Graphite fragment helpers
-    std::unique_ptr<const Module> fGraphiteVertexES2Module; // [Vert] + Graphite vertex ES2 helpers
-    std::unique_ptr<const Module> fGraphiteFragmentES2Module;//[Frag] + Graphite fragment ES2 "  "
-
-    std::unique_ptr<const Module> fPublicModule;            // [Shared] minus Private types +
-                                                            //     Runtime effect intrinsics
-    std::unique_ptr<const Module> fRuntimeShaderModule;     // [Public] + Runtime shader decls
+    // Indexed by ModuleType; loaded on demand.
+    std::unique_ptr<const Module> fModules[kModuleTypeCount];
 };
 
 ModuleLoader ModuleLoader::Get() {
@@ -187,15 +319,9 @@ ModuleLoader::~ModuleLoader() {
 }
 
 void ModuleLoader::unloadModules() {
-    fModuleLoader.fSharedModule           = nullptr;
-    fModuleLoader.fGPUModule              = nullptr;
-    fModuleLoader.fVertexModule           = nullptr;
-    fModuleLoader.fFragmentModule         = nullptr;
-    fModuleLoader.fComputeModule          = nullptr;
-    fModuleLoader.fGraphiteVertexModule   = nullptr;
-    fModuleLoader.fGraphiteFragmentModule = nullptr;
-    fModuleLoader.fPublicModule           = nullptr;
-    fModuleLoader.fRuntimeShaderModule    = nullptr;
+    for (std::unique_ptr<const Module>& module : fModuleLoader.fModules) {
+        module = nullptr;
+    }
 }
 
 ModuleLoader::Impl::Impl() {
@@ -243,19 +369,18 @@ static std::unique_ptr<Module> compile_and_shrink(SkSL::Compiler* compiler,
                        m->fElements.end());
 
     m->fElements.shrink_to_fit();
-    return m;
-}
-
-const BuiltinTypes& ModuleLoader::builtinTypes() {
-    return fModuleLoader.fBuiltinTypes;
-}
 
-const Module* ModuleLoader::rootModule() {
-    return fModuleLoader.fRootModule.get();
+    // The module won't change from here on, so analyze its functions once, up front, instead of in
+    // every program that calls them.
+    for (std::unique_ptr<ProgramElement>& element : m->fElements) {
+        if (element->is<FunctionDefinition>()) {
+            element->as<FunctionDefinition>().cacheAnalysis();
+        }
+    }
+    return m;
 }
 
-void ModuleLoader::addPublicTypeAliases(const SkSL::Module* module) {
-    const SkSL::BuiltinTypes& types = this->builtinTypes();
+static void add_public_type_aliases(const SkSL::BuiltinTypes& types, const SkSL::Module* module) {
     SymbolTable* symbols = module->fSymbols.get();
 
     // Add some aliases to the runtime effect modules so that it's friendlier, and more like GLSL.
@@ -292,144 +417,159 @@ void ModuleLoader::addPublicTypeAliases(const SkSL::Module* module) {
     }
 }
 
-const Module* ModuleLoader::loadPublicModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fPublicModule) {
-        const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fPublicModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_public),
-                                                         sharedModule);
-        this->addPublicTypeAliases(fModuleLoader.fPublicModule.get());
+// Compiles a module whose parent has already been loaded. This doesn't touch the ModuleLoader, so
+// independent modules can be compiled concurrently, each with its own Compiler.
+// TODO: load a binary IR form of each module, generated at build time, instead of parsing its
+// minified source here. That needs a serializer for every IR node and is tracked separately.
+static std::unique_ptr<const Module> compile_module(SkSL::Compiler* compiler,
+                                                    ModuleType type,
+                                                    const Module* parent) {
+    const ModuleInfo& moduleInfo = info(type);
+    std::unique_ptr<Module> module = compile_and_shrink(compiler,
+                                                        moduleInfo.fKind,
+                                                        moduleInfo.fName,
+                                                        module_source(type),
+                                                        parent);
+    if (type == ModuleType::kPublic) {
+        add_public_type_aliases(compiler->context().fTypes, module.get());
     }
-    return fModuleLoader.fPublicModule.get();
+    return module;
 }
 
-const Module* ModuleLoader::loadPrivateRTShaderModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fRuntimeShaderModule) {
-        const Module* publicModule = this->loadPublicModule(compiler);
-        fModuleLoader.fRuntimeShaderModule = compile_and_shrink(compiler,
-                                                                ProgramKind::kFragment,
-                                                                MODULE_DATA(sksl_rt_shader),
-                                                                publicModule);
+const BuiltinTypes& ModuleLoader::builtinTypes() {
+    return fModuleLoader.fBuiltinTypes;
+}
+
+const Module* ModuleLoader::rootModule() {
+    return fModuleLoader.fRootModule.get();
+}
+
+void ModuleLoader::addPublicTypeAliases(const SkSL::Module* module) {
+    add_public_type_aliases(this->builtinTypes(), module);
+}
+
+static const Module* load_module(ModuleLoader* loader,
+                                 std::unique_ptr<const Module>* modules,
+                                 ModuleType type,
+                                 SkSL::Compiler* compiler) {
+    type = resolve(type);
+    std::unique_ptr<const Module>& module = modules[static_cast<int>(type)];
+    if (!module) {
+        int parentIndex = info(type).fParent;
+        const Module* parent = parentIndex == kRootParent
+                ? loader->rootModule()
+                : load_module(loader, modules, static_cast<ModuleType>(parentIndex), compiler);
+        module = compile_module(compiler, type, parent);
     }
-    return fModuleLoader.fRuntimeShaderModule.get();
+    return module.get();
+}
+
+const Module* ModuleLoader::loadModuleForProgramKind(ProgramKind kind, SkSL::Compiler* compiler) {
+    return load_module(this, fModuleLoader.fModules, module_type_for_program_kind(kind), compiler);
+}
+
+const Module* ModuleLoader::loadPublicModule(SkSL::Compiler* compiler) {
+    return load_module(this, fModuleLoader.fModules, ModuleType::kPublic, compiler);
+}
+
+const Module* ModuleLoader::loadPrivateRTShaderModule(SkSL::Compiler* compiler) {
+    return load_module(this, fModuleLoader.fModules, ModuleType::kRuntimeShader, compiler);
 }
 
 const Module* ModuleLoader::loadSharedModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fSharedModule) {
-        const Module* rootModule = this->rootModule();
-        fModuleLoader.fSharedModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_shared),
-                                                         rootModule);
-    }
-    return fModuleLoader.fSharedModule.get();
+    return load_module(this, fModuleLoader.fModules, ModuleType::kShared, compiler);
 }
 
 const Module* ModuleLoader::loadGPUModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGPUModule) {
-        const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fGPUModule = compile_and_shrink(compiler,
-                                                      ProgramKind::kFragment,
-                                                      MODULE_DATA(sksl_gpu),
-                                                      sharedModule);
-    }
-    return fModuleLoader.fGPUModule.get();
+    return load_module(this, fModuleLoader.fModules, ModuleType::kGPU, compiler);
 }
 
 const Module* ModuleLoader::loadFragmentModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fFragmentModule) {
-        const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fFragmentModule = compile_and_shrink(compiler,
-                                                           ProgramKind::kFragment,
-                                                           MODULE_DATA(sksl_frag),
-                                                           gpuModule);
-    }
-    return fModuleLoader.fFragmentModule.get();
+    return load_module(this, fModuleLoader.fModules, ModuleType::kFragment, compiler);
 }
 
 const Module* ModuleLoader::loadVertexModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fVertexModule) {
-        const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fVertexModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kVertex,
-                                                         MODULE_DATA(sksl_vert),
-                                                         gpuModule);
-    }
-    return fModuleLoader.fVertexModule.get();
+    return load_module(this, fModuleLoader.fModules, ModuleType::kVertex, compiler);
 }
 
 const Module* ModuleLoader::loadComputeModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fComputeModule) {
-        const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fComputeModule = compile_and_shrink(compiler,
-                                                          ProgramKind::kCompute,
-                                                          MODULE_DATA(sksl_compute),
-                                                          gpuModule);
-    }
-    return fModuleLoader.fComputeModule.get();
+    return load_module(this, fModuleLoader.fModules, ModuleType::kCompute, compiler);
 }
 
 const Module* ModuleLoader::loadGraphiteFragmentModule(SkSL::Compiler* compiler) {
-#if defined(SK_GRAPHITE)
-    if (!fModuleLoader.fGraphiteFragmentModule) {
-        const Module* fragmentModule = this->loadFragmentModule(compiler);
-        fModuleLoader.fGraphiteFragmentModule = compile_and_shrink(compiler,
-                                                                   ProgramKind::kGraphiteFragment,
-                                                                   MODULE_DATA(sksl_graphite_frag),
-                                                                   fragmentModule);
-    }
-    return fModuleLoader.fGraphiteFragmentModule.get();
-#else
-    return this->loadFragmentModule(compiler);
-#endif
+    return load_module(this, fModuleLoader.fModules, ModuleType::kGraphiteFragment, compiler);
 }
 
 const Module* ModuleLoader::loadGraphiteFragmentES2Module(SkSL::Compiler* compiler) {
-#if defined(SK_GRAPHITE)
-    if (!fModuleLoader.fGraphiteFragmentES2Module) {
-        const Module* fragmentModule = this->loadFragmentModule(compiler);
-        fModuleLoader.fGraphiteFragmentES2Module =
-                compile_and_shrink(compiler,
-                                   ProgramKind::kGraphiteFragmentES2,
-                                   MODULE_DATA(sksl_graphite_frag_es2),
-                                   fragmentModule);
-    }
-    return fModuleLoader.fGraphiteFragmentES2Module.get();
-#else
-    return this->loadFragmentModule(compiler);
-#endif
+    return load_module(this, fModuleLoader.fModules, ModuleType::kGraphiteFragmentES2, compiler);
 }
 
 const Module* ModuleLoader::loadGraphiteVertexModule(SkSL::Compiler* compiler) {
-#if defined(SK_GRAPHITE)
-    if (!fModuleLoader.fGraphiteVertexModule) {
-        const Module* vertexModule = this->loadVertexModule(compiler);
-        fModuleLoader.fGraphiteVertexModule = compile_and_shrink(compiler,
-                                                                 ProgramKind::kGraphiteVertex,
-                                                                 MODULE_DATA(sksl_graphite_vert),
-                                                                 vertexModule);
-    }
-    return fModuleLoader.fGraphiteVertexModule.get();
-#else
-    return this->loadVertexModule(compiler);
-#endif
+    return load_module(this, fModuleLoader.fModules, ModuleType::kGraphiteVertex, compiler);
 }
 
 const Module* ModuleLoader::loadGraphiteVertexES2Module(SkSL::Compiler* compiler) {
-#if defined(SK_GRAPHITE)
-    if (!fModuleLoader.fGraphiteVertexES2Module) {
-        const Module* vertexModule = this->loadVertexModule(compiler);
-        fModuleLoader.fGraphiteVertexES2Module =
-                compile_and_shrink(compiler,
-                                   ProgramKind::kGraphiteVertexES2,
-                                   MODULE_DATA(sksl_graphite_vert_es2),
-                                   vertexModule);
+    return load_module(this, fModuleLoader.fModules, ModuleType::kGraphiteVertexES2, compiler);
+}
+
+void ModuleLoader::LoadModulesInParallel(SkSpan<const ProgramKind> kinds, SkExecutor& executor) {
+    // Find every module that's needed, and how far it is from the root. Modules at the same depth
+    // never depend on each other.
+    int depth[kModuleTypeCount];
+    std::fill(std::begin(depth), std::end(depth), -1);
+    int maxDepth = -1;
+    for (ProgramKind kind : kinds) {
+        for (int index = static_cast<int>(resolve(module_type_for_program_kind(kind)));
+             index != kRootParent;
+             index = kModuleInfo[index].fParent) {
+            int moduleDepth = 0;
+            for (int p = kModuleInfo[index].fParent; p != kRootParent; p = kModuleInfo[p].fParent) {
+                ++moduleDepth;
+            }
+            depth[index] = moduleDepth;
+            maxDepth = std::max(maxDepth, moduleDepth);
+        }
+    }
+
+    for (int d = 0; d <= maxDepth; ++d) {
+        struct Job {
+            ModuleType fType;
+            const Module* fParent;
+            std::unique_ptr<const Module> fModule;
+        };
+        std::vector<Job> jobs;
+        {
+            ModuleLoader loader = Get();
+            for (int index = 0; index < kModuleTypeCount; ++index) {
+                if (depth[index] != d || loader.fModuleLoader.fModules[index]) {
+                    continue;
+                }
+                // The parent was loaded at the previous depth (or earlier).
+                int parentIndex = kModuleInfo[index].fParent;
+                const Module* parent = parentIndex == kRootParent
+                        ? loader.rootModule()
+                        : loader.fModuleLoader.fModules[parentIndex].get();
+                SkASSERT(parent);
+                jobs.push_back({static_cast<ModuleType>(index), parent, nullptr});
+            }
+        }
+
+        // The ModuleLoader is unlocked while compiling; Compiler construction needs to take it.
+        run_in_parallel(SkToInt(jobs.size()), executor, [&jobs](int i) {
+            SkSL::Compiler compiler;
+            jobs[i].fModule = compile_module(&compiler, jobs[i].fType, jobs[i].fParent);
+        });
+
+        ModuleLoader loader = Get();
+        for (Job& job : jobs) {
+            std::unique_ptr<const Module>& module =
+                    loader.fModuleLoader.fModules[static_cast<int>(job.fType)];
+            // The module may have been loaded on demand by another thread in the meantime.
+            if (!module) {
+                module = std::move(job.fModule);
+            }
+        }
     }
-    return fModuleLoader.fGraphiteVertexES2Module.get();
-#else
-    return this->loadVertexModule(compiler);
-#endif
 }
 
 void ModuleLoader::Impl::makeRootSymbolTable() {
@@ -8,9 +8,13 @@
 #ifndef SKSL_MODULELOADER
 #define SKSL_MODULELOADER
 
+#include "include/core/SkSpan.h"
 #include "src/sksl/SkSLBuiltinTypes.h"
+#include "src/sksl/SkSLProgramKind.h"
 #include <memory>
 
+class SkExecutor;
+
 namespace SkSL {
 
 class Compiler;
@@ -37,8 +41,14 @@ public:
     const BuiltinTypes& builtinTypes();
     const Module* rootModule();
 
+    // Loads the modules needed by each of the given program kinds ahead of time. Modules that
+    // don't depend on each other are compiled concurrently, on the calling thread and 'executor'.
+    // This must not be called while holding a ModuleLoader.
+    static void LoadModulesInParallel(SkSpan<const ProgramKind> kinds, SkExecutor& executor);
+
     // These modules are loaded on demand; once loaded, they are kept for the lifetime of the
     // process.
+    const Module* loadModuleForProgramKind(ProgramKind kind, SkSL::Compiler* compiler);
     const Module* loadSharedModule(SkSL::Compiler* compiler);
     const Module* loadGPUModule(SkSL::Compiler* compiler);
     const Module* loadVertexModule(SkSL::Compiler* compiler);
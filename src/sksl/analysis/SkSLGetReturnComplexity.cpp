@@ -114,6 +114,9 @@ public:
 };
 
 Analysis::ReturnComplexity Analysis::GetReturnComplexity(const FunctionDefinition& funcDef) {
+    if (funcDef.hasCachedAnalysis()) {
+        return funcDef.cachedReturnComplexity();
+    }
     int returnsAtEndOfControlFlow = count_returns_at_end_of_control_flow(funcDef);
     CountReturnsWithLimit counter{funcDef, returnsAtEndOfControlFlow + 1};
     if (counter.fNumReturns > returnsAtEndOfControlFlow) {
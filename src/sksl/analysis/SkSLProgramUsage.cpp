@@ -198,6 +198,14 @@ void ProgramUsage::add(const Statement* stmt) {
 }
 
 void ProgramUsage::add(const ProgramElement& element) {
+    // Module functions carry a precomputed usage; there's no need to walk the function again.
+    if (element.is<FunctionDefinition>()) {
+        const FunctionDefinition& function = element.as<FunctionDefinition>();
+        if (function.hasCachedAnalysis()) {
+            this->merge(function.cachedUsage(), /*delta=*/+1);
+            return;
+        }
+    }
     ProgramUsageVisitor addRefs(this, /*delta=*/+1);
     addRefs.visitProgramElement(element);
 }
@@ -213,10 +221,35 @@ void ProgramUsage::remove(const Statement* stmt) {
 }
 
 void ProgramUsage::remove(const ProgramElement& element) {
+    if (element.is<FunctionDefinition>()) {
+        const FunctionDefinition& function = element.as<FunctionDefinition>();
+        if (function.hasCachedAnalysis()) {
+            this->merge(function.cachedUsage(), /*delta=*/-1);
+            return;
+        }
+    }
     ProgramUsageVisitor subRefs(this, /*delta=*/-1);
     subRefs.visitProgramElement(element);
 }
 
+void ProgramUsage::merge(const ProgramUsage& that, int delta) {
+    for (const auto& [type, count] : that.fStructCounts) {
+        fStructCounts[type] += delta * count;
+        SkASSERT(fStructCounts[type] >= 0);
+    }
+    for (const auto& [fn, count] : that.fCallCounts) {
+        fCallCounts[fn] += delta * count;
+        SkASSERT(fCallCounts[fn] >= 0);
+    }
+    for (const auto& [var, thatCounts] : that.fVariableCounts) {
+        VariableCounts& counts = fVariableCounts[var];
+        counts.fVarExists += delta * thatCounts.fVarExists;
+        counts.fRead += delta * thatCounts.fRead;
+        counts.fWrite += delta * thatCounts.fWrite;
+        SkASSERT(counts.fVarExists >= 0 && counts.fRead >= 0 && counts.fWrite >= 0);
+    }
+}
+
 static bool contains_matching_data(const ProgramUsage& a, const ProgramUsage& b) {
     constexpr bool kReportMismatch = false;
 
@@ -50,6 +50,10 @@ public:
     // All Symbol* objects in fCallCounts must be FunctionDeclaration*.
     skia_private::THashMap<const Symbol*, int> fCallCounts;
     skia_private::THashMap<const Variable*, VariableCounts> fVariableCounts;
+
+private:
+    // Adds (or with a delta of -1, subtracts) every count in `that` to this usage.
+    void merge(const ProgramUsage& that, int delta);
 };
 
 }  // namespace SkSL
@@ -1271,8 +1271,515 @@ std::unique_ptr<Program> Builder::finish(int numValueSlots,
                                      numImmutableSlots, fNumLabels, debugTrace);
 }
 
+// Describes how an instruction accesses the value slots. Slots which are only partially written
+// (e.g. by a masked copy) are listed as reads, since their prior contents remain visible.
+struct SlotAccess {
+    SlotRange fReads[2];
+    // Slots which are overwritten in every lane, regardless of the execution mask.
+    SlotRange fKills;
+    // True if the instruction accesses slots that we can't identify ahead of time.
+    bool fOpaque = false;
+};
+
+static SlotAccess slot_access(const Instruction& inst) {
+    SlotAccess access;
+    switch (inst.fOp) {
+        case BuilderOp::copy_constant:
+        case BuilderOp::copy_immutable_unmasked:
+        case BuilderOp::copy_stack_to_slots_unmasked:
+            access.fKills = {inst.fSlotA, inst.fImmA};
+            break;
+
+        case BuilderOp::copy_uniform_to_slots_unmasked:
+            access.fKills = {inst.fSlotB, inst.fImmA};
+            break;
+
+        case BuilderOp::copy_slot_unmasked:
+            access.fReads[0] = {inst.fSlotB, inst.fImmA};
+            access.fKills = {inst.fSlotA, inst.fImmA};
+            break;
+
+        case BuilderOp::copy_slot_masked:
+            access.fReads[0] = {inst.fSlotB, inst.fImmA};
+            access.fReads[1] = {inst.fSlotA, inst.fImmA};
+            break;
+
+        case BuilderOp::copy_stack_to_slots:
+        case BuilderOp::push_slots:
+            access.fReads[0] = {inst.fSlotA, inst.fImmA};
+            break;
+
+        case BuilderOp::store_src_rg:
+            access.fKills = {inst.fSlotA, 2};
+            break;
+
+        case BuilderOp::store_src:
+        case BuilderOp::store_dst:
+        case BuilderOp::store_device_xy01:
+            access.fKills = {inst.fSlotA, 4};
+            break;
+
+        case BuilderOp::load_src:
+        case BuilderOp::load_dst:
+            access.fReads[0] = {inst.fSlotA, 4};
+            break;
+
+        case BuilderOp::reenable_loop_mask:
+            access.fReads[0] = {inst.fSlotA, 1};
+            break;
+
+        // These ops only touch the temp stacks, the execution masks, or the src/dst registers.
+        case ALL_SINGLE_SLOT_UNARY_OP_CASES:
+        case ALL_MULTI_SLOT_UNARY_OP_CASES:
+        case ALL_N_WAY_BINARY_OP_CASES:
+        case ALL_MULTI_SLOT_BINARY_OP_CASES:
+        case ALL_N_WAY_TERNARY_OP_CASES:
+        case ALL_MULTI_SLOT_TERNARY_OP_CASES:
+        case BuilderOp::label:
+        case BuilderOp::jump:
+        case BuilderOp::branch_if_all_lanes_active:
+        case BuilderOp::branch_if_any_lanes_active:
+        case BuilderOp::branch_if_no_lanes_active:
+        case BuilderOp::branch_if_no_active_lanes_on_stack_top_equal:
+        case BuilderOp::init_lane_masks:
+        case BuilderOp::store_immutable_value:
+        case BuilderOp::select:
+        case BuilderOp::refract_4_floats:
+        case BuilderOp::inverse_mat2:
+        case BuilderOp::inverse_mat3:
+        case BuilderOp::inverse_mat4:
+        case BuilderOp::dot_2_floats:
+        case BuilderOp::dot_3_floats:
+        case BuilderOp::dot_4_floats:
+        case BuilderOp::swizzle_1:
+        case BuilderOp::swizzle_2:
+        case BuilderOp::swizzle_3:
+        case BuilderOp::swizzle_4:
+        case BuilderOp::shuffle:
+        case BuilderOp::matrix_multiply_2:
+        case BuilderOp::matrix_multiply_3:
+        case BuilderOp::matrix_multiply_4:
+        case BuilderOp::exchange_src:
+        case BuilderOp::push_src_rgba:
+        case BuilderOp::push_dst_rgba:
+        case BuilderOp::push_device_xy01:
+        case BuilderOp::pop_src_rgba:
+        case BuilderOp::pop_dst_rgba:
+        case BuilderOp::push_immutable:
+        case BuilderOp::push_immutable_indirect:
+        case BuilderOp::push_uniform:
+        case BuilderOp::push_uniform_indirect:
+        case BuilderOp::push_constant:
+        case BuilderOp::push_clone:
+        case BuilderOp::push_clone_from_stack:
+        case BuilderOp::push_clone_indirect_from_stack:
+        case BuilderOp::push_condition_mask:
+        case BuilderOp::pop_condition_mask:
+        case BuilderOp::merge_condition_mask:
+        case BuilderOp::merge_inv_condition_mask:
+        case BuilderOp::push_loop_mask:
+        case BuilderOp::pop_loop_mask:
+        case BuilderOp::pop_and_reenable_loop_mask:
+        case BuilderOp::mask_off_loop_mask:
+        case BuilderOp::merge_loop_mask:
+        case BuilderOp::push_return_mask:
+        case BuilderOp::pop_return_mask:
+        case BuilderOp::mask_off_return_mask:
+        case BuilderOp::case_op:
+        case BuilderOp::continue_op:
+        case BuilderOp::pad_stack:
+        case BuilderOp::discard_stack:
+        case BuilderOp::invoke_shader:
+        case BuilderOp::invoke_color_filter:
+        case BuilderOp::invoke_blender:
+        case BuilderOp::invoke_to_linear_srgb:
+        case BuilderOp::invoke_from_linear_srgb:
+            break;
+
+        default:
+            if (is_immediate_op(inst.fOp)) {
+                // An immediate-mode op either works on the stack, or updates slots in place.
+                if (inst.fSlotA != NA) {
+                    access.fReads[0] = {inst.fSlotA, inst.fImmA};
+                }
+                break;
+            }
+            // Indirect accesses and debug traces can touch any slot; be conservative.
+            access.fOpaque = true;
+            break;
+    }
+    return access;
+}
+
+static bool is_branch(BuilderOp op) {
+    switch (op) {
+        case BuilderOp::jump:
+        case BuilderOp::branch_if_all_lanes_active:
+        case BuilderOp::branch_if_any_lanes_active:
+        case BuilderOp::branch_if_no_lanes_active:
+        case BuilderOp::branch_if_no_active_lanes_on_stack_top_equal:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void Program::optimize() {
-    // TODO(johnstiles): perform any last-minute cleanup of the instruction stream here
+    if (fNumValueSlots == 0) {
+        return;
+    }
+    // The Builder simplifies the instruction stream as it goes, but can only look at the most
+    // recent few instructions. These passes look at the program as a whole: first, reads of a
+    // slot that was just copied from another slot are redirected to the original, which often
+    // leaves the copy itself unused. Then, writes to slots that are never read again are removed.
+    this->forwardSlotCopies();
+    this->eliminateDeadSlotWrites();
+}
+
+void Program::forwardSlotCopies() {
+    // Labels which are never branched to can only be reached by falling through, so they don't
+    // interrupt the flow of values from one instruction to the next.
+    SkBitSet branchTargets(fNumLabels);
+    for (const Instruction& inst : fInstructions) {
+        if (is_branch(inst.fOp)) {
+            branchTargets.set(inst.fImmA);
+        }
+    }
+
+    // For each value slot, tracks where its contents were most recently copied from by an
+    // unmasked copy. A copy of another value slot is only usable while neither slot has been
+    // rewritten, which we detect by comparing write counts; uniforms and immutable data never
+    // change. Everything is forgotten at branch targets (since other paths lead there) and at
+    // instructions which might write to any slot.
+    enum class Source { kNone, kValue, kUniform, kImmutable };
+    struct CopyOrigin {
+        Source fSource = Source::kNone;
+        Slot   fSlot = NA;
+        int    fWriteCount = 0;  // the write count of `fSlot` when the copy was made
+        int    fEpoch = -1;
+    };
+    TArray<CopyOrigin> origins;
+    origins.push_back_n(fNumValueSlots);
+    TArray<int> writeCounts;
+    writeCounts.push_back_n(fNumValueSlots, 0);
+    int epoch = 0;
+
+    auto originOf = [&](Slot slot) -> const CopyOrigin* {
+        const CopyOrigin& origin = origins[slot];
+        if (origin.fEpoch != epoch || origin.fSource == Source::kNone) {
+            return nullptr;
+        }
+        if (origin.fSource == Source::kValue &&
+            writeCounts[origin.fSlot] != origin.fWriteCount) {
+            return nullptr;
+        }
+        return &origin;
+    };
+
+    // Returns the origin of the first slot in `range`, if the entire range was copied from one
+    // contiguous range of slots, uniforms or immutable data.
+    auto rangeOrigin = [&](SlotRange range) -> const CopyOrigin* {
+        const CopyOrigin* first = originOf(range.index);
+        if (!first) {
+            return nullptr;
+        }
+        for (int index = 1; index < range.count; ++index) {
+            const CopyOrigin* next = originOf(range.index + index);
+            if (!next || next->fSource != first->fSource || next->fSlot != first->fSlot + index) {
+                return nullptr;
+            }
+        }
+        return first;
+    };
+
+    TArray<Instruction> instructions;
+    instructions.reserve_exact(fInstructions.size());
+
+    for (Instruction inst : fInstructions) {
+        if (inst.fOp == BuilderOp::label && branchTargets.test(inst.fImmA)) {
+            ++epoch;
+        }
+
+        // Read directly from the original slots when we can.
+        if (inst.fOp == BuilderOp::push_slots) {
+            if (const CopyOrigin* origin = rangeOrigin({inst.fSlotA, inst.fImmA})) {
+                switch (origin->fSource) {
+                    case Source::kUniform:   inst.fOp = BuilderOp::push_uniform;   break;
+                    case Source::kImmutable: inst.fOp = BuilderOp::push_immutable; break;
+                    default:                                                       break;
+                }
+                inst.fSlotA = origin->fSlot;
+            }
+        } else if (inst.fOp == BuilderOp::copy_slot_unmasked) {
+            SlotRange dst = {inst.fSlotA, inst.fImmA};
+            if (const CopyOrigin* origin = rangeOrigin({inst.fSlotB, inst.fImmA})) {
+                switch (origin->fSource) {
+                    case Source::kUniform:
+                        inst.fOp = BuilderOp::copy_uniform_to_slots_unmasked;
+                        inst.fSlotA = origin->fSlot;
+                        inst.fSlotB = dst.index;
+                        break;
+
+                    case Source::kImmutable:
+                        inst.fOp = BuilderOp::copy_immutable_unmasked;
+                        inst.fSlotB = origin->fSlot;
+                        break;
+
+                    default:
+                        if (origin->fSlot == dst.index) {
+                            // The slots already hold this value; the copy is a no-op.
+                            continue;
+                        }
+                        if (!slot_ranges_overlap(dst, {origin->fSlot, inst.fImmA})) {
+                            inst.fSlotB = origin->fSlot;
+                        }
+                        break;
+                }
+            }
+        } else if (inst.fOp == BuilderOp::copy_slot_masked) {
+            // There's no masked copy from uniforms or immutable data.
+            const CopyOrigin* origin = rangeOrigin({inst.fSlotB, inst.fImmA});
+            if (origin && origin->fSource == Source::kValue &&
+                !slot_ranges_overlap({inst.fSlotA, inst.fImmA}, {origin->fSlot, inst.fImmA})) {
+                inst.fSlotB = origin->fSlot;
+            }
+        }
+
+        SlotAccess access = slot_access(inst);
+        if (access.fOpaque) {
+            ++epoch;
+        }
+
+        // Any slot which is written to no longer holds a copy of anything.
+        auto markWritten = [&](SlotRange range) {
+            for (int index = 0; index < range.count; ++index) {
+                ++writeCounts[range.index + index];
+                origins[range.index + index].fSource = Source::kNone;
+            }
+        };
+        markWritten(access.fKills);
+        if (inst.fOp == BuilderOp::copy_slot_masked ||
+            inst.fOp == BuilderOp::copy_stack_to_slots ||
+            (is_immediate_op(inst.fOp) && inst.fSlotA != NA)) {
+            markWritten({inst.fSlotA, inst.fImmA});
+        }
+
+        // Remember where the copied slots came from.
+        Source source = Source::kNone;
+        SlotRange dst, src;
+        switch (inst.fOp) {
+            case BuilderOp::copy_slot_unmasked:
+                dst = {inst.fSlotA, inst.fImmA};
+                src = {inst.fSlotB, inst.fImmA};
+                if (!slot_ranges_overlap(dst, src)) {
+                    source = Source::kValue;
+                }
+                break;
+
+            case BuilderOp::copy_uniform_to_slots_unmasked:
+                source = Source::kUniform;
+                dst = {inst.fSlotB, inst.fImmA};
+                src = {inst.fSlotA, inst.fImmA};
+                break;
+
+            case BuilderOp::copy_immutable_unmasked:
+                source = Source::kImmutable;
+                dst = {inst.fSlotA, inst.fImmA};
+                src = {inst.fSlotB, inst.fImmA};
+                break;
+
+            default:
+                break;
+        }
+        if (source != Source::kNone) {
+            for (int index = 0; index < dst.count; ++index) {
+                Slot srcSlot = src.index + index;
+                int writeCount = (source == Source::kValue) ? writeCounts[srcSlot] : 0;
+                origins[dst.index + index] = {source, srcSlot, writeCount, epoch};
+            }
+        }
+
+        instructions.push_back(inst);
+    }
+
+    fInstructions = std::move(instructions);
+}
+
+void Program::eliminateDeadSlotWrites() {
+    // Split the program into basic blocks. A block begins at each label, and after each branch.
+    struct Block {
+        int fStart;
+        int fEnd;
+        int fSuccessors[2] = {-1, -1};
+        std::vector<bool> fLiveIn;
+    };
+    TArray<Block> blocks;
+    TArray<int> labelToBlock;
+    labelToBlock.push_back_n(fNumLabels, -1);
+
+    const int numInstructions = fInstructions.size();
+    for (int index = 0; index < numInstructions; ++index) {
+        const Instruction& inst = fInstructions[index];
+        if (blocks.empty() || (inst.fOp == BuilderOp::label && blocks.back().fStart != index)) {
+            if (!blocks.empty()) {
+                blocks.back().fEnd = index;
+            }
+            blocks.push_back({index, numInstructions});
+        }
+        if (inst.fOp == BuilderOp::label) {
+            labelToBlock[inst.fImmA] = blocks.size() - 1;
+        }
+        if (is_branch(inst.fOp) && index + 1 < numInstructions) {
+            blocks.back().fEnd = index + 1;
+            blocks.push_back({index + 1, numInstructions});
+        }
+    }
+
+    // Each block falls through to the next one, unless it ends with an unconditional jump. A
+    // block that ends with a branch can also continue at the branch target.
+    for (int blockIdx = 0; blockIdx < blocks.size(); ++blockIdx) {
+        Block& block = blocks[blockIdx];
+        const Instruction& last = fInstructions[block.fEnd - 1];
+        int numSuccessors = 0;
+        if (last.fOp != BuilderOp::jump && blockIdx + 1 < blocks.size()) {
+            block.fSuccessors[numSuccessors++] = blockIdx + 1;
+        }
+        if (is_branch(last.fOp)) {
+            SkASSERT(labelToBlock[last.fImmA] >= 0);
+            block.fSuccessors[numSuccessors++] = labelToBlock[last.fImmA];
+        }
+        block.fLiveIn.assign(fNumValueSlots, false);
+    }
+
+    // Nothing is live once the program finishes; the result is returned in src.rgba.
+    auto liveOut = [&](const Block& block, std::vector<bool>* live) {
+        live->assign(fNumValueSlots, false);
+        for (int successor : block.fSuccessors) {
+            if (successor >= 0) {
+                const std::vector<bool>& liveIn = blocks[successor].fLiveIn;
+                for (int slot = 0; slot < fNumValueSlots; ++slot) {
+                    if (liveIn[slot]) {
+                        (*live)[slot] = true;
+                    }
+                }
+            }
+        }
+    };
+    auto transfer = [&](const Instruction& inst, std::vector<bool>* live) {
+        SlotAccess access = slot_access(inst);
+        if (access.fOpaque) {
+            live->assign(fNumValueSlots, true);
+            return;
+        }
+        for (int index = 0; index < access.fKills.count; ++index) {
+            (*live)[access.fKills.index + index] = false;
+        }
+        for (const SlotRange& read : access.fReads) {
+            for (int index = 0; index < read.count; ++index) {
+                (*live)[read.index + index] = true;
+            }
+        }
+    };
+
+    // Iterate until the set of slots that are live on entry to each block settles. Visiting the
+    // blocks in reverse order means that this usually happens on the first pass, unless the
+    // program contains a loop.
+    std::vector<bool> live;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int blockIdx = blocks.size() - 1; blockIdx >= 0; --blockIdx) {
+            Block& block = blocks[blockIdx];
+            liveOut(block, &live);
+            for (int index = block.fEnd - 1; index >= block.fStart; --index) {
+                transfer(fInstructions[index], &live);
+            }
+            if (live != block.fLiveIn) {
+                block.fLiveIn = live;
+                changed = true;
+            }
+        }
+    }
+
+    // Now that we know which slots are live after each instruction, remove (or trim) the writes
+    // whose results are never read.
+    SkBitSet removed(numInstructions);
+    int numRemoved = 0;
+    auto anyLive = [&](SlotRange range) {
+        for (int index = 0; index < range.count; ++index) {
+            if (live[range.index + index]) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (const Block& block : blocks) {
+        liveOut(block, &live);
+        for (int index = block.fEnd - 1; index >= block.fStart; --index) {
+            Instruction& inst = fInstructions[index];
+            switch (inst.fOp) {
+                case BuilderOp::copy_constant:
+                case BuilderOp::copy_immutable_unmasked:
+                case BuilderOp::copy_slot_unmasked:
+                case BuilderOp::copy_uniform_to_slots_unmasked:
+                case BuilderOp::copy_stack_to_slots_unmasked:
+                case BuilderOp::store_src_rg:
+                case BuilderOp::store_src:
+                case BuilderOp::store_dst:
+                case BuilderOp::store_device_xy01: {
+                    SlotRange dst = slot_access(inst).fKills;
+                    if (!anyLive(dst)) {
+                        removed.set(index);
+                        ++numRemoved;
+                        continue;
+                    }
+                    // Stores always write an entire register, and the result of an overlapping
+                    // copy depends on the order that the slots are copied in. Anything else can
+                    // have dead slots trimmed off of either end of the destination range.
+                    if (inst.fOp == BuilderOp::store_src_rg ||
+                        inst.fOp == BuilderOp::store_src ||
+                        inst.fOp == BuilderOp::store_dst ||
+                        inst.fOp == BuilderOp::store_device_xy01 ||
+                        (inst.fOp == BuilderOp::copy_slot_unmasked &&
+                         slot_ranges_overlap(dst, {inst.fSlotB, inst.fImmA}))) {
+                        break;
+                    }
+                    while (!live[dst.index + inst.fImmA - 1]) {
+                        --inst.fImmA;
+                    }
+                    while (!live[dst.index]) {
+                        ++dst.index;
+                        --inst.fImmA;
+                        switch (inst.fOp) {
+                            case BuilderOp::copy_constant:
+                                ++inst.fSlotA;
+                                break;
+                            case BuilderOp::copy_stack_to_slots_unmasked:
+                                ++inst.fSlotA;
+                                --inst.fImmB;
+                                break;
+                            default:
+                                ++inst.fSlotA;
+                                ++inst.fSlotB;
+                                break;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            transfer(inst, &live);
+        }
+    }
+
+    TArray<Instruction> instructions;
+    instructions.reserve_exact(numInstructions - numRemoved);
+    for (int index = 0; index < numInstructions; ++index) {
+        if (!removed.test(index)) {
+            instructions.push_back(fInstructions[index]);
+        }
+    }
+    fInstructions = std::move(instructions);
 }
 
 static int stack_usage(const Instruction& inst) {
@@ -189,6 +189,10 @@ private:
     void optimize();
     StackDepths tempStackMaxDepths() const;
 
+    // These methods are the individual passes run by `optimize`.
+    void forwardSlotCopies();
+    void eliminateDeadSlotWrites();
+
     // These methods are used to split up multi-slot copies into multiple ops as needed.
     void appendCopy(skia_private::TArray<Stage>* pipeline,
                     SkArenaAlloc* alloc,
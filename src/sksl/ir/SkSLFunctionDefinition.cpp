@@ -17,6 +17,7 @@
 #include "src/sksl/SkSLErrorReporter.h"
 #include "src/sksl/SkSLOperator.h"
 #include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/analysis/SkSLProgramUsage.h"
 #include "src/sksl/ir/SkSLBinaryExpression.h"
 #include "src/sksl/ir/SkSLBlock.h"
 #include "src/sksl/ir/SkSLExpression.h"
@@ -35,8 +36,10 @@
 #include "src/sksl/transform/SkSLProgramWriter.h"
 
 #include <algorithm>
+#include <climits>
 #include <cstddef>
 #include <forward_list>
+#include <utility>
 
 namespace SkSL {
 
@@ -361,4 +364,46 @@ std::unique_ptr<FunctionDefinition> FunctionDefinition::Make(const Context&,
     return std::make_unique<FunctionDefinition>(pos, &function, builtin, std::move(body));
 }
 
+struct FunctionDefinition::CachedAnalysis {
+    ProgramUsage fUsage;
+    Analysis::ReturnComplexity fReturnComplexity;
+    int fNodeCount;
+};
+
+FunctionDefinition::FunctionDefinition(Position pos,
+                                       const FunctionDeclaration* declaration,
+                                       bool builtin,
+                                       std::unique_ptr<Statement> body)
+        : INHERITED(pos, kIRNodeKind)
+        , fDeclaration(declaration)
+        , fBuiltin(builtin)
+        , fBody(std::move(body)) {}
+
+FunctionDefinition::~FunctionDefinition() = default;
+
+void FunctionDefinition::cacheAnalysis() {
+    SkASSERT(!fCachedAnalysis);
+
+    auto analysis = std::make_unique<CachedAnalysis>();
+    analysis->fUsage.add(*this);
+    analysis->fReturnComplexity = Analysis::GetReturnComplexity(*this);
+    analysis->fNodeCount = Analysis::NodeCountUpToLimit(*this, INT_MAX);
+    fCachedAnalysis = std::move(analysis);
+}
+
+const ProgramUsage& FunctionDefinition::cachedUsage() const {
+    SkASSERT(fCachedAnalysis);
+    return fCachedAnalysis->fUsage;
+}
+
+Analysis::ReturnComplexity FunctionDefinition::cachedReturnComplexity() const {
+    SkASSERT(fCachedAnalysis);
+    return fCachedAnalysis->fReturnComplexity;
+}
+
+int FunctionDefinition::cachedNodeCount() const {
+    SkASSERT(fCachedAnalysis);
+    return fCachedAnalysis->fNodeCount;
+}
+
 }  // namespace SkSL
@@ -16,11 +16,15 @@
 
 #include <memory>
 #include <string>
-#include <utility>
 
 namespace SkSL {
 
 class Context;
+class ProgramUsage;
+
+namespace Analysis {
+enum class ReturnComplexity;
+}
 
 /**
  * A function definition (a declaration plus an associated block of code).
@@ -32,11 +36,9 @@ public:
     FunctionDefinition(Position pos,
                        const FunctionDeclaration* declaration,
                        bool builtin,
-                       std::unique_ptr<Statement> body)
-            : INHERITED(pos, kIRNodeKind)
-            , fDeclaration(declaration)
-            , fBuiltin(builtin)
-            , fBody(std::move(body)) {}
+                       std::unique_ptr<Statement> body);
+
+    ~FunctionDefinition() override;
 
     /**
      * Coerces `return` statements to the return type of the function, and reports errors in the
@@ -83,10 +85,30 @@ public:
         return this->declaration().description() + " " + this->body()->description();
     }
 
+    /**
+     * Module functions never change once their module is loaded, but every program that calls one
+     * needs to analyze it again. This computes the per-function results that don't depend on the
+     * calling program once, so they can be shared by every compilation. It must only be called
+     * once the function body is final; ProgramUsage, GetReturnComplexity and NodeCountUpToLimit
+     * return the cached results from then on.
+     */
+    void cacheAnalysis();
+
+    bool hasCachedAnalysis() const {
+        return fCachedAnalysis != nullptr;
+    }
+
+    // These may only be called if hasCachedAnalysis() is true.
+    const ProgramUsage& cachedUsage() const;
+    Analysis::ReturnComplexity cachedReturnComplexity() const;
+    int cachedNodeCount() const;
+
 private:
     const FunctionDeclaration* fDeclaration;
     bool fBuiltin;
     std::unique_ptr<Statement> fBody;
+    struct CachedAnalysis;
+    std::unique_ptr<CachedAnalysis> fCachedAnalysis;
 
     using INHERITED = ProgramElement;
 };
@@ -17,8 +17,11 @@
 #include "include/utils/SkParse.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkUTF.h"
+#include "src/base/SkVx.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
@@ -303,6 +306,37 @@ static inline const char* skip_ws(const char* p) {
     return p;
 }
 
+// Long strings (e.g. embedded base64 images) can dominate large inputs: past a short scalar
+// prefix, these are scanned 16 bytes at a time for terminator chars.
+//
+// Blocks are only loaded when entirely before p_stop (the last input char).  The scalar loops
+// rely on *p_stop being a terminator.
+//
+// Whitespace runs stay scalar: indentation is rarely long enough to pay for the block tests.
+
+static inline bool has_eostring(const skvx::byte16& c) {
+    return any((c < 0x20) | (c == '"') | (c == '\\') | (c == '}') | (c == ']'));
+}
+
+// Out of line, to keep the parser's hot loop tight.
+static SK_NEVER_INLINE const char* skip_long_string_chars(const char* p, const char* p_stop) {
+    while (p_stop - p >= 16 && !has_eostring(skvx::byte16::Load(p))) {
+        p += 16;
+    }
+
+    while (!is_eostring(*p)) ++p;
+    return p;
+}
+
+static inline const char* skip_string_chars(const char* p, const char* p_stop) {
+    // Most strings (in particular object keys) are short.
+    for (int i = 0; i < 16; ++i, ++p) {
+        if (is_eostring(*p)) return p;
+    }
+
+    return skip_long_string_chars(p, p_stop);
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -730,7 +764,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            p = skip_string_chars(p + 1, p_stop);
 
             if (*p == '"') {
                 // Valid string found.
@@ -812,6 +846,55 @@ private:
                            : nullptr;
     }
 
+    // Exponent notation (common in exported animations, e.g. "1.5e-05"), for mantissas which
+    // fit in 32 bits.  This avoids the strtof fallback in most cases.
+    const char* matchFastExponent(const char* p, int sign, int32_t mantissa, int exp) {
+        SkASSERT(*p == 'e' || *p == 'E');
+        SkASSERT(mantissa >= 0 && exp <= 0);
+
+        ++p;
+        int exp_sign = 1;
+        if (*p == '-') {
+            exp_sign = -1;
+            ++p;
+        } else if (*p == '+') {
+            ++p;
+        }
+
+        if (!is_digit(*p)) {
+            return nullptr;
+        }
+
+        int32_t e = 0;
+        do {
+            // Saturate: anything this large is out of the fast path range anyway.
+            e = std::min(e * 10 + (*p++ - '0'), 1000);
+        } while (is_digit(*p));
+
+        if (is_numeric(*p)) {
+            return nullptr;
+        }
+
+        // Clinger's fast path: the mantissa (< 2^31) and 10^0..10^22 are exact doubles, so a
+        // single multiplication or division produces the correctly rounded double.
+        static constexpr double g_pow10_table[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+        };
+        static constexpr int32_t k_max_exp = std::size(g_pow10_table) - 1;
+
+        exp += exp_sign * e;
+        if (exp < -k_max_exp || exp > k_max_exp) {
+            return nullptr;
+        }
+
+        const double d = exp < 0 ? mantissa / g_pow10_table[-exp]
+                                 : mantissa * g_pow10_table[ exp];
+        this->pushFloat(static_cast<float>(sign * d));
+
+        return p;
+    }
+
     const char* matchFast32OrFloat(const char* p) {
         int sign = 1;
         if (*p == '-') {
@@ -844,6 +927,10 @@ private:
             return nullptr;
         }
 
+        if ((*p == 'e' || *p == 'E') && p > digits_start) {
+            return this->matchFastExponent(p, sign, n32, 0);
+        }
+
         if (*p == '.') {
             const auto* decimals_start = ++p;
 
@@ -865,6 +952,10 @@ private:
                 return nullptr;
             }
 
+            if ((*p == 'e' || *p == 'E') && p > decimals_start) {
+                return this->matchFastExponent(p, sign, n32, exp);
+            }
+
             if (n32 > kMaxInt32) {
                 // we ran out on n32 bits
                 return this->matchFastFloatDecimalPart(p, sign, n32, exp);
@@ -933,6 +1024,239 @@ void Write(const Value& v, SkWStream* stream) {
     }
 }
 
+// Binary images hold a DOM in its in-memory layout: a header with the root value, followed by
+// the vector slabs (see MakeVector above) in breadth-first order, each aligned to kRecAlign.
+// Pointers are stored as offsets from the start of the image, so loading one is a copy and a
+// single pass turning them back into pointers. Images depend on the platform's pointer size.
+struct BinaryHeader {
+    char     fMagic[4];
+    uint32_t fVersion;
+    uint32_t fPointerSize;
+    uint32_t fReserved;
+    uint64_t fImageSize;
+    Value    fRoot;
+};
+
+static constexpr char     kBinaryMagic[4] = { '\x89', 'S', 'K', 'J' };
+static constexpr uint32_t kBinaryVersion  = 1;
+
+static size_t align_rec(size_t offset) {
+    return (offset + kRecAlign - 1) & ~(kRecAlign - 1);
+}
+
+// Access to the tags and pointers of the values in an image.
+class BinaryValue final : public Value {
+public:
+    static BinaryValue* Cast(Value* v) { return static_cast<BinaryValue*>(v); }
+
+    // Values whose payload lives in a slab.
+    bool hasSlab() const {
+        return this->getTag() == Tag::kString ||
+               this->getTag() == Tag::kArray  ||
+               this->getTag() == Tag::kObject;
+    }
+
+    bool isString() const {
+        return this->getTag() == Tag::kShortString || this->getTag() == Tag::kString;
+    }
+
+    // Whether every byte of an inline value is what its constructor would have written: unused
+    // bytes are zero, bools are 0 or 1, and short strings are \0-terminated and zero-padded.
+    bool isCanonicalInline() const {
+        uint64_t bits;
+        memcpy(&bits, this, sizeof(bits));
+        const uint64_t tag = SkToU8(this->getTag());
+        switch (this->getTag()) {
+            case Tag::kNull:
+                return bits == tag;
+            case Tag::kBool:
+                return bits == tag || bits == (tag | 0x100);
+            case Tag::kInt:
+            case Tag::kFloat:
+                // The payload is the upper word.
+                return (bits & 0xffffffff) == tag;
+            case Tag::kShortString: {
+                // The whole tag byte and the last byte are zero, and so is everything after the
+                // first \0.
+                if ((bits & 0xff) || (bits >> 56)) {
+                    return false;
+                }
+                uint64_t chars = bits >> 8;
+                while (chars & 0xff) {
+                    chars >>= 8;
+                }
+                return chars == 0;
+            }
+            default:
+                return true;
+        }
+    }
+
+    // The size of the records in the slab, and of what follows them.
+    size_t recSize() const {
+        switch (this->getTag()) {
+            case Tag::kString: return sizeof(char);
+            case Tag::kArray:  return sizeof(Value);
+            case Tag::kObject: return sizeof(Member);
+            default: SkUNREACHABLE;
+        }
+    }
+    size_t extraSize() const { return this->getTag() == Tag::kString ? 1 : 0; }
+    // Strings short enough to be stored inline never get a slab.
+    size_t minRecCount() const { return this->getTag() == Tag::kString ? sizeof(Value) - 1 : 0; }
+
+    // The child values in the slab.
+    size_t childCount() const {
+        switch (this->getTag()) {
+            case Tag::kArray:  return *this->ptr<size_t>();
+            case Tag::kObject: return *this->ptr<size_t>() * 2;
+            default:           return 0;
+        }
+    }
+    Value* child(size_t i) const {
+        return const_cast<Value*>(reinterpret_cast<const Value*>(this->ptr<size_t>() + 1) + i);
+    }
+
+    const void* slab() const { return this->ptr<void>(); }
+    uintptr_t offset() const { return reinterpret_cast<uintptr_t>(this->ptr<void>()); }
+
+    void setSlab(const void* slab) {
+        this->init_tagged_pointer(this->getTag(), const_cast<void*>(slab));
+    }
+    void setOffset(size_t offset) {
+        this->init_tagged_pointer(this->getTag(), reinterpret_cast<void*>(offset));
+    }
+
+    // Whether this is exactly the value setOffset(offset) writes.
+    bool isCanonicalOffset(size_t offset) const {
+        BinaryValue canonical = *this;
+        canonical.setOffset(offset);
+        return !memcmp(this, &canonical, sizeof(Value));
+    }
+};
+
+void WriteBinary(const Value& root, SkWStream* stream) {
+    std::vector<char> image(sizeof(BinaryHeader));
+
+    // Values whose slabs are still to be copied, by their offset in the image.
+    std::vector<size_t> pending = { offsetof(BinaryHeader, fRoot) };
+    memcpy(image.data() + pending.front(), &root, sizeof(Value));
+    for (size_t i = 0; i < pending.size(); ++i) {
+        Value v;
+        memcpy(&v, image.data() + pending[i], sizeof(Value));
+        BinaryValue* bv = BinaryValue::Cast(&v);
+        if (!bv->hasSlab()) {
+            continue;
+        }
+
+        const size_t recCount = *static_cast<const size_t*>(bv->slab()),
+                     slabSize = sizeof(size_t) + recCount * bv->recSize() + bv->extraSize(),
+                     offset   = align_rec(image.size());
+        image.resize(align_rec(offset + slabSize));
+        memcpy(image.data() + offset, bv->slab(), slabSize);
+
+        const size_t childCount = bv->childCount();
+        bv->setOffset(offset);
+        memcpy(image.data() + pending[i], &v, sizeof(Value));
+        for (size_t c = 0; c < childCount; ++c) {
+            pending.push_back(offset + sizeof(size_t) + c * sizeof(Value));
+        }
+    }
+
+    BinaryHeader header;
+    memcpy(header.fMagic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.fVersion     = kBinaryVersion;
+    header.fPointerSize = sizeof(void*);
+    header.fReserved    = 0;
+    header.fImageSize   = image.size();
+    memcpy(&header.fRoot, image.data() + offsetof(BinaryHeader, fRoot), sizeof(Value));
+    memcpy(image.data(), &header, sizeof(header));
+
+    stream->write(image.data(), image.size());
+}
+
+Value LoadBinary(const char* data, size_t size, SkArenaAlloc& alloc) {
+    BinaryHeader header;
+    if (size < sizeof(header)) {
+        return NullValue();
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.fMagic, kBinaryMagic, sizeof(kBinaryMagic)) ||
+        header.fVersion != kBinaryVersion ||
+        header.fPointerSize != sizeof(void*) ||
+        header.fReserved != 0 ||
+        header.fImageSize != size) {
+        return NullValue();
+    }
+
+    char* image = static_cast<char*>(alloc.makeBytesAlignedTo(size, kRecAlign));
+    memcpy(image, data, size);
+
+    // The slabs must be exactly where WriteBinary() put them, which also rules out overlaps and
+    // cycles in corrupt images. Every other byte is checked as well: the image must be exactly what
+    // WriteBinary() would write for the DOM it loads as.
+    Value root = header.fRoot;
+    std::vector<Value*> pending = { &root };
+    size_t expectedOffset = sizeof(BinaryHeader);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        BinaryValue* bv = BinaryValue::Cast(pending[i]);
+        if (!bv->isCanonicalInline()) {
+            return NullValue();
+        }
+        if (!bv->hasSlab()) {
+            continue;
+        }
+
+        const size_t offset = bv->offset();
+        if (offset != expectedOffset || !bv->isCanonicalOffset(offset) ||
+            size - offset < sizeof(size_t)) {
+            return NullValue();
+        }
+        size_t recCount;
+        memcpy(&recCount, image + offset, sizeof(size_t));
+        const size_t available = size - offset - sizeof(size_t) - bv->extraSize();
+        if (size - offset - sizeof(size_t) < bv->extraSize() ||
+            recCount > available / bv->recSize()) {
+            return NullValue();
+        }
+        const size_t slabSize = sizeof(size_t) + recCount * bv->recSize() + bv->extraSize();
+        if (bv->extraSize() && image[offset + slabSize - 1] != '\0') {
+            return NullValue();
+        }
+        if (recCount < bv->minRecCount()) {
+            return NullValue();
+        }
+
+        bv->setSlab(image + offset);
+        expectedOffset = align_rec(offset + slabSize);
+        if (expectedOffset > size) {
+            return NullValue();
+        }
+        // The alignment padding is zero.
+        for (size_t p = offset + slabSize; p < expectedOffset; ++p) {
+            if (image[p]) {
+                return NullValue();
+            }
+        }
+
+        const size_t childCount = bv->childCount();
+        for (size_t c = 0; c < childCount; ++c) {
+            Value* child = bv->child(c);
+            // Object keys are every other child, and must be strings.
+            if (bv->getType() == Value::Type::kObject && !(c & 1) &&
+                !BinaryValue::Cast(child)->isString()) {
+                return NullValue();
+            }
+            pending.push_back(child);
+        }
+    }
+    if (expectedOffset != size) {
+        return NullValue();
+    }
+
+    return root;
+}
+
 } // namespace
 
 SkString Value::toString() const {
@@ -945,8 +1269,13 @@ SkString Value::toString() const {
 
 static constexpr size_t kMinChunkSize = 4096;
 
-DOM::DOM(const char* data, size_t size)
+DOM::DOM(const char* data, size_t size, Format format)
     : fAlloc(kMinChunkSize) {
+    if (format == Format::kBinary) {
+        fRoot = LoadBinary(data, size, fAlloc);
+        return;
+    }
+
     DOMParser parser(fAlloc);
 
     fRoot = parser.parse(data, size);
@@ -956,4 +1285,8 @@ void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+void DOM::writeBinary(SkWStream* stream) const {
+    WriteBinary(fRoot, stream);
+}
+
 } // namespace skjson
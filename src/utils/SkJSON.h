@@ -357,12 +357,24 @@ private:
 
 class DOM final : public SkNoncopyable {
 public:
-    DOM(const char*, size_t);
+    enum class Format {
+        kJSON,
+        kBinary,  // as produced by writeBinary()
+    };
+
+    DOM(const char*, size_t, Format = Format::kJSON);
 
     const Value& root() const { return fRoot; }
 
     void write(SkWStream*) const;
 
+    /**
+     * Writes the DOM as a binary image, which can be loaded without parsing (Format::kBinary).
+     * Images are only readable on platforms with the same pointer size; anything else (or a
+     * corrupt image) loads as a NullValue root.
+     */
+    void writeBinary(SkWStream*) const;
+
 private:
     SkArenaAlloc fAlloc;
     Value        fRoot;
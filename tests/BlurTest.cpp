@@ -12,6 +12,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
@@ -25,17 +26,23 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTemplates.h"
 #include "src/base/SkFloatBits.h"
 #include "src/base/SkMathPriv.h"
+#include "src/core/SkBlurEngine.h"
 #include "src/core/SkBlurMask.h"
 #include "src/core/SkMask.h"
+#include "src/core/SkMaskBlurFilter.h"
 #include "src/core/SkMaskFilterBase.h"
+#include "src/core/SkSpecialImage.h"
 #include "src/effects/SkEmbossMaskFilter.h"
 #include "src/gpu/ganesh/GrBlurUtils.h"
 #include "tests/CtsEnforcement.h"
@@ -44,10 +51,13 @@
 
 #include <math.h>
 #include <string.h>
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
 
 struct GrContextOptions;
 
@@ -586,3 +596,153 @@ DEF_TEST(zero_blur, reporter) {
     SkIPoint offset;
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
+
+// SkMaskBlurFilter hands groups of A8 lines to SkOpts::box_blur_lines, and the rest to its scalar
+// scan. Both must agree exactly.
+DEF_TEST(MaskBlurFilter_BoxBlurLines, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    auto blur = [](const SkMask& src, double sigma, bool useLines, SkExecutor* bands) {
+        SkMaskBuilder dst;
+        const SkMaskBlurFilter filter(sigma, sigma, bands);
+        if (useLines) {
+            filter.blur(src, &dst);
+        } else {
+            filter.blurWithoutLineKernelForTesting(src, &dst);
+        }
+        return dst;
+    };
+
+    // Odd sizes leave lines for the scalar tail; given an executor, the larger one is split into
+    // parallel bands.
+    for (SkISize size : {SkISize{67, 45}, SkISize{301, 299}}) {
+        const size_t rowBytes = size.width() + 3;
+        skia_private::AutoTMalloc<uint8_t> pixels(rowBytes * size.height());
+        for (size_t i = 0; i < rowBytes * size.height(); ++i) {
+            pixels[i] = (i * 7919) % 5 ? (i * 31) & 0xff : 0;
+        }
+        const SkMask src(pixels.get(), SkIRect::MakeSize(size), rowBytes, SkMask::kA8_Format);
+
+        for (double sigma : {2.5, 10.0, 40.0}) {
+            SkMaskBuilder expected = blur(src, sigma, false, nullptr);
+            SkAutoMaskFreeImage freeExpected(expected.image());
+            for (SkExecutor* bands : {(SkExecutor*)nullptr, executor.get()}) {
+                SkMaskBuilder actual = blur(src, sigma, true, bands);
+                SkAutoMaskFreeImage freeActual(actual.image());
+
+                REPORTER_ASSERT(reporter, expected.fBounds == actual.fBounds);
+                REPORTER_ASSERT(reporter, !memcmp(expected.fImage, actual.fImage,
+                                                  expected.computeImageSize()));
+            }
+        }
+    }
+}
+
+DEF_TEST(RasterBlurEngine, reporter) {
+    const SkBlurEngine* engine = SkBlurEngine::GetRasterBlurEngine();
+    std::unique_ptr<SkBlurEngine> exact = SkBlurEngine::MakeRasterBlurEngine(0.f);
+
+    REPORTER_ASSERT(reporter, !engine->findAlgorithm({20.f, 20.f}, kAlpha_8_SkColorType));
+
+    // Sigmas within the box blur's reach keep using it; larger ones go up to SkBlurImageFilter's
+    // limit, and past that the caller has to downscale.
+    const SkBlurEngine::Algorithm* box = engine->findAlgorithm({20.f, 20.f}, kN32_SkColorType);
+    const SkBlurEngine::Algorithm* big = engine->findAlgorithm({200.f, 20.f}, kN32_SkColorType);
+    REPORTER_ASSERT(reporter, box && box->maxSigma() >= 20.f && box->maxSigma() < 200.f);
+    REPORTER_ASSERT(reporter, big && big->maxSigma() == 532.f && big->supportsOnlyDecalTiling());
+    for (const SkBlurEngine* e : {engine, (const SkBlurEngine*)exact.get()}) {
+        const SkBlurEngine::Algorithm* huge = e->findAlgorithm({1e9f, SK_FloatInfinity},
+                                                               kN32_SkColorType);
+        REPORTER_ASSERT(reporter, huge && huge->maxSigma() == 532.f);
+    }
+
+    // The box blur covers every sigma whose window stays under 255, up to about 135.38.
+    const SkBlurEngine::Algorithm* edge = engine->findAlgorithm({135.2f, 135.2f}, kN32_SkColorType);
+    REPORTER_ASSERT(reporter, edge == box && edge->maxSigma() >= 135.2f);
+
+    // An opaque square, whose blur is the product of two differences of the normal CDF.
+    static constexpr int kSize = 128;
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(kSize, kSize);
+    bitmap.eraseColor(SK_ColorWHITE);
+    sk_sp<SkSpecialImage> src = SkSpecialImages::MakeFromRaster(
+            SkIRect::MakeSize(bitmap.dimensions()), bitmap, SkSurfaceProps());
+
+    auto expected = [](int x, int y, float sigma) {
+        auto coverage = [&](int p) {
+            auto cdf = [&](double t) { return 0.5 * std::erfc(-t / (sigma * std::sqrt(2.0))); };
+            return cdf(kSize - (p + 0.5)) - cdf(-(p + 0.5));
+        };
+        return 255 * coverage(x) * coverage(y);
+    };
+
+    // The box blur is a little off a Gaussian, and the pyramid's resampling stays close to it; the
+    // recursive filter is closer.
+    const struct {
+        const SkBlurEngine* engine;
+        float sigma;
+        float tolerance;
+    } kCases[] = {
+        {engine,      135.2f, 2.5f},
+        {engine,      200.f, 3.f},
+        {exact.get(), 200.f, 1.5f},
+        {exact.get(), 532.f, 1.5f},
+    };
+
+    // Straddles the square's left edge, far out into the blur.
+    const SkIRect dstRect = SkIRect::MakeLTRB(-250, -10, 150, 90);
+    for (const auto& c : kCases) {
+        const SkBlurEngine::Algorithm* algorithm =
+                c.engine->findAlgorithm({c.sigma, c.sigma}, kN32_SkColorType);
+        REPORTER_ASSERT(reporter, algorithm && algorithm->maxSigma() >= c.sigma);
+        if (!algorithm) {
+            continue;
+        }
+
+        sk_sp<SkSpecialImage> dst = algorithm->blur({c.sigma, c.sigma}, src,
+                                                    SkIRect::MakeSize(bitmap.dimensions()),
+                                                    SkTileMode::kDecal, dstRect);
+        SkBitmap result;
+        if (!dst || !SkSpecialImages::AsBitmap(dst.get(), &result)) {
+            ERRORF(reporter, "sigma %g: blur failed", c.sigma);
+            continue;
+        }
+        REPORTER_ASSERT(reporter, result.dimensions() == dstRect.size());
+
+        float maxError = 0;
+        for (int y = 0; y < result.height(); ++y) {
+            for (int x = 0; x < result.width(); ++x) {
+                const SkPMColor color = *result.getAddr32(x, y);
+                const double want = expected(x + dstRect.left(), y + dstRect.top(), c.sigma);
+                maxError = std::max(maxError, (float)std::abs(SkGetPackedA32(color) - want));
+                // Premultiplied white stays gray.
+                REPORTER_ASSERT(reporter, SkGetPackedR32(color) == SkGetPackedA32(color));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxError <= c.tolerance,
+                        "sigma %g: max error %g", c.sigma, maxError);
+    }
+
+    // Given an executor, bands of rows and columns run on it, with the same results.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    std::unique_ptr<SkBlurEngine> threaded = SkBlurEngine::MakeRasterBlurEngine(0.5f,
+                                                                                executor.get());
+    for (float sigma : {20.f, 200.f, 532.f}) {
+        auto blur = [&](const SkBlurEngine* e) {
+            SkBitmap result;
+            sk_sp<SkSpecialImage> dst =
+                    e->findAlgorithm({sigma, sigma}, kN32_SkColorType)
+                     ->blur({sigma, sigma}, src, SkIRect::MakeSize(bitmap.dimensions()),
+                            SkTileMode::kDecal, dstRect);
+            SkAssertResult(dst && SkSpecialImages::AsBitmap(dst.get(), &result));
+            return result;
+        };
+        const SkBitmap serial = blur(engine),
+                       banded = blur(threaded.get());
+        bool same = serial.dimensions() == banded.dimensions();
+        for (int y = 0; same && y < serial.height(); ++y) {
+            same = !memcmp(serial.getAddr32(0, y), banded.getAddr32(0, y),
+                           serial.width() * sizeof(uint32_t));
+        }
+        REPORTER_ASSERT(reporter, same, "sigma %g", sigma);
+    }
+}
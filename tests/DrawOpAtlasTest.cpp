@@ -83,14 +83,18 @@ public:
     }
 
     skgpu::AtlasToken addASAPUpload(GrDeferredTextureUploadFn&& upload) final {
+        ++fNumASAPUploads;
         return fTokenTracker.nextFlushToken();
     }
 
     void issueDrawToken() { fTokenTracker.issueDrawToken(); }
     void issueFlushToken() { fTokenTracker.issueFlushToken(); }
 
+    int numASAPUploads() const { return fNumASAPUploads; }
+
 private:
     skgpu::TokenTracker fTokenTracker;
+    int fNumASAPUploads = 0;
 
     using INHERITED = GrDeferredUploadTarget;
 };
@@ -177,6 +181,116 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas,
     check(reporter, atlas.get(), 1, 4, 1);
 }
 
+class CountingEvictor : public skgpu::PlotEvictionCallback {
+public:
+    void evict(skgpu::PlotLocator) override { ++fNumEvictions; }
+
+    int fNumEvictions = 0;
+};
+
+// The top-left corner of a plot in its page. This mirrors the layout set up by
+// GrDrawOpAtlas::createPages(), where plot 0 is in the bottom-right corner.
+static SkIPoint plot_origin(uint32_t plotIndex) {
+    return {(kNumPlots - 1 - (int)plotIndex % kNumPlots) * kPlotSize,
+            (kNumPlots - 1 - (int)plotIndex / kNumPlots) * kPlotSize};
+}
+
+// This verifies that with CompactionMode::kRelocate, compacting the last page copies its
+// recently used plot to an earlier page, and that lookup() redirects locators that still refer
+// to the old plot, offsetting their rects and scheduling an upload of the new plot.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(RelocatingDrawOpAtlas,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto context = ctxInfo.directContext();
+    auto proxyProvider = context->priv().proxyProvider();
+    auto resourceProvider = context->priv().resourceProvider();
+    auto drawingManager = context->priv().drawingManager();
+    const GrCaps* caps = context->priv().caps();
+
+    GrOnFlushResourceProvider onFlushResourceProvider(drawingManager);
+    TestingUploadTarget uploadTarget;
+
+    GrColorType atlasColorType = GrColorType::kAlpha_8;
+    GrBackendFormat format = caps->getDefaultBackendFormat(atlasColorType,
+                                                           GrRenderable::kNo);
+
+    CountingEvictor evictor;
+    skgpu::AtlasGenerationCounter counter;
+
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+                                                proxyProvider,
+                                                format,
+                                                GrColorTypeToSkColorType(atlasColorType),
+                                                GrColorTypeBytesPerPixel(atlasColorType),
+                                                kAtlasSize, kAtlasSize,
+                                                kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
+                                                &counter,
+                                                GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                                &evictor,
+                                                /*label=*/"RelocatingDrawOpAtlasTest",
+                                                GrDrawOpAtlas::CompactionMode::kRelocate);
+    check(reporter, atlas.get(), 0, 4, 0);
+
+    // Fill up the first page and force allocation of a second one
+    skgpu::AtlasLocator atlasLocators[kNumPlots * kNumPlots];
+    for (int i = 0; i < kNumPlots * kNumPlots; ++i) {
+        bool result = fill_plot(
+                atlas.get(), resourceProvider, &uploadTarget, &atlasLocators[i], i * 32);
+        REPORTER_ASSERT(reporter, result);
+    }
+
+    atlas->instantiate(&onFlushResourceProvider);
+
+    skgpu::AtlasLocator lastPageLocator;
+    bool result = fill_plot(
+            atlas.get(), resourceProvider, &uploadTarget, &lastPageLocator, 4 * 32);
+    REPORTER_ASSERT(reporter, result);
+    check(reporter, atlas.get(), 2, 4, 2);
+    REPORTER_ASSERT(reporter, lastPageLocator.pageIndex() == 1);
+    const skgpu::AtlasLocator staleLocator = lastPageLocator;
+
+    // Keep using only the plot in the last page until the first page's plots have aged out and
+    // compaction moves it to one of them.
+    for (int i = 0; i < 512 && atlas->stats().fRelocatedPlots == 0; ++i) {
+        atlas->setLastUseToken(lastPageLocator, uploadTarget.tokenTracker()->nextDrawToken());
+        uploadTarget.issueDrawToken();
+        uploadTarget.issueFlushToken();
+        atlas->compact(uploadTarget.tokenTracker()->nextFlushToken());
+    }
+    REPORTER_ASSERT(reporter, atlas->stats().fRelocatedPlots == 1);
+    check(reporter, atlas.get(), 1, 4, 1);
+    // Both the aged out destination plot and the relocated source plot notify the evictor.
+    REPORTER_ASSERT(reporter, evictor.fNumEvictions == 2);
+    REPORTER_ASSERT(reporter, !atlas->hasID(staleLocator.plotLocator()));
+
+    // The stale locator is redirected to the new plot at the same offset within it.
+    int numUploads = uploadTarget.numASAPUploads();
+    REPORTER_ASSERT(reporter, atlas->lookup(&uploadTarget, &lastPageLocator));
+    REPORTER_ASSERT(reporter, atlas->hasID(lastPageLocator.plotLocator()));
+    REPORTER_ASSERT(reporter, lastPageLocator.pageIndex() == 0);
+    REPORTER_ASSERT(reporter, lastPageLocator.width() == staleLocator.width());
+    REPORTER_ASSERT(reporter, lastPageLocator.topLeft() - plot_origin(lastPageLocator.plotIndex())
+                              == staleLocator.topLeft() - plot_origin(staleLocator.plotIndex()));
+    REPORTER_ASSERT(reporter, atlas->stats().fRelocatedHits == 1);
+
+    // The copied plot is uploaded the first time it is looked up
+    REPORTER_ASSERT(reporter, uploadTarget.numASAPUploads() == numUploads + 1);
+
+    // Another lookup of the old plot locator resolves to the same place and shares that upload
+    skgpu::AtlasLocator otherLocator = staleLocator;
+    REPORTER_ASSERT(reporter, atlas->lookup(&uploadTarget, &otherLocator));
+    REPORTER_ASSERT(reporter, otherLocator.plotLocator() == lastPageLocator.plotLocator());
+    REPORTER_ASSERT(reporter, otherLocator.topLeft() == lastPageLocator.topLeft());
+    REPORTER_ASSERT(reporter, uploadTarget.numASAPUploads() == numUploads + 1);
+    REPORTER_ASSERT(reporter, atlas->stats().fRelocatedHits == 2);
+
+    // Up-to-date locators are plain hits
+    REPORTER_ASSERT(reporter, atlas->lookup(&uploadTarget, &lastPageLocator));
+    REPORTER_ASSERT(reporter, atlas->stats().fRelocatedHits == 2);
+    REPORTER_ASSERT(reporter, atlas->stats().fMisses == 0);
+}
+
 // This test verifies that the AtlasTextOp::onPrepare method correctly handles a failure
 // when allocating an atlas page.
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrAtlasTextOpPreparation,
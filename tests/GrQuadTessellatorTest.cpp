@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/base/SkRandom.h"
+#include "src/gpu/ganesh/geometry/GrQuad.h"
+#include "src/gpu/ganesh/geometry/GrQuadUtils.h"
+#include "src/gpu/ganesh/ops/QuadPerEdgeAA.h"
+#include "tests/Test.h"
+
+#include <vector>
+
+using namespace skgpu::ganesh::QuadPerEdgeAA;
+
+// Matches the vertex layout written for the spec below: device xy, coverage, local uv
+struct CovUVVertex {
+    float fX, fY, fCoverage, fU, fV;
+};
+
+static void expected_vertices(const GrQuad& device, const GrQuad& local, CovUVVertex out[8]) {
+    GrQuadUtils::TessellationHelper helper;
+    GrQuad devInset = device, localInset = local;
+    GrQuad devOutset = device, localOutset = local;
+    helper.reset(device, &local);
+    float coverage[4];
+    helper.inset(0.5f, &devInset, &localInset).store(coverage);
+    helper.outset(0.5f, &devOutset, &localOutset);
+    for (int i = 0; i < 4; ++i) {
+        out[i] = {devInset.x(i), devInset.y(i), coverage[i], localInset.x(i), localInset.y(i)};
+        out[4 + i] = {devOutset.x(i), devOutset.y(i), 0.f, localOutset.x(i), localOutset.y(i)};
+    }
+}
+
+// Axis-aligned, fully anti-aliased quads are tessellated in batches; their vertices must match
+// what the general TessellationHelper path computes, including partial batches and quads that are
+// too thin to inset and fall back to the general path in the middle of a batch.
+DEF_TEST(GrQuadTessellatorBatch, r) {
+    VertexSpec spec(GrQuad::Type::kAxisAligned, ColorType::kNone,
+                    GrQuad::Type::kRectilinear, /* hasLocalCoords= */ true, Subset::kNo,
+                    GrAAType::kCoverage, /* coverageAsAlpha= */ false,
+                    IndexBufferOption::kPictureFramed);
+    REPORTER_ASSERT(r, spec.vertexSize() == sizeof(CovUVVertex));
+
+    SkRandom rand;
+    for (int count : {1, 3, 4, 7, 13}) {
+        std::vector<GrQuad> devices, locals;
+        for (int i = 0; i < count; ++i) {
+            // Every third quad is subpixel in one dimension
+            float w = i % 3 == 2 ? rand.nextRangeF(0.1f, 0.9f) : rand.nextRangeF(2.f, 50.f);
+            float h = rand.nextRangeF(2.f, 50.f);
+            SkRect rect = SkRect::MakeXYWH(rand.nextRangeF(-20.f, 20.f),
+                                           rand.nextRangeF(-20.f, 20.f), w, h);
+            // Alternate between flipped/rotated corner orders and rotated local coordinates
+            SkMatrix viewMatrix = i % 2 ? SkMatrix::RotateDeg(90) : SkMatrix::Scale(-1.f, 1.f);
+            SkMatrix localMatrix = SkMatrix::RotateDeg(rand.nextRangeF(0.f, 360.f));
+            devices.push_back(GrQuad::MakeFromRect(rect, viewMatrix));
+            locals.push_back(GrQuad::MakeFromRect(SkRect::MakeWH(1.f, 1.f), localMatrix));
+            REPORTER_ASSERT(r, devices.back().quadType() == GrQuad::Type::kAxisAligned);
+        }
+
+        std::vector<CovUVVertex> vertices(count * spec.verticesPerQuad());
+        {
+            Tessellator tessellator(spec, reinterpret_cast<char*>(vertices.data()));
+            for (int i = 0; i < count; ++i) {
+                GrQuad device = devices[i], local = locals[i];
+                tessellator.append(&device, &local, SK_PMColor4fWHITE, SkRect::MakeEmpty(),
+                                   GrQuadAAFlags::kAll);
+            }
+            tessellator.flush();
+        }
+
+        for (int i = 0; i < count; ++i) {
+            CovUVVertex expected[8];
+            expected_vertices(devices[i], locals[i], expected);
+            for (int v = 0; v < 8; ++v) {
+                const CovUVVertex& a = vertices[8 * i + v];
+                const CovUVVertex& e = expected[v];
+                REPORTER_ASSERT(r, SkScalarNearlyEqual(a.fX, e.fX, 1e-4f) &&
+                                   SkScalarNearlyEqual(a.fY, e.fY, 1e-4f) &&
+                                   SkScalarNearlyEqual(a.fCoverage, e.fCoverage, 1e-4f) &&
+                                   SkScalarNearlyEqual(a.fU, e.fU, 1e-4f) &&
+                                   SkScalarNearlyEqual(a.fV, e.fV, 1e-4f),
+                                "count %d quad %d vertex %d: (%f %f %f %f %f) vs (%f %f %f %f %f)",
+                                count, i, v, a.fX, a.fY, a.fCoverage, a.fU, a.fV,
+                                e.fX, e.fY, e.fCoverage, e.fU, e.fV);
+            }
+        }
+    }
+}
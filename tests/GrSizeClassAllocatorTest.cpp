@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/GrSizeClassAllocator.h"
+#include "tests/Test.h"
+
+#include <cstdint>
+#include <cstring>
+
+DEF_TEST(GrSizeClassAllocator, reporter) {
+    GrSizeClassAllocator::ReleaseThreadCache();
+    GrSizeClassAllocator::Stats start = GrSizeClassAllocator::GetStats();
+
+    // Allocations are aligned and usable for their full size, including ones that are too large
+    // to be recycled.
+    for (size_t size : {0, 1, 15, 16, 17, 100, 1024, 1025, 4000}) {
+        void* p = GrSizeClassAllocator::Allocate(size);
+        REPORTER_ASSERT(reporter, reinterpret_cast<uintptr_t>(p) %
+                                          GrSizeClassAllocator::kAlignment == 0);
+        memset(p, 0xAB, size);
+        GrSizeClassAllocator::Release(p);
+    }
+
+    // Released memory is reused by the next allocation in the same size class, which rounds the
+    // size up to a multiple of kAlignment.
+    static constexpr size_t kSize = 33;
+    static constexpr size_t kRoundedSize = (kSize + GrSizeClassAllocator::kAlignment - 1) /
+                                           GrSizeClassAllocator::kAlignment *
+                                           GrSizeClassAllocator::kAlignment;
+    static_assert(kRoundedSize > kSize);
+    void* a = GrSizeClassAllocator::Allocate(kSize);
+    GrSizeClassAllocator::Release(a);
+    void* b = GrSizeClassAllocator::Allocate(kRoundedSize);
+    REPORTER_ASSERT(reporter, a == b);
+    GrSizeClassAllocator::Release(b);
+
+    // Other threads may be allocating too, so only check that our allocations were counted.
+    GrSizeClassAllocator::Stats stats = GrSizeClassAllocator::GetStats();
+    REPORTER_ASSERT(reporter, stats.fAllocations - start.fAllocations >= 11);
+    REPORTER_ASSERT(reporter, stats.fRecycledAllocations - start.fRecycledAllocations >= 1);
+
+    // Releasing more than the thread's cache can hold returns the excess to the system.
+    static constexpr int kCount = 2 * GrSizeClassAllocator::kMaxCachedBytesPerThread / 512;
+    void* ptrs[kCount];
+    for (void*& p : ptrs) {
+        p = GrSizeClassAllocator::Allocate(512);
+    }
+    for (void* p : ptrs) {
+        GrSizeClassAllocator::Release(p);
+    }
+    REPORTER_ASSERT(reporter, GrSizeClassAllocator::ThreadCachedBytes() > 0);
+    REPORTER_ASSERT(reporter, GrSizeClassAllocator::ThreadCachedBytes() <=
+                              GrSizeClassAllocator::kMaxCachedBytesPerThread);
+    GrSizeClassAllocator::ReleaseThreadCache();
+    REPORTER_ASSERT(reporter, GrSizeClassAllocator::ThreadCachedBytes() == 0);
+}
@@ -133,6 +133,22 @@ DEF_TEST(JSON_Parse, reporter) {
         {R"zzz(["foo\rbar"])zzz"    , "[\"foo\rbar\"]"},
         {R"zzz(["foo\tbar"])zzz"    , "[\"foo\tbar\"]"},
         {R"zzz(["foo\u1234bar"])zzz", "[\"foo\u1234bar\"]"},
+
+        // Strings long enough to be scanned in blocks, and long (scalar-scanned) whitespace runs.
+        { "[\"0123456789abcdef0123456789abcdef\"]", "[\"0123456789abcdef0123456789abcdef\"]" },
+        { "[\"0123456789abcdef0123456789abcde}]\"]",
+          "[\"0123456789abcdef0123456789abcde}]\"]" },
+        {R"zzz(["0123456789abcdef0123\"456789abcdef", "0123456789abcdef"])zzz",
+          "[\"0123456789abcdef0123\"456789abcdef\",\"0123456789abcdef\"]" },
+        { "[\"0123456789abcdef01\xc3\xa9" "456789abcdef\"]",
+          "[\"0123456789abcdef01\xc3\xa9" "456789abcdef\"]" },
+        { "[\"0123456789abcdef0123456789abcdef\"                                  ]",
+          "[\"0123456789abcdef0123456789abcdef\"]" },
+        { "{\n                                    \"k\" :\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t 1 }",
+          "{\"k\":1}" },
+        { "[\"0123456789abcdef0123456789abcdef]"                   , nullptr },
+        { "[\"0123456789abcdef0123456789abcdef]                  ]", nullptr },
+        { "[\"0123456789abcdef01\x01" "456789abcdef\"]"               , nullptr },
     };
 
     for (const auto& tst : g_tests) {
@@ -459,6 +475,15 @@ DEF_TEST(JSON_ParseNumber, reporter) {
 
         { "20.001111814444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444444473",
           20.001f, 0.001f },
+
+        { "1e5"     , 100000.f  , 0 },
+        { "1E+5"    , 100000.f  , 0 },
+        { "-2.5e3"  , -2500.f   , 0 },
+        { "1.5e-05" , 0.000015f , 0 },
+        { "12345e-3", 12.345f   , 0 },
+        { "0.125E-2", 0.00125f  , 0 },
+        { "3e-30"   , 3e-30f    , 0 },
+        { "1.25e020", 1.25e20f  , 0 },
     };
 
     for (const auto& test : gTests) {
@@ -535,3 +560,80 @@ DEF_TEST(JSON_Writable, r) {
     REPORTER_ASSERT(r, root.toString() ==
         SkString(R"({"null":42,"num":"foo","new":true,"newobj":{"newprop":-1}})"));
 }
+
+DEF_TEST(JSON_Binary, r) {
+    const char* json = R"({"null": null, "bool": true, "int": -5, "float": 1.5, "s": "short",)"
+                       R"( "long string": "this one needs its own slab",)"
+                       R"( "arr": [1, [], {}, "x", [false, {"k": [0.25]}]]})";
+    const DOM dom(json, strlen(json));
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+    const sk_sp<SkData> image = stream.detachAsData();
+    const char* bytes = static_cast<const char*>(image->data());
+
+    const DOM loaded(bytes, image->size(), DOM::Format::kBinary);
+    REPORTER_ASSERT(r, loaded.root().is<ObjectValue>());
+    REPORTER_ASSERT(r, loaded.root().toString() == dom.root().toString());
+    REPORTER_ASSERT(r, loaded.root()["long string"].as<StringValue>().str() ==
+                       "this one needs its own slab");
+    const ArrayValue& nested = loaded.root()["arr"].as<ArrayValue>()[4].as<ArrayValue>();
+    REPORTER_ASSERT(r, *nested[1]["k"].as<ArrayValue>()[0].as<NumberValue>() == 0.25);
+
+    // Truncated images don't load.
+    for (size_t size = 0; size < image->size(); ++size) {
+        const DOM truncated(bytes, size, DOM::Format::kBinary);
+        REPORTER_ASSERT(r, truncated.root().is<NullValue>());
+    }
+
+    // Neither do images pointing somewhere else than where the slabs are (on 64-bit platforms,
+    // the root object's tagged offset is the last word of the 32 byte header).
+    if (sizeof(void*) == 8) {
+        SkString corrupt(bytes, image->size());
+        uint64_t rootOffset;
+        memcpy(&rootOffset, corrupt.c_str() + 24, sizeof(rootOffset));
+        rootOffset += 8;
+        memcpy(corrupt.data() + 24, &rootOffset, sizeof(rootOffset));
+        const DOM corrupted(corrupt.c_str(), corrupt.size(), DOM::Format::kBinary);
+        REPORTER_ASSERT(r, corrupted.root().is<NullValue>());
+    }
+
+    // Nor do images with any byte other than what writeBinary() would have written. On 64-bit
+    // platforms, a single element array's slab is at 32, and its element at 40.
+    if (sizeof(void*) == 8) {
+        const struct {
+            const char* json;
+            size_t      index;
+            char        byte;
+        } kCorruptions[] = {
+            { "[true]",               12, 1    },  // reserved header field
+            { "[true]",               40, 0x0a },  // unused tag bits
+            { "[true]",               41, 2    },  // bools are 0 or 1
+            { "[true]",               43, 1    },  // unused payload byte
+            { "[null]",               47, 1    },
+            { "[7]",                  42, 1    },
+            { "[1.5]",                41, 1    },
+            { "[\"ab\"]",             44, 'c'  },  // past the short string's terminator
+            { "[\"abcdef\"]",         47, 'g'  },  // short strings end with a \0
+            { "[\"fourteen chars\"]", 71, 1    },  // alignment padding after the string slab
+        };
+        for (const auto& c : kCorruptions) {
+            const DOM source(c.json, strlen(c.json));
+            SkDynamicMemoryWStream cstream;
+            source.writeBinary(&cstream);
+            const sk_sp<SkData> cimage = cstream.detachAsData();
+            REPORTER_ASSERT(r, c.index < cimage->size());
+            if (c.index >= cimage->size()) {
+                continue;
+            }
+
+            SkString corrupt(static_cast<const char*>(cimage->data()), cimage->size());
+            const DOM intact(corrupt.c_str(), corrupt.size(), DOM::Format::kBinary);
+            REPORTER_ASSERT(r, intact.root().toString() == source.root().toString());
+
+            corrupt.data()[c.index] = c.byte;
+            const DOM corrupted(corrupt.c_str(), corrupt.size(), DOM::Format::kBinary);
+            REPORTER_ASSERT(r, corrupted.root().is<NullValue>(), "%s @%zu", c.json, c.index);
+        }
+    }
+}
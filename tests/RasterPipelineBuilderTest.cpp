@@ -280,13 +280,41 @@ DEF_TEST(RasterPipelineBuilderCopySlotsUnmasked, r) {
     SkSL::RP::Builder builder;
     builder.copy_slots_unmasked(three_slots_at(0), three_slots_at(2));
     builder.copy_slots_unmasked(five_slots_at(1),  five_slots_at(5));
+    // Read back the results so the copies aren't eliminated as dead writes.
+    builder.load_src(four_slots_at(0));
+    builder.load_dst(four_slots_at(2));
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/10,
                                                                 /*numUniformSlots=*/0,
                                                                 /*numImmutableSlots=*/0);
+    // The second copy overwrites v1..2 before they are read, but the first copy's source and
+    // destination overlap, so it is left intact.
     check(r, *program,
 R"(copy_3_slots_unmasked          v0..2 = v2..4
 copy_4_slots_unmasked          v1..4 = v5..8
 copy_slot_unmasked             v5 = v9
+load_src                       src.rgba = v0..3
+load_dst                       dst.rgba = v2..5
+)");
+}
+
+DEF_TEST(RasterPipelineBuilderForwardsCopiesAndRemovesDeadWrites, r) {
+    // Create a very simple nonsense program.
+    SkSL::RP::Builder builder;
+    builder.copy_constant(0, 1);                                      // overwritten before use
+    builder.copy_slots_unmasked(two_slots_at(0), two_slots_at(4));    // copy 4~5 into 0~1
+    builder.copy_uniform_to_slots_unmasked(two_slots_at(2), two_slots_at(0));  // copy u0~1 to 2~3
+    builder.push_slots(two_slots_at(2));                              // push from u0~1 instead
+    builder.push_slots(two_slots_at(0));                              // push from 4~5 instead
+    builder.copy_constant(6, 1);                                      // never read
+    builder.pop_src_rgba();
+    std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/10,
+                                                                /*numUniformSlots=*/2,
+                                                                /*numImmutableSlots=*/0);
+    // Once the pushes read from the original slots, none of the copies are needed.
+    check(r, *program,
+R"(copy_2_uniforms                $0..1 = u0..1
+copy_2_slots_unmasked          $2..3 = v4..5
+load_src                       src.rgba = $0..3
 )");
 }
 
@@ -301,6 +329,8 @@ DEF_TEST(RasterPipelineBuilderPushPopSlots, r) {
     builder.push_slots(three_slots_at(30));          // push from 30~32 into $2~$4
     builder.pop_slots(five_slots_at(0));             // pop from $0~$4 into 0~4 (masked)
     builder.disableExecutionMaskWrites();
+    builder.load_src(four_slots_at(2));              // read back 5 so it isn't a dead write
+    builder.load_dst(four_slots_at(20));             // read back 20~21 so they aren't dead writes
 
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/50,
                                                                 /*numUniformSlots=*/0,
@@ -313,6 +343,8 @@ copy_slot_unmasked             v4 = $0
 copy_3_slots_unmasked          $2..4 = v30..32
 copy_4_slots_masked            v0..3 = Mask($0..3)
 copy_slot_masked               v4 = Mask($4)
+load_src                       src.rgba = v2..5
+load_dst                       dst.rgba = v20..23
 )");
 }
 
@@ -447,18 +479,16 @@ DEF_TEST(RasterPipelineBuilderBranches, r) {
 #if SK_HAS_MUSTTAIL
     // We have guaranteed tail-calling, and don't need to rewind the stack.
     static constexpr char kExpectationWithKnownExecutionMask[] =
-R"(jump                           jump +9 (label 3 at #10)
+R"(jump                           jump +6 (label 3 at #7)
 label                          label 0
-copy_constant                  v0 = 0
 label                          label 0x00000001
-copy_constant                  v1 = 0
-jump                           jump -4 (label 0 at #2)
+jump                           jump -2 (label 0 at #2)
 label                          label 0x00000002
-copy_constant                  v2 = 0
-jump                           jump -7 (label 0 at #2)
+jump                           jump -4 (label 0 at #2)
 label                          label 0x00000003
-branch_if_no_active_lanes_eq   branch -4 (label 2 at #7) if no lanes of v2 == 0
-branch_if_no_active_lanes_eq   branch -10 (label 0 at #2) if no lanes of v2 == 0x00000001 (1.401298e-45)
+branch_if_no_active_lanes_eq   branch -3 (label 2 at #5) if no lanes of v2 == 0
+branch_if_no_active_lanes_eq   branch -7 (label 0 at #2) if no lanes of v2 == 0x00000001 (1.401298e-45)
+copy_2_slots_masked            v0..1 = Mask(v1..2)
 )";
     static constexpr char kExpectationWithExecutionMaskWrites[] =
 R"(jump                           jump +10 (label 3 at #11)
@@ -474,27 +504,26 @@ branch_if_any_lanes_active     branch_if_any_lanes_active -8 (label 0 at #2)
 label                          label 0x00000003
 branch_if_no_active_lanes_eq   branch -4 (label 2 at #8) if no lanes of v2 == 0
 branch_if_no_active_lanes_eq   branch -11 (label 0 at #2) if no lanes of v2 == 0x00000001 (1.401298e-45)
+copy_2_slots_masked            v0..1 = Mask(v1..2)
 )";
 #else
     // We don't have guaranteed tail-calling, so we rewind the stack immediately before any backward
     // branches.
     static constexpr char kExpectationWithKnownExecutionMask[] =
-R"(jump                           jump +11 (label 3 at #12)
+R"(jump                           jump +8 (label 3 at #9)
 label                          label 0
-copy_constant                  v0 = 0
 label                          label 0x00000001
-copy_constant                  v1 = 0
 stack_rewind
-jump                           jump -5 (label 0 at #2)
+jump                           jump -3 (label 0 at #2)
 label                          label 0x00000002
-copy_constant                  v2 = 0
 stack_rewind
-jump                           jump -9 (label 0 at #2)
+jump                           jump -6 (label 0 at #2)
 label                          label 0x00000003
 stack_rewind
-branch_if_no_active_lanes_eq   branch -6 (label 2 at #8) if no lanes of v2 == 0
+branch_if_no_active_lanes_eq   branch -5 (label 2 at #6) if no lanes of v2 == 0
 stack_rewind
-branch_if_no_active_lanes_eq   branch -14 (label 0 at #2) if no lanes of v2 == 0x00000001 (1.401298e-45)
+branch_if_no_active_lanes_eq   branch -11 (label 0 at #2) if no lanes of v2 == 0x00000001 (1.401298e-45)
+copy_2_slots_masked            v0..1 = Mask(v1..2)
 )";
     static constexpr char kExpectationWithExecutionMaskWrites[] =
 R"(jump                           jump +13 (label 3 at #14)
@@ -515,9 +544,12 @@ stack_rewind
 branch_if_no_active_lanes_eq   branch -6 (label 2 at #10) if no lanes of v2 == 0
 stack_rewind
 branch_if_no_active_lanes_eq   branch -16 (label 0 at #2) if no lanes of v2 == 0x00000001 (1.401298e-45)
+copy_2_slots_masked            v0..1 = Mask(v1..2)
 )";
 #endif
 
+    // When the execution mask is known, every path through the program loops back to label 0
+    // forever, so the slots are never read and the zeroing ops are eliminated as dead writes.
     for (bool enableExecutionMaskWrites : {false, true}) {
         // Create a very simple nonsense program.
         SkSL::RP::Builder builder;
@@ -547,6 +579,8 @@ branch_if_no_active_lanes_eq   branch -16 (label 0 at #2) if no lanes of v2 == 0
         builder.branch_if_no_active_lanes_on_stack_top_equal(0, label2);
         builder.branch_if_no_active_lanes_on_stack_top_equal(1, label1);
         builder.branch_if_no_active_lanes_on_stack_top_equal(1, label4);
+        // Read the slots back so the zeroing ops aren't eliminated as dead writes.
+        builder.copy_slots_masked(two_slots_at(0), two_slots_at(1));
 
         if (enableExecutionMaskWrites) {
             builder.disableExecutionMaskWrites();
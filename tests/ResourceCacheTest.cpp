@@ -1527,6 +1527,63 @@ static void test_partial_purge(skiatest::Reporter* reporter) {
     }
 }
 
+static void test_time_sliced_purge(skiatest::Reporter* reporter) {
+    Mock mock(1000000);
+    auto dContext = mock.dContext();
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = mock.gpu();
+
+    static constexpr int kCount = 5;
+    int startPurgedCount;
+    size_t startPurgedBytes;
+    dContext->getResourceCachePurgeStats(&startPurgedCount, &startPurgedBytes);
+
+    for (int i = 0; i < kCount; ++i) {
+        skgpu::UniqueKey key;
+        make_unique_key<0>(&key, i);
+        TestResource* r = new TestResource(gpu, /*label=*/{}, skgpu::Budgeted::kYes, 10 + i);
+        r->resourcePriv().setUniqueKey(key);
+        r->unref();
+    }
+    REPORTER_ASSERT(reporter, kCount == cache->getResourceCount());
+
+    // A deadline that has already passed still purges one resource per call, oldest first, and
+    // each call resumes where the previous one stopped.
+    auto purgeTime = skgpu::StdSteadyClock::now() + std::chrono::milliseconds(1);
+    auto deadline = skgpu::StdSteadyClock::now() - std::chrono::milliseconds(1);
+    for (int i = 1; i < kCount; ++i) {
+        bool done = cache->purgeResourcesNotUsedSince(purgeTime,
+                                                      GrPurgeResourceOptions::kAllResources,
+                                                      deadline);
+        REPORTER_ASSERT(reporter, !done);
+        REPORTER_ASSERT(reporter, kCount - i == cache->getResourceCount());
+        skgpu::UniqueKey key;
+        make_unique_key<0>(&key, i - 1);
+        REPORTER_ASSERT(reporter, !cache->hasUniqueKey(key));
+    }
+    REPORTER_ASSERT(reporter, cache->purgeResourcesNotUsedSince(
+                                      purgeTime, GrPurgeResourceOptions::kAllResources, deadline));
+    REPORTER_ASSERT(reporter, 0 == cache->getResourceCount());
+
+    int purgedCount;
+    size_t purgedBytes;
+    dContext->getResourceCachePurgeStats(&purgedCount, &purgedBytes);
+    REPORTER_ASSERT(reporter, kCount == purgedCount - startPurgedCount);
+    REPORTER_ASSERT(reporter, 10 + 11 + 12 + 13 + 14 == purgedBytes - startPurgedBytes);
+
+    // With a generous budget, the public API does all the work in one call.
+    for (int i = 0; i < kCount; ++i) {
+        TestResource* r = TestResource::CreateScratch(gpu, skgpu::Budgeted::kYes,
+                                                      TestResource::kA_SimulatedProperty);
+        r->unref();
+    }
+    // Make sure the resources are older than 'msNotUsed' below.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    REPORTER_ASSERT(reporter, dContext->performDeferredCleanup(std::chrono::milliseconds(0),
+                                                               std::chrono::seconds(10)));
+    REPORTER_ASSERT(reporter, 0 == cache->getResourceCount());
+}
+
 static void test_custom_data(skiatest::Reporter* reporter) {
     skgpu::UniqueKey key1, key2;
     make_unique_key<0>(&key1, 1);
@@ -1683,6 +1740,7 @@ DEF_GANESH_TEST(ResourceCacheMisc, reporter, /* options */, CtsEnforcement::kApi
     test_timestamp_wrap(reporter);
     test_time_purge(reporter);
     test_partial_purge(reporter);
+    test_time_sliced_purge(reporter);
     test_custom_data(reporter);
     test_abandoned(reporter);
     test_tags(reporter);
@@ -14,6 +14,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
@@ -40,6 +41,7 @@
 #include "src/base/SkStringView.h"
 #include "src/base/SkTLazy.h"
 #include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkRuntimeEffectCache.h"
 #include "src/core/SkRuntimeEffectPriv.h"
 #include "src/gpu/KeyBuilder.h"
 #include "src/gpu/SkBackingFit.h"
@@ -1262,6 +1264,47 @@ DEF_TEST(SkRuntimeEffectThreaded, r) {
     }
 }
 
+DEF_TEST(SkRuntimeEffectCache, r) {
+    static constexpr char kSource[] = "half4 main(float2 p) { return half4(p.x, p.y, 0.1, 1); }";
+    SkGraphics::PurgeRuntimeEffectCache();
+
+    // Identical source and options share an effect
+    SkRuntimeEffectCache::Stats before = SkRuntimeEffectCache::GetStats();
+    sk_sp<SkRuntimeEffect> a = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    sk_sp<SkRuntimeEffect> b = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    REPORTER_ASSERT(r, a && a == b);
+    SkRuntimeEffectCache::Stats after = SkRuntimeEffectCache::GetStats();
+    REPORTER_ASSERT(r, after.fHits >= before.fHits + 1);
+    REPORTER_ASSERT(r, SkGraphics::GetRuntimeEffectCacheUsed() > 0);
+
+    // Different options or program kinds don't
+    SkRuntimeEffect::Options unoptimized;
+    unoptimized.forceUnoptimized = true;
+    sk_sp<SkRuntimeEffect> c = SkRuntimeEffect::MakeForShader(SkString(kSource), unoptimized).effect;
+    REPORTER_ASSERT(r, c && c != a);
+    sk_sp<SkRuntimeEffect> d =
+            SkRuntimeEffect::MakeForColorFilter(SkString("half4 main(half4 c) { return c; }")).effect;
+    sk_sp<SkRuntimeEffect> e =
+            SkRuntimeEffect::MakeForBlender(SkString("half4 main(half4 c, half4 d) { return c; }"))
+                    .effect;
+    REPORTER_ASSERT(r, d && e && d != e);
+
+    // Errors are reported every time
+    static constexpr char kInvalid[] = "half4 main(float2 p) { return undefined; }";
+    for (int i = 0; i < 2; ++i) {
+        SkRuntimeEffect::Result result = SkRuntimeEffect::MakeForShader(SkString(kInvalid));
+        REPORTER_ASSERT(r, !result.effect && !result.errorText.isEmpty());
+    }
+
+    // A zero limit disables the cache; effects that were handed out stay valid
+    size_t oldLimit = SkGraphics::SetRuntimeEffectCacheLimit(0);
+    REPORTER_ASSERT(r, SkGraphics::GetRuntimeEffectCacheUsed() == 0);
+    sk_sp<SkRuntimeEffect> f = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    REPORTER_ASSERT(r, f && f != a);
+    REPORTER_ASSERT(r, a->source() == f->source());
+    SkGraphics::SetRuntimeEffectCacheLimit(oldLimit);
+}
+
 DEF_TEST(SkRuntimeEffectAllowsPrivateAccess, r) {
     SkRuntimeEffect::Options defaultOptions;
     SkRuntimeEffect::Options optionsWithAccess;
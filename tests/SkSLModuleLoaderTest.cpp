@@ -0,0 +1,181 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTypes.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLModuleLoader.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/SkSLAnalysis.h"
+#include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/analysis/SkSLProgramUsage.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+#include "src/sksl/ir/SkSLProgram.h"
+#include "src/sksl/ir/SkSLProgramElement.h"
+#include "tests/Test.h"
+
+#include <climits>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct ModuleTestCase {
+    SkSL::ProgramKind fKind;
+    // Uses built-ins from each level of the module tree for this program kind
+    const char* fSource;
+};
+
+const ModuleTestCase kModuleTestCases[] = {
+    {SkSL::ProgramKind::kFragment,
+     "void main() { sk_FragColor = saturate(half4(half(sk_FragCoord.x))); }"},
+    {SkSL::ProgramKind::kVertex,
+     "void main() { sk_Position = float4(mix(0.0, 1.0, float(sk_VertexID)), 0, 0, 1); }"},
+    {SkSL::ProgramKind::kCompute,
+     "layout(local_size_x=16) in; void main() { workgroupBarrier(); }"},
+    {SkSL::ProgramKind::kGraphiteFragment,
+     "void main() { sk_FragColor = saturate(half4(half(sk_FragCoord.x))); }"},
+    {SkSL::ProgramKind::kGraphiteVertex,
+     "void main() { sk_Position = float4(mix(0.0, 1.0, float(sk_VertexID)), 0, 0, 1); }"},
+};
+
+}  // namespace
+
+// Loading the modules up front, level by level on several threads, must leave the module loader
+// in the same state as loading them on demand: every program kind resolves to one module, which
+// later on-demand loads (and repeated parallel loads) reuse, and programs compile against it.
+DEF_TEST(SkSLModuleLoaderParallel, r) {
+    SkSL::ProgramKind kinds[std::size(kModuleTestCases)];
+    for (size_t i = 0; i < std::size(kModuleTestCases); ++i) {
+        kinds[i] = kModuleTestCases[i].fKind;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+
+    // Race two parallel loads against on-demand loads from other compilers.
+    SkTaskGroup tasks(*executor);
+    tasks.add([&] { SkSL::ModuleLoader::LoadModulesInParallel(kinds, *executor); });
+    tasks.batch(SkToInt(std::size(kModuleTestCases)), [](int i) {
+        SkSL::Compiler compiler;
+        compiler.moduleForProgramKind(kModuleTestCases[i].fKind);
+    });
+    SkSL::ModuleLoader::LoadModulesInParallel(kinds, *executor);
+    tasks.wait();
+
+    const SkSL::Module* modules[std::size(kModuleTestCases)];
+    SkSL::Compiler compiler;
+    for (size_t i = 0; i < std::size(kModuleTestCases); ++i) {
+        modules[i] = compiler.moduleForProgramKind(kinds[i]);
+        REPORTER_ASSERT(r, modules[i]);
+    }
+
+    // Loading again doesn't replace any module.
+    SkSL::ModuleLoader::LoadModulesInParallel(kinds, *executor);
+    for (size_t i = 0; i < std::size(kModuleTestCases); ++i) {
+        REPORTER_ASSERT(r, compiler.moduleForProgramKind(kinds[i]) == modules[i]);
+
+        SkSL::ProgramSettings settings;
+        std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+                kinds[i], std::string(kModuleTestCases[i].fSource), settings);
+        if (!program) {
+            ERRORF(r, "Unexpected error compiling %s\n%s",
+                   kModuleTestCases[i].fSource, compiler.errorText().c_str());
+        }
+    }
+}
+
+// Module functions cache their analysis once the module is loaded. The cached results must match
+// what analyzing the function from scratch produces, and the analysis entry points must return them.
+DEF_TEST(SkSLModuleFunctionCachedAnalysis, r) {
+    SkSL::Compiler compiler;
+    const SkSL::Module* fragmentModule =
+            compiler.moduleForProgramKind(SkSL::ProgramKind::kFragment);
+    REPORTER_ASSERT(r, fragmentModule);
+
+    // Every function of a loaded module has its analysis cached.
+    for (const SkSL::Module* m = fragmentModule; m; m = m->fParent) {
+        for (const std::unique_ptr<SkSL::ProgramElement>& element : m->fElements) {
+            if (element->is<SkSL::FunctionDefinition>()) {
+                REPORTER_ASSERT(r, element->as<SkSL::FunctionDefinition>().hasCachedAnalysis());
+            }
+        }
+    }
+
+    // A module compiled directly isn't cached yet, so it can be analyzed both ways.
+    static constexpr char kSource[] = R"(
+        struct S { half4 color; float weight; };
+        half4 single_return(half4 c) { return c.bgra; }
+        half4 early_return(half4 c, float x) {
+            if (x > 0) { return c; }
+            half4 result = c * half(x);
+            for (int i = 0; i < 4; ++i) { result[i] = saturate(result[i]); }
+            return result;
+        }
+        float scoped_returns(S s) {
+            if (s.weight > 1) { return s.weight; } else { return length(s.color); }
+        }
+        half4 calls(half4 c) { S s = S(c, 2); return early_return(c, scoped_returns(s)); }
+    )";
+    std::unique_ptr<SkSL::Module> module = compiler.compileModule(SkSL::ProgramKind::kFragment,
+                                                                  "test",
+                                                                  std::string(kSource),
+                                                                  fragmentModule,
+                                                                  /*shouldInline=*/false);
+    REPORTER_ASSERT(r, module);
+    if (!module) {
+        return;
+    }
+
+    static constexpr int kLimits[] = {0, 1, 5, INT_MAX};
+    int functionCount = 0;
+    for (const std::unique_ptr<SkSL::ProgramElement>& element : module->fElements) {
+        if (!element->is<SkSL::FunctionDefinition>()) {
+            continue;
+        }
+        SkSL::FunctionDefinition& function = element->as<SkSL::FunctionDefinition>();
+        REPORTER_ASSERT(r, !function.hasCachedAnalysis());
+        ++functionCount;
+
+        SkSL::ProgramUsage freshUsage;
+        freshUsage.add(function);
+        const SkSL::Analysis::ReturnComplexity freshComplexity =
+                SkSL::Analysis::GetReturnComplexity(function);
+        int freshNodeCounts[std::size(kLimits)];
+        for (size_t i = 0; i < std::size(kLimits); ++i) {
+            freshNodeCounts[i] = SkSL::Analysis::NodeCountUpToLimit(function, kLimits[i]);
+        }
+
+        function.cacheAnalysis();
+        REPORTER_ASSERT(r, function.hasCachedAnalysis());
+        const std::string description = function.declaration().description();
+        const char* name = description.c_str();
+
+        REPORTER_ASSERT(r, function.cachedUsage() == freshUsage, "%s", name);
+        REPORTER_ASSERT(r, function.cachedReturnComplexity() == freshComplexity, "%s", name);
+        REPORTER_ASSERT(r, function.cachedNodeCount() == freshNodeCounts[std::size(kLimits) - 1],
+                        "%s", name);
+
+        // The analysis entry points now return the cached results.
+        SkSL::ProgramUsage usage;
+        usage.add(function);
+        REPORTER_ASSERT(r, usage == freshUsage, "%s", name);
+        usage.remove(function);
+        REPORTER_ASSERT(r, usage == SkSL::ProgramUsage(), "%s", name);
+        REPORTER_ASSERT(r, SkSL::Analysis::GetReturnComplexity(function) == freshComplexity,
+                        "%s", name);
+        for (size_t i = 0; i < std::size(kLimits); ++i) {
+            REPORTER_ASSERT(r,
+                            SkSL::Analysis::NodeCountUpToLimit(function, kLimits[i]) ==
+                                    freshNodeCounts[i],
+                            "%s limit %d", name, kLimits[i]);
+        }
+    }
+    REPORTER_ASSERT(r, functionCount == 4);
+}
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
 
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkUTF.h"
 #include "tests/Test.h"
 
@@ -9,6 +10,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
 
 DEF_TEST(SkUTF_UTF16, reporter) {
     // Test non-basic-multilingual-plane unicode.
@@ -146,3 +148,67 @@ DEF_TEST(SkUTF_NextUTF8_ToUTF8, r) {
 #undef LEADING_THREE_BYTE
 #undef LEADING_FOUR_BYTE
 #undef INVALID_BYTE
+
+// The conversions skip over ASCII (and surrogate-free UTF-16) several code units at a time, so
+// check them against decoding one code point at a time, with the other code points at every
+// position of a long run.
+DEF_TEST(SkUTF_LongRuns, r) {
+    const char* kCodePoints[] = { "\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80" };
+    for (const char* codePoint : kCodePoints) {
+        for (size_t position = 0; position < 40; ++position) {
+            char utf8[64];
+            memset(utf8, 'a', sizeof(utf8));
+            const size_t codePointBytes = strlen(codePoint);
+            memcpy(utf8 + position, codePoint, codePointBytes);
+            const size_t utf8Bytes = 48;
+
+            const int count = SkUTF::CountUTF8(utf8, utf8Bytes);
+            REPORTER_ASSERT(r, count == SkToInt(utf8Bytes - codePointBytes + 1));
+
+            uint16_t utf16[64];
+            const int utf16Units = SkUTF::UTF8ToUTF16(utf16, std::size(utf16), utf8, utf8Bytes);
+            REPORTER_ASSERT(r, utf16Units == count + (codePointBytes == 4 ? 1 : 0));
+            REPORTER_ASSERT(r, SkUTF::CountUTF16(utf16, utf16Units * 2) == count);
+
+            char roundTrip[64];
+            REPORTER_ASSERT(r, SkUTF::UTF16ToUTF8(roundTrip, std::size(roundTrip),
+                                                  utf16, utf16Units) == SkToInt(utf8Bytes));
+            REPORTER_ASSERT(r, memcmp(roundTrip, utf8, utf8Bytes) == 0);
+
+            // A short destination is filled as far as it goes.
+            uint16_t shortUTF16[20];
+            REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16(shortUTF16, std::size(shortUTF16),
+                                                  utf8, utf8Bytes) == utf16Units);
+            REPORTER_ASSERT(r, memcmp(shortUTF16, utf16, sizeof(shortUTF16)) == 0);
+
+            size_t utf8IndexForUTF16Index[65];
+            size_t utf16IndexForUTF8Index[65];
+            REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16Indices(utf8, utf8Bytes,
+                                                         utf8IndexForUTF16Index,
+                                                         utf16IndexForUTF8Index) == utf16Units);
+            const char* ptr = utf8;
+            size_t utf16Index = 0;
+            while (ptr < utf8 + utf8Bytes) {
+                const size_t utf8Index = ptr - utf8;
+                SkUnichar uni = SkUTF::NextUTF8(&ptr, utf8 + utf8Bytes);
+                for (size_t i = utf8Index; i < SkToSizeT(ptr - utf8); ++i) {
+                    REPORTER_ASSERT(r, utf16IndexForUTF8Index[i] == utf16Index);
+                }
+                for (size_t i = 0; i < SkUTF::ToUTF16(uni); ++i) {
+                    REPORTER_ASSERT(r, utf8IndexForUTF16Index[utf16Index++] == utf8Index);
+                }
+            }
+            REPORTER_ASSERT(r, utf8IndexForUTF16Index[utf16Units] == utf8Bytes);
+            REPORTER_ASSERT(r, utf16IndexForUTF8Index[utf8Bytes] == SkToSizeT(utf16Units));
+
+            // Cutting the code point short makes the whole run invalid.
+            if (position + 1 < utf8Bytes) {
+                REPORTER_ASSERT(r, SkUTF::CountUTF8(utf8, position + 1) == -1);
+                REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16(nullptr, 0, utf8, position + 1) == -1);
+                REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16Indices(utf8, position + 1,
+                                                             utf8IndexForUTF16Index,
+                                                             utf16IndexForUTF8Index) == -1);
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#if defined(SK_GRAPHITE)
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRRect.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GlobalCache.h"
+#include "src/gpu/graphite/PipelineUsageLog.h"
+#include "src/gpu/graphite/PublicPrecompile.h"
+
+using namespace skgpu::graphite;
+
+DEF_TEST(PipelineUsageLogSerializationTest, reporter) {
+    PipelineUsageLog::Entry entries[2];
+    entries[0].fRenderStepName = SkString("AnalyticRRectRenderStep");
+    entries[0].fPaintKey.push_back(3);
+    entries[0].fPaintKey.push_back(7);
+    entries[0].fColorType = kRGBA_8888_SkColorType;
+    entries[0].fDepthStencilFlags = DepthStencilFlags::kDepth;
+    entries[0].fRequiresMSAA = false;
+    entries[1].fRenderStepName = SkString("TessellateStrokesRenderStep");
+    entries[1].fColorType = kBGRA_8888_SkColorType;
+    entries[1].fDepthStencilFlags = DepthStencilFlags::kDepthStencil;
+    entries[1].fRequiresMSAA = true;
+    entries[1].fProtected = true;
+
+    sk_sp<SkData> data = PipelineUsageLog::Serialize(entries);
+    REPORTER_ASSERT(reporter, data && data->size() > 0);
+
+    int count = 0;
+    bool valid = PipelineUsageLog::Deserialize(data.get(), [&](const PipelineUsageLog::Entry& e) {
+        REPORTER_ASSERT(reporter, count < 2);
+        REPORTER_ASSERT(reporter, e == entries[count]);
+        REPORTER_ASSERT(reporter, e.hash() == entries[count].hash());
+        ++count;
+    });
+    REPORTER_ASSERT(reporter, valid);
+    REPORTER_ASSERT(reporter, count == 2);
+
+    // Truncated data must be rejected
+    sk_sp<SkData> truncated = SkData::MakeSubset(data.get(), 0, data->size() - 1);
+    REPORTER_ASSERT(reporter, !PipelineUsageLog::Deserialize(truncated.get(),
+                                                             [](const PipelineUsageLog::Entry&) {}));
+
+    // As must garbage
+    static const uint8_t kGarbage[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    sk_sp<SkData> garbage = SkData::MakeWithoutCopy(kGarbage, sizeof(kGarbage));
+    REPORTER_ASSERT(reporter, !PipelineUsageLog::Deserialize(garbage.get(),
+                                                             [](const PipelineUsageLog::Entry&) {}));
+}
+
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(PipelineUsageLogReplayTest, reporter, context,
+                                         CtsEnforcement::kNever) {
+    GlobalCache* globalCache = context->priv().globalCache();
+    globalCache->resetGraphicsPipelines();
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    StartPipelineUsageRecording(context);
+    {
+        SkImageInfo ii = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+        sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+        SkCanvas* canvas = surface->getCanvas();
+
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        canvas->drawRect(SkRect::MakeWH(8, 8), paint);
+        paint.setAntiAlias(true);
+        canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeWH(12, 12), 3, 3), paint);
+
+        std::unique_ptr<Recording> recording = recorder->snap();
+        context->insertRecording({ recording.get() });
+    }
+    sk_sp<SkData> usageLog = FinishPipelineUsageRecording(context);
+
+    int numRecorded = 0;
+    REPORTER_ASSERT(reporter, PipelineUsageLog::Deserialize(
+            usageLog.get(), [&](const PipelineUsageLog::Entry&) { ++numRecorded; }));
+    REPORTER_ASSERT(reporter, numRecorded > 0);
+    REPORTER_ASSERT(reporter, numRecorded <= globalCache->numGraphicsPipelines());
+
+    // Replaying the log into an empty cache should recreate every recorded pipeline
+    globalCache->resetGraphicsPipelines();
+    std::unique_ptr<Recorder> precompileRecorder = context->makeRecorder();
+    int numReplayed = PrecompileFromUsageLog(precompileRecorder.get(), usageLog.get());
+    REPORTER_ASSERT(reporter, numReplayed == numRecorded,
+                    "recorded: %d replayed: %d", numRecorded, numReplayed);
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() == numReplayed);
+
+    // Nothing is recorded once recording has finished
+    REPORTER_ASSERT(reporter, globalCache->pipelineUsageLog()->count() == 0);
+    REPORTER_ASSERT(reporter, !globalCache->pipelineUsageLog()->isRecording());
+}
+
+#endif // SK_GRAPHITE
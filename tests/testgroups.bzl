@@ -125,6 +125,7 @@ CORE_TESTS = [
     "SkPathRangeIterTest.cpp",
     "SkSLErrorTest.cpp",
     "SkSLMemoryLayoutTest.cpp",
+    "SkSLModuleLoaderTest.cpp",
     "SkSLTypeTest.cpp",
     "SkSharedMutexTest.cpp",
     "SkSpanTest.cpp",
@@ -12,6 +12,7 @@
 #include "include/core/SkSurface.h"
 #include "include/private/base/SkTPin.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
 #include "modules/skresources/include/SkResources.h"
 #include "src/base/SkTime.h"
 #include "src/utils/SkOSPath.h"
@@ -41,6 +42,7 @@ static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(loop, l, false, "loop mode for profiling");
 static DEFINE_int(set_dst_width, 0, "set destination width (height will be computed)");
 static DEFINE_bool2(gpu, g, false, "use GPU for rendering");
+static DEFINE_int(threads, 0, "CPU rendering threads (0 -> cores count)");
 
 static void produce_frame(SkSurface* surf, skottie::Animation* anim, double frame) {
     anim->seekFrame(frame);
@@ -89,11 +91,32 @@ int main(int argc, char** argv) {
     sk_sp<SkFontMgr> fontMgr = SkFontMgr_New_Custom_Empty();
 #endif
 
-    auto animation = skottie::Animation::Builder()
-        .setResourceProvider(skresources::FileResourceProvider::Make(assetPath))
-        .setTextShapingFactory(SkShapers::BestAvailable())
-        .setFontManager(fontMgr)
-        .makeFromFile(FLAGS_input[0]);
+    auto json = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!json) {
+        SkDebugf("failed to read %s\n", FLAGS_input[0]);
+        return -1;
+    }
+
+    // Images are shared (and only decoded once) by all rendering threads.
+    auto builder = skottie::Animation::Builder();
+    builder.setResourceProvider(skresources::CachingResourceProvider::Make(
+                    skresources::FileResourceProvider::Make(
+                            assetPath, skresources::ImageDecodeStrategy::kPreDecode)))
+           .setTextShapingFactory(SkShapers::BestAvailable())
+           .setFontManager(fontMgr);
+
+    // On the CPU, frames are rendered concurrently.
+    std::unique_ptr<skottie_utils::ParallelFrameRenderer> renderer;
+    sk_sp<skottie::Animation> animation;
+    if (FLAGS_gpu) {
+        animation = builder.make(static_cast<const char*>(json->data()), json->size());
+    } else {
+        renderer = skottie_utils::ParallelFrameRenderer::Make(
+                builder, static_cast<const char*>(json->data()), json->size(), FLAGS_threads);
+        if (renderer) {
+            animation = renderer->animation();
+        }
+    }
     if (!animation) {
         SkDebugf("failed to load %s\n", FLAGS_input[0]);
         return -1;
@@ -133,8 +156,22 @@ int main(int argc, char** argv) {
             return -1;
         }
 
+        if (renderer) {
+            std::vector<double> frame_times(frames + 1);
+            for (int i = 0; i <= frames; ++i) {
+                frame_times[i] = i * fps_scale;
+            }
+            renderer->render(info, frame_times, [&](size_t i, const SkPixmap& pm) {
+                if (FLAGS_verbose) {
+                    SkDebugf("rendered frame %g\n", frame_times[i]);
+                }
+                encoder.addFrame(pm);
+                return true;
+            }, SK_ColorWHITE);
+        }
+
         // lazily allocate the surfaces
-        if (!surf) {
+        if (!renderer && !surf) {
             if (FLAGS_gpu) {
                 grctx = factory.getContextInfo(contextType).directContext();
                 surf = SkSurfaces::RenderTarget(grctx,
@@ -153,7 +190,7 @@ int main(int argc, char** argv) {
             surf->getCanvas()->scale(scale, scale);
         }
 
-        for (int i = 0; i <= frames; ++i) {
+        for (int i = 0; !renderer && i <= frames; ++i) {
             const double frame = i * fps_scale;
             if (FLAGS_verbose) {
                 SkDebugf("rendering frame %g\n", frame);